@@ -0,0 +1,96 @@
+#include "lz4.h"
+#include <string.h>
+
+bool LZ4DecompressBlock(const uint8_t * src, uint64_t srcSize, uint8_t * dst, uint64_t dstSize)
+{
+    enum
+    {
+        minMatch = 4,
+        runMask = 0xF,
+    };
+
+    const uint8_t * ip = src;
+    const uint8_t * const ipEnd = src + srcSize;
+    uint8_t * op = dst;
+    uint8_t * const opEnd = dst + dstSize;
+
+    while (ip < ipEnd)
+    {
+        const uint8_t token = *ip++;
+
+        uint64_t literalLength = token >> 4;
+        if (literalLength == runMask)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return false;
+                }
+                extra = *ip++;
+                literalLength += extra;
+            } while (extra == 0xFF);
+        }
+        if (literalLength > (uint64_t)(ipEnd - ip) || literalLength > (uint64_t)(opEnd - op))
+        {
+            return false;
+        }
+        memcpy(op, ip, (size_t)literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // The last sequence is literals only
+        if (ip == ipEnd)
+        {
+            break;
+        }
+
+        if (ipEnd - ip < 2)
+        {
+            return false;
+        }
+        const uint64_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint64_t)(op - dst))
+        {
+            return false;
+        }
+
+        uint64_t matchLength = token & runMask;
+        if (matchLength == runMask)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return false;
+                }
+                extra = *ip++;
+                matchLength += extra;
+            } while (extra == 0xFF);
+        }
+        matchLength += minMatch;
+        if (matchLength > (uint64_t)(opEnd - op))
+        {
+            return false;
+        }
+
+        const uint8_t * match = op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(op, match, (size_t)matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            // Overlapping copy, repeats the last offset bytes
+            for (uint64_t i = 0; i < matchLength; i++)
+            {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op == opEnd;
+}
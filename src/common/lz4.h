@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+// Decodes a raw lz4 block (no frame header), true only when exactly dstSize bytes are produced
+bool LZ4DecompressBlock(const uint8_t * src, uint64_t srcSize, uint8_t * dst, uint64_t dstSize);
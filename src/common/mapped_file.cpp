@@ -0,0 +1,101 @@
+#include "mapped_file.h"
+#include <Windows.h>
+#include <string.h>
+
+MappedFile::MappedFile() :
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr),
+    m_data(nullptr),
+    m_size(0)
+{
+}
+
+MappedFile::MappedFile(const char * fileName) :
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr),
+    m_data(nullptr),
+    m_size(0)
+{
+    Open(fileName);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const char * fileName)
+{
+    Close();
+
+    if (fileName == nullptr || strlen(fileName) == 0)
+    {
+        return false;
+    }
+
+    HANDLE file = ::CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_mapping = mapping;
+
+    m_data = (const uint8_t *)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+    m_size = (uint64_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        ::UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mapping != nullptr)
+    {
+        ::CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        ::CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+const uint8_t * MappedFile::Data() const
+{
+    return m_data;
+}
+
+uint64_t MappedFile::Size() const
+{
+    return m_size;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_data != nullptr;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+
+// Read only view of a whole file, pages are brought in by the os on first access
+class MappedFile
+{
+public:
+    MappedFile();
+    MappedFile(const char * fileName);
+    ~MappedFile();
+
+    bool Open(const char * fileName);
+    void Close();
+
+    const uint8_t * Data() const;
+    uint64_t Size() const;
+    bool IsOpen() const;
+
+private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    void * m_file;
+    void * m_mapping;
+    const uint8_t * m_data;
+    uint64_t m_size;
+};
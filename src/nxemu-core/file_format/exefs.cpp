@@ -0,0 +1,197 @@
+#include "exefs.h"
+#include "npdm.h"
+#include "nso.h"
+#include <algorithm>
+#include <atomic>
+#include <common/path.h>
+#include <string.h>
+#include <thread>
+
+namespace
+{
+// Load order matters, the process entry point is the start of the first module
+const char * ModuleNames[] = {
+    "rtld",
+    "main",
+    "subsdk0",
+    "subsdk1",
+    "subsdk2",
+    "subsdk3",
+    "subsdk4",
+    "subsdk5",
+    "subsdk6",
+    "subsdk7",
+    "subsdk8",
+    "subsdk9",
+    "sdk",
+};
+} // namespace
+
+bool ExeFS::IsExeFS(const char * path)
+{
+    Path npdmPath;
+    return NpdmPath(path, npdmPath);
+}
+
+ExeFS::ExeFS(const char * path) :
+    m_codeSize(0),
+    m_valid(false)
+{
+    Path npdmPath;
+    if (!NpdmPath(path, npdmPath))
+    {
+        return;
+    }
+
+    m_npdm = std::make_unique<Npdm>(npdmPath);
+    if (!m_npdm->Valid())
+    {
+        return;
+    }
+
+    bool hasMain = false;
+    for (const char * name : ModuleNames)
+    {
+        Path modulePath(npdmPath);
+        modulePath.SetNameExtension(name);
+        if (!modulePath.FileExists())
+        {
+            continue;
+        }
+        if (!Nso::IsNsoFile(modulePath))
+        {
+            return;
+        }
+        m_modules.push_back(std::make_unique<Nso>(modulePath));
+        hasMain = hasMain || strcmp(name, "main") == 0;
+    }
+    if (!hasMain || !LoadModules())
+    {
+        return;
+    }
+
+    uint64_t offset = 0;
+    for (const std::unique_ptr<Nso> & module : m_modules)
+    {
+        m_moduleOffsets.push_back(offset);
+        offset += module->CodeSize();
+    }
+    m_codeSize = offset;
+    m_valid = true;
+}
+
+ExeFS::~ExeFS()
+{
+}
+
+bool ExeFS::LoadModules()
+{
+    typedef struct
+    {
+        Nso * module;
+        uint32_t segment;
+        uint32_t fileSize;
+    } SegmentTask;
+
+    // Every segment of every module is an independent task, decompressed and then hashed while
+    // it is still in cache. Largest first so a big .text does not end up running on its own.
+    std::vector<SegmentTask> tasks;
+    for (const std::unique_ptr<Nso> & module : m_modules)
+    {
+        for (uint32_t i = 0; i < Nso::SegmentCount; i++)
+        {
+            tasks.push_back({module.get(), i, module->SegmentFileSize(i)});
+        }
+    }
+    std::stable_sort(tasks.begin(), tasks.end(), [](const SegmentTask & a, const SegmentTask & b)
+    {
+        return a.fileSize > b.fileSize;
+    });
+
+    std::atomic<size_t> nextTask(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&]()
+    {
+        for (size_t i = nextTask++; i < tasks.size() && !failed; i = nextTask++)
+        {
+            const SegmentTask & task = tasks[i];
+            if (!task.module->LoadSegment(task.segment) || !task.module->VerifySegment(task.segment))
+            {
+                failed = true;
+            }
+        }
+    };
+
+    size_t threadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), tasks.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+    if (failed)
+    {
+        return false;
+    }
+
+    for (const std::unique_ptr<Nso> & module : m_modules)
+    {
+        if (!module->Finish())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t ExeFS::ModuleCount() const
+{
+    return (uint32_t)m_modules.size();
+}
+
+const IModuleInfo & ExeFS::Module(uint32_t index) const
+{
+    return *m_modules[index];
+}
+
+uint64_t ExeFS::ModuleOffset(uint32_t index) const
+{
+    return m_moduleOffsets[index];
+}
+
+uint64_t ExeFS::CodeSize() const
+{
+    return m_codeSize;
+}
+
+const IProgramMetadata & ExeFS::MetaData() const
+{
+    return *m_npdm;
+}
+
+bool ExeFS::Valid() const
+{
+    return m_valid;
+}
+
+bool ExeFS::NpdmPath(const char * path, Path & npdmPath)
+{
+    // Accept either the ExeFS directory or the main.npdm inside it
+    Path filePath(path);
+    if (filePath.FileExists() && _stricmp(filePath.GetNameExtension().c_str(), "main.npdm") == 0)
+    {
+        npdmPath = filePath;
+        return true;
+    }
+    Path directoryPath(path, "main.npdm");
+    if (directoryPath.FileExists())
+    {
+        npdmPath = directoryPath;
+        return true;
+    }
+    return false;
+}
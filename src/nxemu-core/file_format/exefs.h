@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+__interface IModuleInfo;
+__interface IProgramMetadata;
+class Npdm;
+class Nso;
+class Path;
+
+// An extracted ExeFS directory, main.npdm and the nso modules that sit next to it
+class ExeFS
+{
+public:
+    ExeFS(const char * path);
+    ~ExeFS();
+
+    uint32_t ModuleCount() const;
+    const IModuleInfo & Module(uint32_t index) const;
+    uint64_t ModuleOffset(uint32_t index) const;
+    uint64_t CodeSize() const;
+    const IProgramMetadata & MetaData() const;
+    bool Valid() const;
+
+    static bool IsExeFS(const char * path);
+
+private:
+    ExeFS(void) = delete;
+    ExeFS(const ExeFS &) = delete;
+    ExeFS & operator=(const ExeFS &) = delete;
+
+    bool LoadModules();
+
+    static bool NpdmPath(const char * path, Path & npdmPath);
+
+    std::unique_ptr<Npdm> m_npdm;
+    std::vector<std::unique_ptr<Nso>> m_modules;
+    std::vector<uint64_t> m_moduleOffsets;
+    uint64_t m_codeSize;
+    bool m_valid;
+};
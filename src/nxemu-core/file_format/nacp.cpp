@@ -1,5 +1,6 @@
 #include "nacp.h"
 #include <common/file.h>
+#include <string.h>
 
 NACP::NACP(void) :
     m_info({0})
@@ -23,6 +24,16 @@ bool NACP::Load(File & file, uint64_t offset, uint64_t fileOffset, uint64_t file
     return true;
 }
 
+bool NACP::Load(const uint8_t * data, uint64_t size)
+{
+    if (data == nullptr || size < sizeof(m_info))
+    {
+        return false;
+    }
+    memcpy(&m_info, data, sizeof(m_info));
+    return true;
+}
+
 std::string NACP::GetApplicationName(Language language) const
 {
     const LanguageEntry & entry = GetLanguageEntry(language);
@@ -109,6 +109,7 @@ public:
     ~NACP() = default;
 
     bool Load(File & file, uint64_t offset, uint64_t fileOffset, uint64_t fileSize);
+    bool Load(const uint8_t * data, uint64_t size);
     std::string GetApplicationName(Language language = Language::Default) const;
     uint64_t GetTitleId(void) const;
 
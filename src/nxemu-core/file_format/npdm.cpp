@@ -0,0 +1,129 @@
+#include "npdm.h"
+#include <common/mapped_file.h>
+#include <string.h>
+
+Npdm::Npdm(const char * filePath) :
+    m_header({0}),
+    m_acidHeader({0}),
+    m_aciHeader({0}),
+    m_filesystemPermissions(0),
+    m_name{0},
+    m_valid(false)
+{
+    MappedFile file(filePath);
+    if (!file.IsOpen())
+    {
+        return;
+    }
+    const uint8_t * data = file.Data();
+    uint64_t fileSize = file.Size();
+
+    if (fileSize < sizeof(m_header))
+    {
+        return;
+    }
+    memcpy(&m_header, data, sizeof(m_header));
+    if (*((uint32_t *)(&m_header.Magic[0])) != *((uint32_t *)(&"META")))
+    {
+        return;
+    }
+
+    if (m_header.AcidOffset > fileSize || sizeof(m_acidHeader) > fileSize - m_header.AcidOffset ||
+        m_header.AciOffset > fileSize || sizeof(m_aciHeader) > fileSize - m_header.AciOffset)
+    {
+        return;
+    }
+    memcpy(&m_acidHeader, data + m_header.AcidOffset, sizeof(m_acidHeader));
+    memcpy(&m_aciHeader, data + m_header.AciOffset, sizeof(m_aciHeader));
+    if (*((uint32_t *)(&m_acidHeader.Magic[0])) != *((uint32_t *)(&"ACID")) || *((uint32_t *)(&m_aciHeader.Magic[0])) != *((uint32_t *)(&"ACI0")))
+    {
+        return;
+    }
+
+    // File access header is a version byte, 3 bytes of padding and then the permission mask
+    uint64_t fahOffset = (uint64_t)m_header.AciOffset + m_aciHeader.FahOffset;
+    if (fahOffset > fileSize || 4 + sizeof(m_filesystemPermissions) > fileSize - fahOffset)
+    {
+        return;
+    }
+    memcpy(&m_filesystemPermissions, data + fahOffset + 4, sizeof(m_filesystemPermissions));
+
+    uint64_t kacOffset = (uint64_t)m_header.AciOffset + m_aciHeader.KacOffset;
+    if (kacOffset > fileSize || m_aciHeader.KacSize > fileSize - kacOffset)
+    {
+        return;
+    }
+    m_kernelCapabilities.resize(m_aciHeader.KacSize / sizeof(uint32_t));
+    if (!m_kernelCapabilities.empty())
+    {
+        memcpy(m_kernelCapabilities.data(), data + kacOffset, m_kernelCapabilities.size() * sizeof(uint32_t));
+    }
+
+    memcpy(m_name, m_header.ApplicationName, sizeof(m_header.ApplicationName));
+    m_valid = true;
+}
+
+bool Npdm::Is64BitProgram() const
+{
+    return (m_header.Flags & 1) != 0;
+}
+
+ProgramAddressSpaceType Npdm::GetAddressSpaceType() const
+{
+    return (ProgramAddressSpaceType)((m_header.Flags >> 1) & 7);
+}
+
+uint8_t Npdm::GetMainThreadPriority() const
+{
+    return m_header.MainThreadPriority;
+}
+
+uint8_t Npdm::GetMainThreadCore() const
+{
+    return m_header.MainThreadCpu;
+}
+
+uint32_t Npdm::GetMainThreadStackSize() const
+{
+    return m_header.MainStackSize;
+}
+
+uint64_t Npdm::GetTitleID() const
+{
+    return m_aciHeader.TitleId;
+}
+
+uint64_t Npdm::GetFilesystemPermissions() const
+{
+    return m_filesystemPermissions;
+}
+
+uint32_t Npdm::GetSystemResourceSize() const
+{
+    return m_header.SystemResourceSize;
+}
+
+PoolPartition Npdm::GetPoolPartition() const
+{
+    return (PoolPartition)((m_acidHeader.Flags >> 2) & 0xF);
+}
+
+const uint32_t * Npdm::GetKernelCapabilities() const
+{
+    return m_kernelCapabilities.data();
+}
+
+uint32_t Npdm::GetKernelCapabilitiesSize() const
+{
+    return (uint32_t)m_kernelCapabilities.size();
+}
+
+const char * Npdm::GetName() const
+{
+    return m_name;
+}
+
+bool Npdm::Valid() const
+{
+    return m_valid;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <common/padding.h>
+#include <nxemu-module-spec/operating_system.h>
+#include <stdint.h>
+#include <vector>
+
+class Npdm :
+    public IProgramMetadata
+{
+    typedef struct
+    {
+        uint8_t Magic[4];
+        PADDING_BYTES(0x8);
+        uint8_t Flags;
+        PADDING_BYTES(0x1);
+        uint8_t MainThreadPriority;
+        uint8_t MainThreadCpu;
+        PADDING_BYTES(0x4);
+        uint32_t SystemResourceSize;
+        uint32_t ProcessCategory;
+        uint32_t MainStackSize;
+        char ApplicationName[0x10];
+        PADDING_BYTES(0x40);
+        uint32_t AciOffset;
+        uint32_t AciSize;
+        uint32_t AcidOffset;
+        uint32_t AcidSize;
+    } NPDM_HEADER;
+    static_assert(sizeof(NPDM_HEADER) == 0x80, "NPDM_HEADER has incorrect size.");
+
+    typedef struct
+    {
+        uint8_t Signature[0x100];
+        uint8_t NcaModulus[0x100];
+        uint8_t Magic[4];
+        uint32_t NcaSize;
+        PADDING_BYTES(0x4);
+        uint32_t Flags;
+        uint64_t TitleIdMin;
+        uint64_t TitleIdMax;
+        uint32_t FacOffset;
+        uint32_t FacSize;
+        uint32_t SacOffset;
+        uint32_t SacSize;
+        uint32_t KacOffset;
+        uint32_t KacSize;
+        PADDING_BYTES(0x8);
+    } ACID_HEADER;
+    static_assert(sizeof(ACID_HEADER) == 0x240, "ACID_HEADER has incorrect size.");
+
+    typedef struct
+    {
+        uint8_t Magic[4];
+        PADDING_BYTES(0xC);
+        uint64_t TitleId;
+        PADDING_BYTES(0x8);
+        uint32_t FahOffset;
+        uint32_t FahSize;
+        uint32_t SacOffset;
+        uint32_t SacSize;
+        uint32_t KacOffset;
+        uint32_t KacSize;
+        PADDING_BYTES(0x8);
+    } ACI_HEADER;
+    static_assert(sizeof(ACI_HEADER) == 0x40, "ACI_HEADER has incorrect size.");
+
+public:
+    Npdm(const char * filePath);
+    ~Npdm() = default;
+
+    //IProgramMetadata
+    bool Is64BitProgram() const;
+    ProgramAddressSpaceType GetAddressSpaceType() const;
+    uint8_t GetMainThreadPriority() const;
+    uint8_t GetMainThreadCore() const;
+    uint32_t GetMainThreadStackSize() const;
+    uint64_t GetTitleID() const;
+    uint64_t GetFilesystemPermissions() const;
+    uint32_t GetSystemResourceSize() const;
+    PoolPartition GetPoolPartition() const;
+    const uint32_t * GetKernelCapabilities() const;
+    uint32_t GetKernelCapabilitiesSize() const;
+    const char * GetName() const;
+
+    bool Valid() const;
+
+private:
+    Npdm(void) = delete;
+    Npdm(const Npdm &) = delete;
+    Npdm & operator=(const Npdm &) = delete;
+
+    NPDM_HEADER m_header;
+    ACID_HEADER m_acidHeader;
+    ACI_HEADER m_aciHeader;
+    uint64_t m_filesystemPermissions;
+    std::vector<uint32_t> m_kernelCapabilities;
+    char m_name[sizeof(NPDM_HEADER::ApplicationName) + 1];
+    bool m_valid;
+};
@@ -3,6 +3,7 @@
 #include <array>
 #include <common/file.h>
 #include <common/path.h>
+#include <string.h>
 
 typedef struct
 {
@@ -45,9 +46,12 @@ bool Nro::IsNroFile(const char * file)
 }
 
 Nro::Nro(const char * file) :
+    m_imageSize(0),
     m_header({0}),
     m_moduleHeader({0}),
     m_nacp(nullptr),
+    m_romfsOffset(0),
+    m_romfsSize(0),
     m_bssSize(0),
     m_valid(false)
 {
@@ -57,30 +61,28 @@ Nro::Nro(const char * file) :
         return;
     }
 
-    File readFile(filePath, IFile::modeRead);
-    if (!readFile.IsOpen())
+    // The image is used in place from the mapping, LoadModule copies it straight into guest memory
+    if (!m_file.Open(filePath))
     {
         return;
     }
+    const uint8_t * data = m_file.Data();
+    uint64_t fileSize = m_file.Size();
 
-    readFile.SeekToBegin();
-    if (!readFile.Read(&m_header, sizeof(m_header)))
+    if (fileSize < sizeof(m_header))
     {
         return;
     }
-    if (*((uint32_t *)(&m_header.Signature[0])) != *((uint32_t *)(&"NRO0")))
+    memcpy(&m_header, data, sizeof(m_header));
+    if (*((uint32_t *)(&m_header.Signature[0])) != *((uint32_t *)(&"NRO0")) || m_header.Size > fileSize)
     {
         return;
     }
 
-    if (readFile.GetLength() >= m_header.Size + sizeof(NRO_ASSET_HEADER))
+    if (fileSize >= m_header.Size + sizeof(NRO_ASSET_HEADER))
     {
         NRO_ASSET_HEADER assetHeader;
-        readFile.Seek(m_header.Size, IFile::SeekPosition::begin);
-        if (readFile.Read(&assetHeader, sizeof(NRO_ASSET_HEADER)) != sizeof(NRO_ASSET_HEADER))
-        {
-            return;
-        }
+        memcpy(&assetHeader, data + m_header.Size, sizeof(assetHeader));
 
         if (assetHeader.FormatVersion != 0)
         {
@@ -94,28 +96,39 @@ Nro::Nro(const char * file) :
 
         if (assetHeader.NacpSize > 0)
         {
+            uint64_t nacpOffset = m_header.Size + assetHeader.NacpOffset;
+            if (nacpOffset > fileSize || assetHeader.NacpSize > fileSize - nacpOffset)
+            {
+                return;
+            }
             m_nacp = std::make_unique<NACP>();
-            if (!m_nacp->Load(readFile, assetHeader.NacpOffset + m_header.Size, 0, assetHeader.NacpSize))
+            if (!m_nacp->Load(data + nacpOffset, assetHeader.NacpSize))
             {
                 return;
             }
         }
+
+        if (assetHeader.RomFSSize > 0)
+        {
+            uint64_t romfsOffset = m_header.Size + assetHeader.RomFSOffset;
+            if (romfsOffset > fileSize || assetHeader.RomFSSize > fileSize - romfsOffset)
+            {
+                return;
+            }
+            m_romfsOffset = romfsOffset;
+            m_romfsSize = assetHeader.RomFSSize;
+        }
     }
 
-    if (m_header.ModuleOffset + sizeof(NRO_MODULE_HEADER) > readFile.GetLength())
+    if (m_header.ModuleOffset + sizeof(NRO_MODULE_HEADER) > fileSize)
     {
         return;
     }
-    readFile.Seek(m_header.ModuleOffset, IFile::SeekPosition::begin);
-    readFile.Read(&m_moduleHeader, sizeof(m_moduleHeader));
+    memcpy(&m_moduleHeader, data + m_header.ModuleOffset, sizeof(m_moduleHeader));
     m_bssSize = HasModHeader() ? PageAlignSize(m_moduleHeader.BssEndOffset - m_moduleHeader.BssStartOffset) : PageAlignSize(m_header.BssSize);
 
-    m_programImage.resize(PageAlignSize(m_header.Size) + m_bssSize);
-    readFile.SeekToBegin();
-    if (!readFile.Read(m_programImage.data(), (uint32_t)m_programImage.size()))
-    {
-        return;
-    }
+    // Only the file backed part of the image is handed out, the bss is left to the zeroed code pages
+    m_imageSize = m_header.Size;
     m_valid = true;
 }
 
@@ -124,14 +137,24 @@ NACP * Nro::Nacp() const
     return m_nacp.get();
 }
 
+uint64_t Nro::RomFSOffset() const
+{
+    return m_romfsOffset;
+}
+
+uint64_t Nro::RomFSSize() const
+{
+    return m_romfsSize;
+}
+
 const uint8_t * Nro::Data(void) const
 {
-    return m_programImage.data();
+    return m_file.Data();
 }
 
 uint32_t Nro::DataSize(void) const
 {
-    return (uint32_t)m_programImage.size();
+    return m_imageSize;
 }
 
 uint64_t Nro::CodeSegmentAddr(void) const
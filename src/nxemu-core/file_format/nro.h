@@ -1,9 +1,9 @@
 #pragma once
+#include <common/mapped_file.h>
 #include <common/padding.h>
 #include <memory>
 #include <nxemu-module-spec/operating_system.h>
 #include <stdint.h>
-#include <vector>
 
 class NACP;
 
@@ -71,6 +71,8 @@ public:
     uint64_t DataSegmentSize(void) const;
 
     NACP * Nacp() const;
+    uint64_t RomFSOffset() const;
+    uint64_t RomFSSize() const;
     uint32_t CodeSize();
     const IProgramMetadata & MetaData() const;
     bool Valid() const;
@@ -86,10 +88,13 @@ private:
 
     static constexpr uint32_t PageAlignSize(uint32_t size);
 
-    std::vector<uint8_t> m_programImage;
+    MappedFile m_file;
+    uint32_t m_imageSize;
     NRO_HEADER m_header;
     NRO_MODULE_HEADER m_moduleHeader;
     std::unique_ptr<NACP> m_nacp;
+    uint64_t m_romfsOffset;
+    uint64_t m_romfsSize;
     uint32_t m_bssSize;
     bool m_valid;
 };
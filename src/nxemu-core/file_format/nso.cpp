@@ -0,0 +1,239 @@
+#include "nso.h"
+#include <common/file.h>
+#include <common/lz4.h>
+#include <common/sha256.h>
+#include <string.h>
+
+bool Nso::IsNsoFile(const char * filePath)
+{
+    File readFile(filePath, IFile::modeRead);
+    if (!readFile.IsOpen())
+    {
+        return false;
+    }
+
+    uint8_t signature[4];
+    readFile.SeekToBegin();
+    if (readFile.Read(signature, sizeof(signature)) != sizeof(signature))
+    {
+        return false;
+    }
+    return *((uint32_t *)(&signature[0])) == *((uint32_t *)(&"NSO0"));
+}
+
+Nso::Nso(const char * filePath) :
+    m_header({0}),
+    m_imageSize(0),
+    m_bssSize(0),
+    m_headerValid(false),
+    m_valid(false)
+{
+    if (!m_file.Open(filePath))
+    {
+        return;
+    }
+    uint64_t fileSize = m_file.Size();
+    if (fileSize < sizeof(m_header))
+    {
+        return;
+    }
+    memcpy(&m_header, m_file.Data(), sizeof(m_header));
+    if (*((uint32_t *)(&m_header.Signature[0])) != *((uint32_t *)(&"NSO0")))
+    {
+        return;
+    }
+
+    // Segments have to be page aligned and in order, which lets each one be written to the image
+    // and have its permissions applied without touching its neighbours
+    uint64_t segmentEnd = 0;
+    for (uint32_t i = 0; i < SegmentCount; i++)
+    {
+        const NSO_SEGMENT_HEADER & segment = m_header.Segments[i];
+        if ((segment.MemoryOffset & 0xFFF) != 0 || segment.MemoryOffset < segmentEnd)
+        {
+            return;
+        }
+        uint64_t memoryEnd = (uint64_t)segment.MemoryOffset + segment.Size;
+        if (memoryEnd > 0xFFFFF000)
+        {
+            return;
+        }
+        segmentEnd = PageAlignSize((uint32_t)memoryEnd);
+
+        uint32_t segmentFileSize = SegmentFileSize(i);
+        if (segment.FileOffset > fileSize || segmentFileSize > fileSize - segment.FileOffset)
+        {
+            return;
+        }
+    }
+
+    m_imageSize = (uint32_t)segmentEnd;
+    m_image.reset(new uint8_t[m_imageSize]);
+    m_headerValid = true;
+}
+
+uint32_t Nso::SegmentFileSize(uint32_t segment) const
+{
+    return (m_header.Flags & (1 << segment)) != 0 ? m_header.SegmentsFileSize[segment] : m_header.Segments[segment].Size;
+}
+
+bool Nso::LoadSegment(uint32_t segment)
+{
+    if (!m_headerValid || segment >= SegmentCount)
+    {
+        return false;
+    }
+
+    const NSO_SEGMENT_HEADER & header = m_header.Segments[segment];
+    const uint8_t * src = m_file.Data() + header.FileOffset;
+    uint8_t * dst = m_image.get() + header.MemoryOffset;
+    if ((m_header.Flags & (1 << segment)) != 0)
+    {
+        if (!LZ4DecompressBlock(src, m_header.SegmentsFileSize[segment], dst, header.Size))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        memcpy(dst, src, header.Size);
+    }
+
+    // The image is not cleared up front, each segment zeroes the gap that follows it
+    uint32_t gapStart = header.MemoryOffset + header.Size;
+    uint32_t gapEnd = segment + 1 < SegmentCount ? m_header.Segments[segment + 1].MemoryOffset : m_imageSize;
+    memset(m_image.get() + gapStart, 0, gapEnd - gapStart);
+    if (segment == 0)
+    {
+        memset(m_image.get(), 0, header.MemoryOffset);
+    }
+    return true;
+}
+
+bool Nso::VerifySegment(uint32_t segment) const
+{
+    if (!m_headerValid || segment >= SegmentCount)
+    {
+        return false;
+    }
+    if ((m_header.Flags & (1 << (segment + 3))) == 0)
+    {
+        return true;
+    }
+
+    const NSO_SEGMENT_HEADER & header = m_header.Segments[segment];
+    uint8_t digest[SHA256::DIGEST_SIZE];
+    SHA256 hash;
+    hash.init();
+    hash.update(m_image.get() + header.MemoryOffset, header.Size);
+    hash.final(digest);
+    return memcmp(digest, m_header.SegmentHashes[segment], sizeof(digest)) == 0;
+}
+
+bool Nso::Finish()
+{
+    if (!m_headerValid)
+    {
+        return false;
+    }
+
+    // The MOD0 offset is stored at .text + 4, its bss range takes priority over the header's
+    m_bssSize = PageAlignSize(m_header.Segments[2].AlignmentOrBssSize);
+    const NSO_SEGMENT_HEADER & text = m_header.Segments[0];
+    if (text.Size >= 8)
+    {
+        uint32_t moduleOffset;
+        memcpy(&moduleOffset, m_image.get() + text.MemoryOffset + 4, sizeof(moduleOffset));
+        uint64_t moduleHeaderOffset = (uint64_t)text.MemoryOffset + moduleOffset;
+        if (moduleHeaderOffset <= m_imageSize && sizeof(NSO_MODULE_HEADER) <= m_imageSize - moduleHeaderOffset)
+        {
+            NSO_MODULE_HEADER moduleHeader;
+            memcpy(&moduleHeader, m_image.get() + moduleHeaderOffset, sizeof(moduleHeader));
+            if (*((uint32_t *)(&moduleHeader.Signature[0])) == *((uint32_t *)(&"MOD0")) && moduleHeader.BssEndOffset >= moduleHeader.BssStartOffset)
+            {
+                m_bssSize = PageAlignSize(moduleHeader.BssEndOffset - moduleHeader.BssStartOffset);
+            }
+        }
+    }
+
+    // Everything needed has been copied out of the file
+    m_file.Close();
+    m_valid = true;
+    return true;
+}
+
+const uint8_t * Nso::Data(void) const
+{
+    return m_image.get();
+}
+
+uint32_t Nso::DataSize(void) const
+{
+    return m_imageSize;
+}
+
+uint64_t Nso::CodeSegmentAddr(void) const
+{
+    return m_header.Segments[0].MemoryOffset;
+}
+
+uint64_t Nso::CodeSegmentOffset(void) const
+{
+    return m_header.Segments[0].MemoryOffset;
+}
+
+uint64_t Nso::CodeSegmentSize(void) const
+{
+    return PageAlignSize(m_header.Segments[0].Size);
+}
+
+uint64_t Nso::RODataSegmentAddr(void) const
+{
+    return m_header.Segments[1].MemoryOffset;
+}
+
+uint64_t Nso::RODataSegmentOffset(void) const
+{
+    return m_header.Segments[1].MemoryOffset;
+}
+
+uint64_t Nso::RODataSegmentSize(void) const
+{
+    return PageAlignSize(m_header.Segments[1].Size);
+}
+
+uint64_t Nso::DataSegmentAddr(void) const
+{
+    return m_header.Segments[2].MemoryOffset;
+}
+
+uint64_t Nso::DataSegmentOffset(void) const
+{
+    return m_header.Segments[2].MemoryOffset;
+}
+
+uint64_t Nso::DataSegmentSize(void) const
+{
+    return PageAlignSize(m_header.Segments[2].Size) + m_bssSize;
+}
+
+uint32_t Nso::CodeSize() const
+{
+    return m_imageSize + m_bssSize;
+}
+
+bool Nso::Valid() const
+{
+    return m_valid;
+}
+
+constexpr uint32_t Nso::PageAlignSize(uint32_t size)
+{
+    enum
+    {
+        pageBits = 12,
+        pageSize = 1ULL << pageBits,
+        pageMask = pageSize - 1,
+    };
+    return ((size + pageMask) & ~pageMask);
+}
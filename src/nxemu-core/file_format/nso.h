@@ -0,0 +1,102 @@
+#pragma once
+#include <common/mapped_file.h>
+#include <common/padding.h>
+#include <nxemu-module-spec/base.h>
+#include <memory>
+#include <stdint.h>
+
+class Nso :
+    public IModuleInfo
+{
+    typedef struct
+    {
+        uint32_t FileOffset;
+        uint32_t MemoryOffset;
+        uint32_t Size;
+        uint32_t AlignmentOrBssSize;
+    } NSO_SEGMENT_HEADER;
+
+    typedef struct
+    {
+        uint32_t Offset;
+        uint32_t Size;
+    } NSO_RODATA_EXTENT;
+
+    typedef struct
+    {
+        uint8_t Signature[4];
+        uint32_t Version;
+        PADDING_BYTES(0x4);
+        uint32_t Flags;
+        NSO_SEGMENT_HEADER Segments[3];
+        uint8_t ModuleId[0x20];
+        uint32_t SegmentsFileSize[3];
+        PADDING_BYTES(0x1C);
+        NSO_RODATA_EXTENT ApiInfo;
+        NSO_RODATA_EXTENT DynStr;
+        NSO_RODATA_EXTENT DynSym;
+        uint8_t SegmentHashes[3][0x20];
+    } NSO_HEADER;
+    static_assert(sizeof(NSO_HEADER) == 0x100, "NSO_HEADER has incorrect size.");
+
+    typedef struct
+    {
+        uint8_t Signature[4];
+        uint32_t DynamicOffset;
+        uint32_t BssStartOffset;
+        uint32_t BssEndOffset;
+        uint32_t ExceptionInfoStartOffset;
+        uint32_t ExceptionInfoEndOffset;
+        uint32_t ModuleOffset;
+    } NSO_MODULE_HEADER;
+    static_assert(sizeof(NSO_MODULE_HEADER) == 0x1c, "NSO_MODULE_HEADER has incorrect size.");
+
+public:
+    enum
+    {
+        SegmentCount = 3,
+    };
+
+    Nso(const char * filePath);
+    ~Nso() = default;
+
+    //IModuleInfo
+    const uint8_t * Data(void) const;
+    uint32_t DataSize(void) const;
+    uint64_t CodeSegmentAddr(void) const;
+    uint64_t CodeSegmentOffset(void) const;
+    uint64_t CodeSegmentSize(void) const;
+    uint64_t RODataSegmentAddr(void) const;
+    uint64_t RODataSegmentOffset(void) const;
+    uint64_t RODataSegmentSize(void) const;
+    uint64_t DataSegmentAddr(void) const;
+    uint64_t DataSegmentOffset(void) const;
+    uint64_t DataSegmentSize(void) const;
+
+    // Segments are independent of each other, so they can be loaded and verified from any thread
+    // once the header has been parsed. Finish must be called after every segment has loaded.
+    uint32_t SegmentFileSize(uint32_t segment) const;
+    bool LoadSegment(uint32_t segment);
+    bool VerifySegment(uint32_t segment) const;
+    bool Finish();
+
+    uint32_t CodeSize() const;
+    bool Valid() const;
+
+    static bool IsNsoFile(const char * filePath);
+
+private:
+    Nso(void) = delete;
+    Nso(const Nso &) = delete;
+    Nso & operator=(const Nso &) = delete;
+
+    static constexpr uint32_t PageAlignSize(uint32_t size);
+
+    MappedFile m_file;
+    NSO_HEADER m_header;
+    std::unique_ptr<uint8_t[]> m_image;
+    uint32_t m_imageSize;
+    uint32_t m_bssSize;
+    bool m_headerValid;
+    bool m_valid;
+};
@@ -1,4 +1,6 @@
 #include "switch_system.h"
+#include <common/std_string.h>
+#include "file_format/exefs.h"
 #include "file_format/nacp.h"
 #include "file_format/nro.h"
 #include "settings/core_settings.h"
@@ -88,6 +90,10 @@ bool SwitchSystem::LoadRom(const char * romFile)
     {
         res = LoadNRO(romFile);
     }
+    else if (ExeFS::IsExeFS(romFile))
+    {
+        res = LoadExeFS(romFile);
+    }
 
     if (res)
     {
@@ -117,12 +123,47 @@ bool SwitchSystem::LoadNRO(const char * nroFile)
     {
         return false;
     }
+    if (m_nro->RomFSSize() != 0 && !operatingSystem->LoadRomFS(filePath, m_nro->RomFSOffset(), m_nro->RomFSSize()))
+    {
+        return false;
+    }
     const NACP * Nacp = m_nro->Nacp();
     if (Nacp == nullptr)
     {
         return false;
     }
     Settings::GetInstance().SetString(NXCoreSetting::GameName, Nacp->GetApplicationName().c_str());
+    Settings::GetInstance().SetString(NXCoreSetting::GameTitleId, stdstr_f("%016llX", metaData.GetTitleID()).c_str());
+    operatingSystem->StartApplicationProcess(baseAddress, metaData.GetMainThreadPriority(), metaData.GetMainThreadStackSize());
+    return true;
+}
+
+bool SwitchSystem::LoadExeFS(const char * exefsPath)
+{
+    ExeFS exefs(exefsPath);
+    if (!exefs.Valid())
+    {
+        return false;
+    }
+
+    IOperatingSystem * operatingSystem = m_modules.OperatingSystem();
+    const IProgramMetadata & metaData = exefs.MetaData();
+    uint64_t baseAddress = 0;
+    if (!operatingSystem->CreateApplicationProcess(exefs.CodeSize(), metaData, baseAddress))
+    {
+        return false;
+    }
+
+    // LoadModule copies each image into guest memory, so exefs only has to outlive the load
+    for (uint32_t i = 0, n = exefs.ModuleCount(); i < n; i++)
+    {
+        if (!operatingSystem->LoadModule(exefs.Module(i), baseAddress + exefs.ModuleOffset(i)))
+        {
+            return false;
+        }
+    }
+    Settings::GetInstance().SetString(NXCoreSetting::GameName, metaData.GetName());
+    Settings::GetInstance().SetString(NXCoreSetting::GameTitleId, stdstr_f("%016llX", metaData.GetTitleID()).c_str());
     operatingSystem->StartApplicationProcess(baseAddress, metaData.GetMainThreadPriority(), metaData.GetMainThreadStackSize());
     return true;
 }
@@ -31,6 +31,7 @@ private:
 
     bool Initialize(IRenderWindow & window);
     bool LoadNRO(const char * nroFile);
+    bool LoadExeFS(const char * exefsPath);
 
     static std::unique_ptr<SwitchSystem> m_instance;
     bool m_emulationRunning;
@@ -19,6 +19,8 @@ struct CoreSettingsDefaults
     static constexpr const char * defaultModuleOperatingSystem = "operating_system\\nxemu-os.dll";
 #endif
     static constexpr bool defaultShowConsole = false;
+    static constexpr bool defaultJitTranslationCache = false;
+    static constexpr bool defaultDiskTextureCache = false;
 
     static Path GetDefaultModuleDir();
 };
@@ -62,6 +64,8 @@ void LoadCoreSetting(void)
     settings.SetDefaultString(NXCoreSetting::ModuleVideoSelected, CoreSettingsDefaults::defaultModuleVideo);
     settings.SetDefaultString(NXCoreSetting::ModuleOsSelected, CoreSettingsDefaults::defaultModuleOperatingSystem);
     settings.SetDefaultBool(NXCoreSetting::ShowConsole, CoreSettingsDefaults::defaultShowConsole);
+    settings.SetDefaultBool(NXCoreSetting::JitTranslationCache, CoreSettingsDefaults::defaultJitTranslationCache);
+    settings.SetDefaultBool(NXCoreSetting::DiskTextureCache, CoreSettingsDefaults::defaultDiskTextureCache);
 
     coreSettings.moduleCpuSelected = CoreSettingsDefaults::defaultModuleCpu;
     coreSettings.moduleVideoSelected = CoreSettingsDefaults::defaultModuleVideo;
@@ -69,6 +73,10 @@ void LoadCoreSetting(void)
 
     JsonValue settingValue = jsonSettings["ShowConsole"];
     coreSettings.showConsole = settingValue.isBool() ? settingValue.asBool() : false;
+    settingValue = jsonSettings["JitTranslationCache"];
+    coreSettings.jitTranslationCache = settingValue.isBool() ? settingValue.asBool() : CoreSettingsDefaults::defaultJitTranslationCache;
+    settingValue = jsonSettings["DiskTextureCache"];
+    coreSettings.diskTextureCache = settingValue.isBool() ? settingValue.asBool() : CoreSettingsDefaults::defaultDiskTextureCache;
 
     const JsonValue * modules = jsonSettings.Find("modules");
     if (modules != nullptr && modules->isObject())
@@ -94,10 +102,14 @@ void LoadCoreSetting(void)
     settings.SetString(NXCoreSetting::ModuleCpuSelected, coreSettings.moduleCpuSelected.c_str());
     settings.SetString(NXCoreSetting::ModuleOsSelected, coreSettings.moduleOsSelected.c_str());
     settings.SetBool(NXCoreSetting::ShowConsole, coreSettings.showConsole);
+    settings.SetBool(NXCoreSetting::JitTranslationCache, coreSettings.jitTranslationCache);
+    settings.SetBool(NXCoreSetting::DiskTextureCache, coreSettings.diskTextureCache);
     settings.SetChanged(NXCoreSetting::ModuleVideoSelected, strcmp(coreSettings.moduleVideoSelected.c_str(), CoreSettingsDefaults::defaultModuleVideo) != 0);
     settings.SetChanged(NXCoreSetting::ModuleCpuSelected, strcmp(coreSettings.moduleCpuSelected.c_str(), CoreSettingsDefaults::defaultModuleCpu) != 0);
     settings.SetChanged(NXCoreSetting::ModuleOsSelected, strcmp(coreSettings.moduleOsSelected.c_str(), CoreSettingsDefaults::defaultModuleOperatingSystem) != 0);
     settings.SetChanged(NXCoreSetting::ShowConsole, coreSettings.showConsole != CoreSettingsDefaults::defaultShowConsole);
+    settings.SetChanged(NXCoreSetting::JitTranslationCache, coreSettings.jitTranslationCache != CoreSettingsDefaults::defaultJitTranslationCache);
+    settings.SetChanged(NXCoreSetting::DiskTextureCache, coreSettings.diskTextureCache != CoreSettingsDefaults::defaultDiskTextureCache);
 
     Settings::GetInstance().RegisterCallback(NXCoreSetting::ModuleCpuSelected, std::bind(&ModuleCpuSelectedChanged));
     Settings::GetInstance().RegisterCallback(NXCoreSetting::ModuleVideoSelected, std::bind(&ModuleVideoSelectedChanged));
@@ -137,6 +149,14 @@ void SaveCoreSetting(void)
     {
         json["ModuleDirectory-x64"] = JsonValue(coreSettings.moduleDirValue);
     }
+    if (coreSettings.jitTranslationCache != CoreSettingsDefaults::defaultJitTranslationCache)
+    {
+        json["JitTranslationCache"] = JsonValue(coreSettings.jitTranslationCache);
+    }
+    if (coreSettings.diskTextureCache != CoreSettingsDefaults::defaultDiskTextureCache)
+    {
+        json["DiskTextureCache"] = JsonValue(coreSettings.diskTextureCache);
+    }
 
     Settings & settings = Settings::GetInstance();
     settings.SetSettings("Core", json);
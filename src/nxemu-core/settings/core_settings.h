@@ -5,6 +5,8 @@
 struct CoreSettings
 {
     bool showConsole;
+    bool jitTranslationCache;
+    bool diskTextureCache;
     Path configDir;
     Path moduleDir;
     std::string moduleDirValue;
@@ -4,8 +4,15 @@ namespace NXCoreSetting
 {
 constexpr const char * GameFile = "nxcore:GameFile";
 constexpr const char * GameName = "nxcore:GameName";
+constexpr const char * GameTitleId = "nxcore:GameTitleId";
 constexpr const char * ModuleCpuSelected = "nxcore:ModuleCpuSelected";
 constexpr const char * ModuleVideoSelected = "nxcore:ModuleVideoSelected";
 constexpr const char * ModuleOsSelected = "nxcore:ModuleOsSelected";
 constexpr const char * ShowConsole = "nxcore:ShowConsole";
+constexpr const char * JitTranslationCache = "nxcore:JitTranslationCache";
+constexpr const char * NullRenderer = "nxcore:NullRenderer";
+constexpr const char * JitBlockProfiling = "nxcore:JitBlockProfiling";
+constexpr const char * IpcProfiling = "nxcore:IpcProfiling";
+constexpr const char * SharedServiceHost = "nxcore:SharedServiceHost";
+constexpr const char * DiskTextureCache = "nxcore:DiskTextureCache";
 } // namespace NXCoreSetting
\ No newline at end of file
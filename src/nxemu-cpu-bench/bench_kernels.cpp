@@ -0,0 +1,70 @@
+#include "bench_kernels.h"
+
+namespace
+{
+const uint32_t IntegerKernel[] = {
+    0x8b000021, // loop: add x1, x1, x0
+    0xca010c42, //       eor x2, x2, x1, lsl #3
+    0x9b027c23, //       mul x3, x1, x2
+    0x9b011064, //       madd x4, x3, x1, x4
+    0x93c41c85, //       ror x5, x4, #7
+    0x9ac008a6, //       udiv x6, x5, x0
+    0x8b060021, //       add x1, x1, x6
+    0xf1000400, //       subs x0, x0, #1
+    0x54ffff01, //       b.ne loop
+    0xd4000001, //       svc #0
+};
+
+const uint32_t NeonKernel[] = {
+    0x4e22cc20, // loop: fmla v0.4s, v1.4s, v2.4s
+    0x4e25cc83, //       fmla v3.4s, v4.4s, v5.4s
+    0x4ea784c6, //       add v6.4s, v6.4s, v7.4s
+    0x4ea99cc8, //       mul v8.4s, v6.4s, v9.4s
+    0x6e281d4a, //       eor v10.16b, v10.16b, v8.16b
+    0x4e0c014b, //       tbl v11.16b, {v10.16b}, v12.16b
+    0x4e6ed5ad, //       fadd v13.2d, v13.2d, v14.2d
+    0x2ea7c0cf, //       umull v15.2d, v6.2s, v7.2s
+    0xf1000400, //       subs x0, x0, #1
+    0x54fffee1, //       b.ne loop
+    0xd4000001, //       svc #0
+};
+
+const uint32_t LoadStoreKernel[] = {
+    0xd2800003, //       mov x3, #0
+    0xf8636824, // loop: ldr x4, [x1, x3]
+    0x8b000084, //       add x4, x4, x0
+    0xf8236824, //       str x4, [x1, x3]
+    0xa9411825, //       ldp x5, x6, [x1, #16]
+    0xa9021426, //       stp x6, x5, [x1, #32]
+    0x8a020007, //       and x7, x0, x2
+    0x38676828, //       ldrb w8, [x1, x7]
+    0x39010028, //       strb w8, [x1, #64]
+    0x4c407020, //       ld1 {v0.16b}, [x1]
+    0x4c007020, //       st1 {v0.16b}, [x1]
+    0x91002063, //       add x3, x3, #8
+    0x8a020063, //       and x3, x3, x2
+    0xf1000400, //       subs x0, x0, #1
+    0x54fffe61, //       b.ne loop
+    0xd4000001, //       svc #0
+};
+
+const uint32_t SvcKernel[] = {
+    0xd4000021, // loop: svc #1
+    0xf1000400, //       subs x0, x0, #1
+    0x54ffffc1, //       b.ne loop
+    0xd4000001, //       svc #0
+};
+
+const BenchKernel Kernels[] = {
+    {"integer", "integer alu, multiply and divide", IntegerKernel, sizeof(IntegerKernel) / sizeof(IntegerKernel[0]), 9},
+    {"neon", "neon float and integer vector ops", NeonKernel, sizeof(NeonKernel) / sizeof(NeonKernel[0]), 10},
+    {"loadstore", "scalar, pair, byte and vector loads/stores", LoadStoreKernel, sizeof(LoadStoreKernel) / sizeof(LoadStoreKernel[0]), 14},
+    {"svc", "supervisor call round trips", SvcKernel, sizeof(SvcKernel) / sizeof(SvcKernel[0]), 3},
+};
+} // namespace
+
+const BenchKernel * BenchKernels(uint32_t & count)
+{
+    count = sizeof(Kernels) / sizeof(Kernels[0]);
+    return Kernels;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// Each kernel is entered with x0 = iteration count, x1 = data address, x2 = data offset mask
+// and finishes with svc #0.
+struct BenchKernel
+{
+    const char * name;
+    const char * description;
+    const uint32_t * code;
+    uint32_t codeWords;
+    uint32_t instructionsPerIteration;
+};
+
+enum
+{
+    BENCH_CODE_ADDRESS = 0x1000,
+    BENCH_DATA_ADDRESS = 0x100000,
+    BENCH_DATA_MASK = 0xFFF8,
+    BENCH_MEMORY_SIZE = 0x1000000,
+};
+
+const BenchKernel * BenchKernels(uint32_t & count);
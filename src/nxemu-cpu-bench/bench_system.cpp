@@ -0,0 +1,246 @@
+#include "bench_system.h"
+#include <stdio.h>
+#include <string.h>
+
+BenchMemory::BenchMemory(uint64_t size, bool usePageTable) :
+    m_memory((size_t)size)
+{
+    if (!usePageTable)
+    {
+        return;
+    }
+
+    // The page table stores the host pointer such that host = entry + vaddr, which for a flat
+    // buffer mapped at guest address 0 is simply the buffer base for every mapped page.
+    m_pageTable.resize(1ull << (ADDRESS_SPACE_BITS - PAGE_BITS), nullptr);
+    for (uint64_t page = 0, pageCount = size >> PAGE_BITS; page < pageCount; page++)
+    {
+        m_pageTable[(size_t)page] = m_memory.data();
+    }
+}
+
+void BenchMemory::RasterizerMarkRegionCached(uint64_t /*vaddr*/, uint64_t /*size*/, bool /*cached*/)
+{
+}
+
+uint8_t * BenchMemory::GetPointerSilent(uint64_t vaddr)
+{
+    return vaddr < m_memory.size() ? m_memory.data() + vaddr : nullptr;
+}
+
+void BenchMemory::InvalidateRegion(uint64_t /*vaddr*/, uint64_t /*size*/)
+{
+}
+
+void ** BenchMemory::PageTablePointers()
+{
+    return m_pageTable.empty() ? nullptr : m_pageTable.data();
+}
+
+uint32_t BenchMemory::PageTableAddressSpaceBits() const
+{
+    return ADDRESS_SPACE_BITS;
+}
+
+uint32_t BenchMemory::PageTableAttributeBits() const
+{
+    return 0;
+}
+
+uint8_t * BenchMemory::FastmemArena()
+{
+    return nullptr;
+}
+
+BenchCpuInfo::BenchCpuInfo(BenchMemory & memory) :
+    m_memory(memory),
+    m_executor(nullptr),
+    m_ticks(0),
+    m_memoryReads(0),
+    m_memoryWrites(0),
+    m_serviceCalls(0),
+    m_exited(false)
+{
+}
+
+uint64_t BenchCpuInfo::CpuTicks()
+{
+    return m_ticks;
+}
+
+void BenchCpuInfo::ServiceCall(uint32_t index)
+{
+    // Every svc leaves the JIT, matching the round trip the operating system module takes
+    m_serviceCalls += 1;
+    if (index == SVC_EXIT)
+    {
+        m_exited = true;
+    }
+    m_executor->HaltExecution(IArm64Executor::HaltReason::SupervisorCall);
+}
+
+bool BenchCpuInfo::ReadMemory(uint64_t addr, uint8_t * buffer, uint32_t len)
+{
+    m_memoryReads += 1;
+    if (addr >= m_memory.Size() || len > m_memory.Size() - addr)
+    {
+        memset(buffer, 0, len);
+        return false;
+    }
+    memcpy(buffer, m_memory.Base() + addr, len);
+    return true;
+}
+
+bool BenchCpuInfo::WriteMemory(uint64_t addr, const uint8_t * buffer, uint32_t len)
+{
+    m_memoryWrites += 1;
+    if (addr >= m_memory.Size() || len > m_memory.Size() - addr)
+    {
+        return false;
+    }
+    memcpy(m_memory.Base() + addr, buffer, len);
+    return true;
+}
+
+IMemory & BenchCpuInfo::Memory()
+{
+    return m_memory;
+}
+
+void BenchCpuInfo::AddTicks(uint64_t ticks)
+{
+    m_ticks += ticks;
+}
+
+uint64_t BenchCpuInfo::GetTicksRemaining()
+{
+    return TICKS_PER_SLICE;
+}
+
+bool BenchOperatingSystem::Initialize(void)
+{
+    return true;
+}
+
+bool BenchOperatingSystem::CreateApplicationProcess(uint64_t /*codeSize*/, const IProgramMetadata & /*metaData*/, uint64_t & /*baseAddress*/)
+{
+    return false;
+}
+
+void BenchOperatingSystem::StartApplicationProcess(uint64_t /*baseAddress*/, int32_t /*priority*/, int64_t /*stackSize*/)
+{
+}
+
+bool BenchOperatingSystem::LoadModule(const IModuleInfo & /*module*/, uint64_t /*baseAddress*/)
+{
+    return false;
+}
+
+IDeviceMemory & BenchOperatingSystem::DeviceMemory(void)
+{
+    return *this;
+}
+
+void BenchOperatingSystem::KeyboardKeyPress(int /*modifier*/, int /*keyIndex*/, int /*keyCode*/)
+{
+}
+
+void BenchOperatingSystem::KeyboardKeyRelease(int /*modifier*/, int /*keyIndex*/, int /*keyCode*/)
+{
+}
+
+bool BenchOperatingSystem::GetAndResetPerfStats(OperatingSystemPerfStats & /*stats*/)
+{
+    return false;
+}
+
+uint32_t BenchOperatingSystem::GetThreadCpuTimes(OperatingSystemThreadTime * /*times*/, uint32_t /*maxCount*/)
+{
+    return 0;
+}
+
+uint32_t BenchOperatingSystem::GetIpcProfile(OperatingSystemIpcDispatchStats & dispatch, OperatingSystemIpcCommandStats * /*commands*/, uint32_t /*maxCount*/)
+{
+    dispatch = {0};
+    return 0;
+}
+
+const uint8_t * BenchOperatingSystem::BackingBasePointer() const
+{
+    return nullptr;
+}
+
+bool BenchVideo::Initialize(void)
+{
+    return true;
+}
+
+uint64_t BenchVideo::MemoryAllocate(uint64_t /*size*/)
+{
+    return 0;
+}
+
+void BenchVideo::MemoryTrackContinuity(uint64_t /*address*/, uint64_t /*virtualAddress*/, uint64_t /*size*/, uint64_t /*asid*/)
+{
+}
+
+void BenchVideo::MemoryMap(uint64_t /*address*/, uint64_t /*virtualAddress*/, uint64_t /*size*/, uint64_t /*asid*/, bool /*track*/)
+{
+}
+
+void BenchVideo::RequestComposite(VideoFramebufferConfig * /*layers*/, uint32_t /*layerCount*/, VideoNvFence * /*fences*/, uint32_t /*fenceCount*/)
+{
+}
+
+uint64_t BenchVideo::RegisterProcess(IMemory * /*memory*/)
+{
+    return 0;
+}
+
+BenchSystem::BenchSystem(ICpu *& cpu) :
+    m_cpu(cpu)
+{
+}
+
+IOperatingSystem & BenchSystem::OperatingSystem()
+{
+    return m_operatingSystem;
+}
+
+IVideo & BenchSystem::Video()
+{
+    return m_video;
+}
+
+ICpu & BenchSystem::Cpu()
+{
+    return *m_cpu;
+}
+
+void BenchNotification::DisplayError(const char * message)
+{
+    fprintf(stderr, "Error: %s\n", message);
+}
+
+void BenchNotification::BreakPoint(const char * fileName, uint32_t lineNumber)
+{
+    fprintf(stderr, "Break point: %s(%d)\n", fileName, lineNumber);
+}
+
+std::string BenchSettings::GetString(const char * /*setting*/) const
+{
+    return "";
+}
+
+bool BenchSettings::GetBool(const char * /*setting*/) const
+{
+    return false;
+}
+
+void BenchSettings::SetString(const char * /*setting*/, const char * /*value*/)
+{
+}
+
+void BenchSettings::SetBool(const char * /*setting*/, bool /*value*/)
+{
+}
@@ -0,0 +1,174 @@
+#pragma once
+#ifndef EXPORT
+#define EXPORT
+#endif
+#include <nxemu-module-spec/cpu.h>
+#include <nxemu-module-spec/operating_system.h>
+#include <nxemu-module-spec/video.h>
+#include <vector>
+
+// Flat guest memory starting at guest address 0, optionally exposed through a page table
+// so the JIT can access it inline instead of through the memory callbacks.
+class BenchMemory :
+    public IMemory
+{
+public:
+    enum
+    {
+        PAGE_BITS = 12,
+        ADDRESS_SPACE_BITS = 32,
+    };
+
+    BenchMemory(uint64_t size, bool usePageTable);
+
+    uint8_t * Base(void) { return m_memory.data(); }
+    uint64_t Size(void) const { return m_memory.size(); }
+
+    // IMemory
+    void RasterizerMarkRegionCached(uint64_t vaddr, uint64_t size, bool cached);
+    uint8_t * GetPointerSilent(uint64_t vaddr);
+    void InvalidateRegion(uint64_t vaddr, uint64_t size);
+    void ** PageTablePointers();
+    uint32_t PageTableAddressSpaceBits() const;
+    uint32_t PageTableAttributeBits() const;
+    uint8_t * FastmemArena();
+
+private:
+    BenchMemory() = delete;
+    BenchMemory(const BenchMemory &) = delete;
+    BenchMemory & operator=(const BenchMemory &) = delete;
+
+    std::vector<uint8_t> m_memory;
+    std::vector<void *> m_pageTable;
+};
+
+class BenchCpuInfo :
+    public ICpuInfo
+{
+public:
+    enum
+    {
+        SVC_EXIT = 0,
+        TICKS_PER_SLICE = 100000,
+    };
+
+    BenchCpuInfo(BenchMemory & memory);
+
+    void SetExecutor(IArm64Executor * executor) { m_executor = executor; }
+
+    uint64_t Ticks(void) const { return m_ticks; }
+    uint64_t MemoryReads(void) const { return m_memoryReads; }
+    uint64_t MemoryWrites(void) const { return m_memoryWrites; }
+    uint64_t ServiceCalls(void) const { return m_serviceCalls; }
+    bool Exited(void) const { return m_exited; }
+
+    // ICpuInfo
+    uint64_t CpuTicks();
+    void ServiceCall(uint32_t index);
+    bool ReadMemory(uint64_t addr, uint8_t * buffer, uint32_t len);
+    bool WriteMemory(uint64_t addr, const uint8_t * buffer, uint32_t len);
+    IMemory & Memory();
+    void AddTicks(uint64_t ticks);
+    uint64_t GetTicksRemaining();
+
+private:
+    BenchCpuInfo() = delete;
+    BenchCpuInfo(const BenchCpuInfo &) = delete;
+    BenchCpuInfo & operator=(const BenchCpuInfo &) = delete;
+
+    BenchMemory & m_memory;
+    IArm64Executor * m_executor;
+    uint64_t m_ticks;
+    uint64_t m_memoryReads;
+    uint64_t m_memoryWrites;
+    uint64_t m_serviceCalls;
+    bool m_exited;
+};
+
+class BenchOperatingSystem :
+    public IOperatingSystem,
+    public IDeviceMemory
+{
+public:
+    BenchOperatingSystem() = default;
+
+    // IOperatingSystem
+    bool Initialize(void);
+    bool CreateApplicationProcess(uint64_t codeSize, const IProgramMetadata & metaData, uint64_t & baseAddress);
+    void StartApplicationProcess(uint64_t baseAddress, int32_t priority, int64_t stackSize);
+    bool LoadModule(const IModuleInfo & module, uint64_t baseAddress);
+    IDeviceMemory & DeviceMemory(void);
+    void KeyboardKeyPress(int modifier, int keyIndex, int keyCode);
+    void KeyboardKeyRelease(int modifier, int keyIndex, int keyCode);
+    bool GetAndResetPerfStats(OperatingSystemPerfStats & stats);
+    uint32_t GetThreadCpuTimes(OperatingSystemThreadTime * times, uint32_t maxCount);
+    uint32_t GetIpcProfile(OperatingSystemIpcDispatchStats & dispatch, OperatingSystemIpcCommandStats * commands, uint32_t maxCount);
+
+    // IDeviceMemory
+    const uint8_t * BackingBasePointer() const;
+
+private:
+    BenchOperatingSystem(const BenchOperatingSystem &) = delete;
+    BenchOperatingSystem & operator=(const BenchOperatingSystem &) = delete;
+};
+
+class BenchVideo :
+    public IVideo
+{
+public:
+    BenchVideo() = default;
+
+    // IVideo
+    bool Initialize(void);
+    uint64_t MemoryAllocate(uint64_t size);
+    void MemoryTrackContinuity(uint64_t address, uint64_t virtualAddress, uint64_t size, uint64_t asid);
+    void MemoryMap(uint64_t address, uint64_t virtualAddress, uint64_t size, uint64_t asid, bool track);
+    void RequestComposite(VideoFramebufferConfig * layers, uint32_t layerCount, VideoNvFence * fences, uint32_t fenceCount);
+    uint64_t RegisterProcess(IMemory * memory);
+
+private:
+    BenchVideo(const BenchVideo &) = delete;
+    BenchVideo & operator=(const BenchVideo &) = delete;
+};
+
+// Stands in for SwitchSystem so the cpu module can be created without the os and video modules
+class BenchSystem :
+    public ISwitchSystem
+{
+public:
+    BenchSystem(ICpu *& cpu);
+
+    // ISwitchSystem
+    IOperatingSystem & OperatingSystem();
+    IVideo & Video();
+    ICpu & Cpu();
+
+private:
+    BenchSystem() = delete;
+    BenchSystem(const BenchSystem &) = delete;
+    BenchSystem & operator=(const BenchSystem &) = delete;
+
+    BenchOperatingSystem m_operatingSystem;
+    BenchVideo m_video;
+    ICpu *& m_cpu;
+};
+
+class BenchNotification :
+    public IModuleNotification
+{
+public:
+    // IModuleNotification
+    void DisplayError(const char * message);
+    void BreakPoint(const char * fileName, uint32_t lineNumber);
+};
+
+class BenchSettings :
+    public IModuleSettings
+{
+public:
+    // IModuleSettings
+    std::string GetString(const char * setting) const;
+    bool GetBool(const char * setting) const;
+    void SetString(const char * setting, const char * value);
+    void SetBool(const char * setting, bool value);
+};
@@ -0,0 +1,583 @@
+#include "bench_textures.h"
+#include <chrono>
+#include <span>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "yuzu_video_core/engines/sw_blitter/converter.h"
+#include "yuzu_video_core/engines/sw_blitter/scaler.h"
+#include "yuzu_video_core/host1x/vic.h"
+#include "yuzu_video_core/textures/astc.h"
+#include "yuzu_video_core/textures/decoders.h"
+#include "yuzu_video_core/textures/host_simd.h"
+
+namespace
+{
+// Fills a buffer with a repeatable byte pattern that is not periodic on any power of two
+void FillPattern(std::vector<uint8_t> & data, uint32_t seed)
+{
+    uint32_t state = seed * 2654435761u + 1;
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (uint8_t)(state >> 24);
+    }
+}
+
+// Best time of a number of runs, in milliseconds
+template <typename Func>
+double TimeBest(uint32_t repeats, Func && func)
+{
+    double best = 0;
+    for (uint32_t i = 0; i < repeats; i++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || ms < best)
+        {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+// Best time of a number of runs with the texture kernels limited to an instruction set
+template <typename Func>
+double TimeBest(Tegra::Texture::HostSimd simd, uint32_t repeats, Func && func)
+{
+    Tegra::Texture::SetHostSimdLimit(simd);
+    const double best = TimeBest(repeats, func);
+    Tegra::Texture::SetHostSimdLimit(Tegra::Texture::HostSimd::AVX2);
+    return best;
+}
+
+bool PrintCase(const char * bench, const char * caseName, double scalarMs, double simdMs, bool exact)
+{
+    printf("%-10s %-28s %12.3f %12.3f %7.2fx %s\n", bench, caseName, scalarMs, simdMs, simdMs > 0 ? scalarMs / simdMs : 0.0, exact ? "ok" : "MISMATCH");
+    return exact;
+}
+
+// Block linear layout of a 2D texture as the swizzle sees it, with a stride alignment of one
+struct SwizzleShape
+{
+    uint32_t bytesPerPixel;
+    uint32_t width;
+    uint32_t height;
+    uint32_t blockHeight;
+};
+
+// Offset of a texel in the block linear texture, computed from the GOB swizzle table the way the
+// hardware documents it
+size_t ReferenceSwizzledOffset(const SwizzleShape & shape, uint32_t x, uint32_t y)
+{
+    using namespace Tegra::Texture;
+    static constexpr SwizzleTable table = MakeSwizzleTable();
+
+    const uint32_t gobsInX = (shape.width * shape.bytesPerPixel + GOB_SIZE_X - 1) / GOB_SIZE_X;
+    const uint32_t gobsInBlock = 1u << shape.blockHeight;
+    const size_t blockSize = (size_t)gobsInX * gobsInBlock * GOB_SIZE;
+    const uint32_t gobY = y / GOB_SIZE_Y;
+
+    size_t offset = (gobY / gobsInBlock) * blockSize;
+    offset += (size_t)(x / GOB_SIZE_X) * gobsInBlock * GOB_SIZE;
+    offset += (gobY % gobsInBlock) * GOB_SIZE;
+    return offset + table[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+}
+
+// Moves the texture an element at a time, the way the swizzle worked before it moved whole GOBs.
+// Elements are the largest power of two up to 16 bytes that divides the pitch, so none of them
+// straddles two 16 byte runs of a GOB.
+void ReferenceSwizzle(const SwizzleShape & shape, bool toLinear, std::span<const uint8_t> input, std::span<uint8_t> output)
+{
+    const uint32_t pitch = shape.width * shape.bytesPerPixel;
+    uint32_t elementSize = 16;
+    while (pitch % elementSize != 0)
+    {
+        elementSize /= 2;
+    }
+    for (uint32_t y = 0; y < shape.height; y++)
+    {
+        for (uint32_t x = 0; x < pitch; x += elementSize)
+        {
+            const size_t swizzled = ReferenceSwizzledOffset(shape, x, y);
+            const size_t linear = (size_t)y * pitch + x;
+            memcpy(&output[toLinear ? linear : swizzled], &input[toLinear ? swizzled : linear], elementSize);
+        }
+    }
+}
+
+bool RunSwizzle(uint32_t repeats)
+{
+    static const uint32_t bytesPerPixel[] = {1, 2, 3, 4, 6, 8, 12, 16};
+
+    bool exact = true;
+    for (uint32_t i = 0; i < sizeof(bytesPerPixel) / sizeof(bytesPerPixel[0]); i++)
+    {
+        // Neither side is a multiple of a GOB, so the partial GOBs at the edges are checked too
+        const SwizzleShape shape = {bytesPerPixel[i], 1000, 1000, 4};
+        std::vector<uint8_t> linear((size_t)shape.width * shape.bytesPerPixel * shape.height);
+        std::vector<uint8_t> swizzled(Tegra::Texture::CalculateSize(true, shape.bytesPerPixel, shape.width, shape.height, 1, shape.blockHeight, 0));
+        FillPattern(linear, i);
+        FillPattern(swizzled, i + 100);
+
+        for (uint32_t direction = 0; direction < 2; direction++)
+        {
+            // Swizzling leaves the bytes of the block linear texture outside the image alone
+            const bool toLinear = direction == 0;
+            std::vector<uint8_t> reference(toLinear ? linear.size() : swizzled.size());
+            if (!toLinear)
+            {
+                reference = swizzled;
+            }
+            std::vector<uint8_t> output(reference);
+
+            const double scalarMs = TimeBest(repeats, [&]()
+            {
+                ReferenceSwizzle(shape, toLinear, toLinear ? swizzled : linear, reference);
+            });
+            const double simdMs = TimeBest(repeats, [&]()
+            {
+                if (toLinear)
+                {
+                    Tegra::Texture::UnswizzleTexture(output, swizzled, shape.bytesPerPixel, shape.width, shape.height, 1, shape.blockHeight, 0);
+                }
+                else
+                {
+                    Tegra::Texture::SwizzleTexture(output, linear, shape.bytesPerPixel, shape.width, shape.height, 1, shape.blockHeight, 0);
+                }
+            });
+
+            char caseName[64];
+            snprintf(caseName, sizeof(caseName), "%s %ux%u %u bpp", toLinear ? "unswizzle" : "swizzle", shape.width, shape.height, shape.bytesPerPixel);
+            exact &= PrintCase("swizzle", caseName, scalarMs, simdMs, output == reference);
+        }
+    }
+    return exact;
+}
+
+// 128 bit ASTC block under construction, fields are written from the least significant bit
+struct AstcBlock
+{
+    uint64_t bits[2];
+
+    void Set(uint32_t offset, uint32_t count, uint64_t value)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const uint32_t bit = offset + i;
+            const uint64_t mask = 1ull << (bit % 64);
+            bits[bit / 64] = ((value >> i) & 1) != 0 ? bits[bit / 64] | mask : bits[bit / 64] & ~mask;
+        }
+    }
+};
+
+struct AstcBlockMode
+{
+    uint32_t mode;
+    uint32_t weightBits;
+};
+
+// Bits an integer sequence of count values takes in the weight range picked by the R field and
+// the H bit of a block mode
+uint32_t AstcWeightBits(uint32_t R, bool H, uint32_t count)
+{
+    // Plain bits, trits and quints of each range
+    static const uint8_t ranges[2][6][3] = {
+        {{1, 0, 0}, {0, 1, 0}, {2, 0, 0}, {0, 0, 1}, {1, 1, 0}, {3, 0, 0}},
+        {{1, 0, 1}, {2, 1, 0}, {4, 0, 0}, {2, 0, 1}, {3, 1, 0}, {5, 0, 0}},
+    };
+    const uint8_t * range = ranges[H ? 1 : 0][R - 2];
+    return count * range[0] + (range[1] != 0 ? (count * 8 + 4) / 5 : 0) + (range[2] != 0 ? (count * 7 + 2) / 3 : 0);
+}
+
+// Decodes the weight grid of a block mode as laid out in the table of the ASTC specification.
+// Returns false for void extents and reserved modes.
+bool DecodeAstcBlockMode(uint32_t mode, uint32_t & gridWidth, uint32_t & gridHeight, bool & dualPlane, uint32_t & weightBits)
+{
+    if ((mode & 0x1FF) == 0x1FC || (mode & 0xF) == 0 || ((mode & 3) == 0 && (mode & 0x1C0) == 0x1C0))
+    {
+        return false;
+    }
+    const uint32_t A = (mode >> 5) & 3;
+    const uint32_t B = (mode >> 7) & 3;
+    uint32_t R = (mode >> 4) & 1;
+    bool highPrecision = (mode & 0x200) != 0;
+    dualPlane = (mode & 0x400) != 0;
+    if ((mode & 3) != 0)
+    {
+        R |= (mode & 3) << 1;
+        switch ((mode >> 2) & 3)
+        {
+        case 0:
+            gridWidth = B + 4;
+            gridHeight = A + 2;
+            break;
+        case 1:
+            gridWidth = B + 8;
+            gridHeight = A + 2;
+            break;
+        case 2:
+            gridWidth = A + 2;
+            gridHeight = B + 8;
+            break;
+        default:
+            gridWidth = (mode & 0x100) != 0 ? (B & 1) + 2 : A + 2;
+            gridHeight = (mode & 0x100) != 0 ? A + 2 : (B & 1) + 6;
+            break;
+        }
+    }
+    else
+    {
+        R |= ((mode >> 2) & 3) << 1;
+        switch (B)
+        {
+        case 0:
+            gridWidth = 12;
+            gridHeight = A + 2;
+            break;
+        case 1:
+            gridWidth = A + 2;
+            gridHeight = 12;
+            break;
+        case 2:
+            gridWidth = A + 6;
+            gridHeight = ((mode >> 9) & 3) + 6;
+            highPrecision = false;
+            dualPlane = false;
+            break;
+        default:
+            gridWidth = (mode & 0x20) != 0 ? 10 : 6;
+            gridHeight = (mode & 0x20) != 0 ? 6 : 10;
+            break;
+        }
+    }
+    weightBits = AstcWeightBits(R, highPrecision, gridWidth * gridHeight * (dualPlane ? 2 : 1));
+    return true;
+}
+
+// Bits of the smallest color range the specification allows, values in 0..5
+uint32_t AstcMinColorBits(uint32_t values)
+{
+    return values + (values * 8 + 4) / 5;
+}
+
+// Writes a texture of valid LDR blocks for a footprint: mostly single partition, single plane
+// blocks over every usable block mode and endpoint mode, with dual plane, two partition and void
+// extent blocks mixed in
+void MakeAstcTexture(uint32_t blockWidth, uint32_t blockHeight, uint32_t numBlocks, uint32_t seed, std::vector<uint8_t> & data)
+{
+    static const uint32_t endpointModes[] = {0, 1, 4, 5, 6, 8, 9, 10, 12, 13};
+    const uint32_t numEndpointModes = sizeof(endpointModes) / sizeof(endpointModes[0]);
+
+    std::vector<AstcBlockMode> singlePlane, dualPlane;
+    for (uint32_t mode = 0; mode < 0x800; mode++)
+    {
+        uint32_t gridWidth, gridHeight, weightBits;
+        bool dual;
+        if (!DecodeAstcBlockMode(mode, gridWidth, gridHeight, dual, weightBits) || gridWidth > blockWidth || gridHeight > blockHeight ||
+            gridWidth * gridHeight * (dual ? 2 : 1) > 64 || weightBits < 24 || weightBits > 96)
+        {
+            continue;
+        }
+        (dual ? dualPlane : singlePlane).push_back({mode, weightBits});
+    }
+
+    std::vector<uint8_t> random(numBlocks * 16);
+    FillPattern(random, seed);
+    data.resize(numBlocks * 16);
+
+    uint32_t state = seed * 2246822519u + 3;
+    const auto next = [&state](uint32_t range) -> uint32_t
+    {
+        state = state * 1664525u + 1013904223u;
+        return (uint32_t)(((uint64_t)(state >> 8) * range) >> 24);
+    };
+
+    for (uint32_t i = 0; i < numBlocks; i++)
+    {
+        AstcBlock block;
+        memcpy(block.bits, &random[i * 16], 16);
+
+        const uint32_t kind = next(100);
+        if (kind < 5)
+        {
+            // Void extent with the extent coordinates all ones, followed by the RGBA color
+            block.Set(0, 12, 0xDFC);
+            block.Set(12, 52, ~0ull);
+        }
+        else
+        {
+            // Tries block and endpoint modes until the endpoints fit in the bits left
+            const bool twoPartitions = kind < 12;
+            const bool dual = kind >= 12 && kind < 20 && !dualPlane.empty();
+            const std::vector<AstcBlockMode> & modes = dual ? dualPlane : singlePlane;
+            for (;;)
+            {
+                const AstcBlockMode & mode = modes[next((uint32_t)modes.size())];
+                const uint32_t endpointMode = endpointModes[next(numEndpointModes)];
+                const uint32_t headerBits = twoPartitions ? 29 : 17;
+                const uint32_t planeBits = dual ? 2 : 0;
+                const uint32_t colorValues = ((endpointMode >> 2) + 1) * 2 * (twoPartitions ? 2 : 1);
+                if (128 - headerBits - planeBits - mode.weightBits < AstcMinColorBits(colorValues))
+                {
+                    continue;
+                }
+                block.Set(0, 11, mode.mode);
+                if (twoPartitions)
+                {
+                    // Both partitions share the endpoint mode, the partition index stays random
+                    block.Set(11, 2, 1);
+                    block.Set(23, 6, endpointMode << 2);
+                }
+                else
+                {
+                    block.Set(11, 2, 0);
+                    block.Set(13, 4, endpointMode);
+                }
+                break;
+            }
+        }
+        memcpy(&data[i * 16], block.bits, 16);
+    }
+}
+
+bool RunAstc(uint32_t repeats)
+{
+    static const uint32_t footprints[][2] = {
+        {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12},
+    };
+
+    // Not a multiple of any footprint but 4 wide, so the partial blocks at the edges are checked too
+    const uint32_t width = 500, height = 500;
+    bool exact = true;
+    for (uint32_t i = 0; i < sizeof(footprints) / sizeof(footprints[0]); i++)
+    {
+        const uint32_t blockWidth = footprints[i][0], blockHeight = footprints[i][1];
+        const uint32_t numBlocks = ((width + blockWidth - 1) / blockWidth) * ((height + blockHeight - 1) / blockHeight);
+        std::vector<uint8_t> data;
+        MakeAstcTexture(blockWidth, blockHeight, numBlocks, i, data);
+
+        std::vector<uint8_t> reference((size_t)width * height * 4), output(reference.size());
+        const double scalarMs = TimeBest(Tegra::Texture::HostSimd::None, repeats, [&]()
+        {
+            Tegra::Texture::ASTC::Decompress(data, width, height, 1, blockWidth, blockHeight, reference);
+        });
+        const double simdMs = TimeBest(Tegra::Texture::HostSimd::AVX2, repeats, [&]()
+        {
+            Tegra::Texture::ASTC::Decompress(data, width, height, 1, blockWidth, blockHeight, output);
+        });
+
+        char caseName[64];
+        snprintf(caseName, sizeof(caseName), "%ux%u %ux%u", blockWidth, blockHeight, width, height);
+        exact &= PrintCase("astc", caseName, scalarMs, simdMs, output == reference);
+    }
+    return exact;
+}
+
+// Clears the top exponent bit of every half, so no value is infinite or NaN. The sign of a NaN
+// the lerps produce depends on the operand order the compiler picks for the scalar path
+void ClearHalfExponentTop(std::vector<uint8_t> & data)
+{
+    for (size_t i = 1; i < data.size(); i += 2)
+    {
+        data[i] &= 0xbf;
+    }
+}
+
+bool RunBlitter(uint32_t repeats)
+{
+    using Tegra::RenderTargetFormat;
+    using Tegra::Texture::HostSimd;
+
+    struct ConvertCase
+    {
+        const char * name;
+        RenderTargetFormat format;
+        uint32_t bytesPerPixel;
+    };
+    static const ConvertCase converts[] = {
+        {"A8B8G8R8_UNORM", RenderTargetFormat::A8B8G8R8_UNORM, 4},
+        {"A8R8G8B8_UNORM", RenderTargetFormat::A8R8G8B8_UNORM, 4},
+        {"R5G6B5_UNORM", RenderTargetFormat::R5G6B5_UNORM, 2},
+        {"B10G11R11_FLOAT", RenderTargetFormat::B10G11R11_FLOAT, 4},
+        {"R16G16B16A16_FLOAT", RenderTargetFormat::R16G16B16A16_FLOAT, 8},
+    };
+
+    // An odd width leaves a remainder for the scalar tail of every vector loop
+    const uint32_t width = 1919, height = 1080;
+    const size_t numPixels = (size_t)width * height;
+    Tegra::Engines::Blitter::ConverterFactory factory;
+    bool exact = true;
+    for (uint32_t i = 0; i < sizeof(converts) / sizeof(converts[0]); i++)
+    {
+        const ConvertCase & test = converts[i];
+        Tegra::Engines::Blitter::Converter * converter = factory.GetFormatConverter(test.format);
+        std::vector<uint8_t> texels(numPixels * test.bytesPerPixel);
+        FillPattern(texels, i);
+
+        std::vector<float> referenceIr(numPixels * 4), outputIr(referenceIr.size());
+        const double toScalarMs = TimeBest(HostSimd::None, repeats, [&]()
+        {
+            converter->ConvertTo(texels, referenceIr);
+        });
+        const double toSimdMs = TimeBest(HostSimd::AVX2, repeats, [&]()
+        {
+            converter->ConvertTo(texels, outputIr);
+        });
+
+        char caseName[64];
+        snprintf(caseName, sizeof(caseName), "to IR %s", test.name);
+        exact &= PrintCase("blitter", caseName, toScalarMs, toSimdMs, memcmp(referenceIr.data(), outputIr.data(), referenceIr.size() * sizeof(float)) == 0);
+
+        std::vector<uint8_t> reference(texels.size()), output(texels.size());
+        const double fromScalarMs = TimeBest(HostSimd::None, repeats, [&]()
+        {
+            converter->ConvertFrom(referenceIr, reference);
+        });
+        const double fromSimdMs = TimeBest(HostSimd::AVX2, repeats, [&]()
+        {
+            converter->ConvertFrom(referenceIr, output);
+        });
+
+        snprintf(caseName, sizeof(caseName), "from IR %s", test.name);
+        exact &= PrintCase("blitter", caseName, fromScalarMs, fromSimdMs, output == reference);
+    }
+
+    struct ScaleCase
+    {
+        const char * name;
+        RenderTargetFormat srcFormat;
+        uint32_t srcBytesPerPixel;
+        uint32_t srcWidth, srcHeight;
+        RenderTargetFormat dstFormat;
+        uint32_t dstBytesPerPixel;
+        uint32_t dstWidth, dstHeight;
+        bool bilinear;
+    };
+    static const ScaleCase scales[] = {
+        {"point 720p ARGB8 to 1080p", RenderTargetFormat::A8R8G8B8_UNORM, 4, 1280, 720, RenderTargetFormat::A8B8G8R8_UNORM, 4, 1920, 1080, false},
+        {"linear 720p to 1080p ABGR8", RenderTargetFormat::A8B8G8R8_UNORM, 4, 1280, 720, RenderTargetFormat::A8B8G8R8_UNORM, 4, 1920, 1080, true},
+        {"linear 1080p RGBA16F to 720p", RenderTargetFormat::R16G16B16A16_FLOAT, 8, 1920, 1080, RenderTargetFormat::B10G11R11_FLOAT, 4, 1280, 720, true},
+    };
+
+    Tegra::Engines::Blitter::BlitScaler scaler;
+    for (uint32_t i = 0; i < sizeof(scales) / sizeof(scales[0]); i++)
+    {
+        const ScaleCase & test = scales[i];
+        std::vector<uint8_t> input((size_t)test.srcWidth * test.srcHeight * test.srcBytesPerPixel);
+        FillPattern(input, i + 100);
+        if (test.srcFormat == RenderTargetFormat::R16G16B16A16_FLOAT)
+        {
+            ClearHalfExponentTop(input);
+        }
+
+        std::vector<uint8_t> reference((size_t)test.dstWidth * test.dstHeight * test.dstBytesPerPixel), output(reference.size());
+        const double scalarMs = TimeBest(HostSimd::None, repeats, [&]()
+        {
+            scaler.Scale(input, test.srcFormat, test.srcWidth, test.srcHeight, reference, test.dstFormat, test.dstWidth, test.dstHeight, test.bilinear);
+        });
+        const double simdMs = TimeBest(HostSimd::AVX2, repeats, [&]()
+        {
+            scaler.Scale(input, test.srcFormat, test.srcWidth, test.srcHeight, output, test.dstFormat, test.dstWidth, test.dstHeight, test.bilinear);
+        });
+        exact &= PrintCase("blitter", test.name, scalarMs, simdMs, output == reference);
+    }
+    return exact;
+}
+
+bool RunVic(uint32_t repeats)
+{
+    using Tegra::Texture::HostSimd;
+
+    struct VicCase
+    {
+        const char * name;
+        uint32_t width;
+        bool interleaved;
+    };
+    // The odd widths leave a remainder for the scalar tail of both vector loops
+    static const VicCase cases[] = {
+        {"NV12", 1920, true},
+        {"YV12", 1920, false},
+        {"NV12", 1917, true},
+        {"YV12", 1917, false},
+    };
+    static const HostSimd kernels[] = {HostSimd::SSE41, HostSimd::AVX2};
+    static const char * kernelNames[] = {"SSE4.1", "AVX2"};
+
+    // A whole frame on one thread, the way a single worker would convert it
+    const uint32_t height = 1080;
+    bool exact = true;
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const VicCase & test = cases[i];
+        const uint32_t chromaWidth = (test.width + 1) / 2, chromaHeight = (height + 1) / 2;
+        const uint32_t chromaPitch = test.interleaved ? chromaWidth * 2 : chromaWidth;
+        std::vector<uint8_t> luma((size_t)test.width * height), chromaU((size_t)chromaPitch * chromaHeight), chromaV(chromaU.size());
+        FillPattern(luma, i);
+        FillPattern(chromaU, i + 100);
+        FillPattern(chromaV, i + 200);
+
+        const auto convertFrame = [&](std::vector<uint32_t> & frame)
+        {
+            for (uint32_t y = 0; y < height; y++)
+            {
+                const size_t chromaOffset = (size_t)(y / 2) * chromaPitch;
+                Tegra::Host1x::ConvertYuv420Row(&frame[(size_t)y * test.width], &luma[(size_t)y * test.width], &chromaU[chromaOffset], &chromaV[chromaOffset], test.width, test.interleaved);
+            }
+        };
+
+        std::vector<uint32_t> reference((size_t)test.width * height);
+        const double scalarMs = TimeBest(HostSimd::None, repeats, [&]()
+        {
+            convertFrame(reference);
+        });
+        for (uint32_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+        {
+            std::vector<uint32_t> output(reference.size());
+            const double simdMs = TimeBest(kernels[k], repeats, [&]()
+            {
+                convertFrame(output);
+            });
+
+            char caseName[64];
+            snprintf(caseName, sizeof(caseName), "%s %ux%u %s", test.name, test.width, height, kernelNames[k]);
+            exact &= PrintCase("vic", caseName, scalarMs, simdMs, output == reference);
+        }
+    }
+    return exact;
+}
+
+const TextureBench Benches[] = {
+    {"swizzle", "block linear swizzle element by element against a GOB at a time, every bytes per pixel", RunSwizzle},
+    {"astc", "ASTC decoder block by block against the batched SIMD decoder, every 2D footprint", RunAstc},
+    {"blitter", "software blit converters and scaling scalar against SSE2, the formats with vector paths", RunBlitter},
+    {"vic", "VIC 4:2:0 to RGBA8 scalar against SSE4.1 and AVX2, 1080p NV12 and YV12 frames", RunVic},
+};
+} // namespace
+
+const TextureBench * TextureBenches(uint32_t & count)
+{
+    count = sizeof(Benches) / sizeof(Benches[0]);
+    return Benches;
+}
+
+bool RunTextureBenches(const char * name, uint32_t repeats)
+{
+    static const char * simdNames[] = {"none", "SSE2", "SSE4.1", "AVX2"};
+    printf("Best of %u runs, host SIMD %s\n\n", repeats, simdNames[(uint32_t)Tegra::Texture::GetHostSimd()]);
+    printf("%-10s %-28s %12s %12s %8s %s\n", "bench", "case", "scalar (ms)", "simd (ms)", "speedup", "check");
+
+    bool exact = true;
+    for (uint32_t i = 0; i < sizeof(Benches) / sizeof(Benches[0]); i++)
+    {
+        if (name[0] != '\0' && strcmp(name, Benches[i].name) != 0)
+        {
+            continue;
+        }
+        exact &= Benches[i].run(repeats);
+    }
+    return exact;
+}
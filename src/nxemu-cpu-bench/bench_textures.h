@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+// Texture and surface kernels of the video core. Every case times the scalar path of a kernel
+// against its vectorized path and only passes when both produce the same bytes.
+struct TextureBench
+{
+    const char * name;
+    const char * description;
+    bool (*run)(uint32_t repeats);
+};
+
+const TextureBench * TextureBenches(uint32_t & count);
+
+// Runs the benches called name, or every bench for an empty name. Returns false when any case
+// was not bit-exact.
+bool RunTextureBenches(const char * name, uint32_t repeats);
@@ -0,0 +1,266 @@
+#include "bench_kernels.h"
+#include "bench_system.h"
+#include "bench_textures.h"
+#include <chrono>
+#include <common/dynamic_library.h>
+#include <common/path.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+namespace
+{
+typedef void(CALL * tyGetModuleInfo)(MODULE_INFO * info);
+typedef int(CALL * tyModuleInitialize)(ModuleInterfaces & interfaces);
+typedef void(CALL * tyModuleCleanup)();
+typedef ICpu *(CALL * tyCreateCpu)(ISwitchSystem & System);
+typedef void(CALL * tyDestroyCpu)(ICpu * Cpu);
+
+#ifdef _DEBUG
+const char * DefaultCpuModule = "cpu\\nxemu-cpu_d.dll";
+#else
+const char * DefaultCpuModule = "cpu\\nxemu-cpu.dll";
+#endif
+
+struct BenchOptions
+{
+    std::string modulePath;
+    std::string kernel;
+    std::string texture;
+    uint64_t iterations;
+    uint32_t repeats;
+    bool usePageTable;
+};
+
+struct BenchResult
+{
+    uint64_t guestInstructions;
+    double seconds;
+    uint64_t memoryReads;
+    uint64_t memoryWrites;
+    uint64_t serviceCalls;
+    Arm64JitStatistics jit;
+};
+
+void Usage(const char * program)
+{
+    uint32_t kernelCount;
+    const BenchKernel * kernels = BenchKernels(kernelCount);
+
+    uint32_t textureCount;
+    const TextureBench * textures = TextureBenches(textureCount);
+
+    printf("Usage: %s [--module <cpu module>] [--iterations <count>] [--kernel <name>] [--no-page-table]\n", program);
+    printf("       %s --texture <name|all> [--repeats <count>]\n", program);
+    printf("Kernels:\n");
+    for (uint32_t i = 0; i < kernelCount; i++)
+    {
+        printf("  %-10s %s\n", kernels[i].name, kernels[i].description);
+    }
+    printf("Texture benches:\n");
+    for (uint32_t i = 0; i < textureCount; i++)
+    {
+        printf("  %-10s %s\n", textures[i].name, textures[i].description);
+    }
+}
+
+bool ParseOptions(int argc, char * argv[], BenchOptions & options)
+{
+    Path modulePath(Path("..\\..\\..\\modules\\x64\\", DefaultCpuModule));
+    modulePath.DirectoryNormalize(Path(Path::MODULE_DIRECTORY));
+
+    options.modulePath = (const char *)modulePath;
+    options.iterations = 10000000;
+    options.repeats = 10;
+    options.usePageTable = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--module") == 0 && i + 1 < argc)
+        {
+            options.modulePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            options.iterations = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc)
+        {
+            options.kernel = argv[++i];
+        }
+        else if (strcmp(argv[i], "--texture") == 0 && i + 1 < argc)
+        {
+            options.texture = argv[++i];
+        }
+        else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc)
+        {
+            options.repeats = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--no-page-table") == 0)
+        {
+            options.usePageTable = false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.iterations != 0 && options.repeats != 0;
+}
+
+bool RunKernel(ICpu & cpu, IExclusiveMonitor * monitor, BenchMemory & memory, const BenchKernel & kernel, uint64_t iterations, BenchResult & result)
+{
+    memset(memory.Base(), 0, (size_t)memory.Size());
+    memcpy(memory.Base() + BENCH_CODE_ADDRESS, kernel.code, kernel.codeWords * sizeof(uint32_t));
+
+    BenchCpuInfo info(memory);
+    IArm64Executor * executor = cpu.CreateArm64Executor(monitor, info, 0, false);
+    if (executor == nullptr)
+    {
+        return false;
+    }
+    info.SetExecutor(executor);
+
+    Arm64ThreadContext context = {0};
+    context.r[0] = iterations;
+    context.r[1] = BENCH_DATA_ADDRESS;
+    context.r[2] = BENCH_DATA_MASK;
+    context.sp = BENCH_MEMORY_SIZE - 0x1000;
+    context.pc = BENCH_CODE_ADDRESS;
+    executor->SetContext(context);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (!info.Exited())
+    {
+        executor->Execute();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    result.guestInstructions = iterations * kernel.instructionsPerIteration + (kernel.codeWords - kernel.instructionsPerIteration);
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.memoryReads = info.MemoryReads();
+    result.memoryWrites = info.MemoryWrites();
+    result.serviceCalls = info.ServiceCalls();
+    executor->GetJitStatistics(result.jit);
+    cpu.DestroyArm64Executor(executor);
+    return true;
+}
+
+void PrintResult(const BenchKernel & kernel, const BenchResult & result)
+{
+    printf("%-10s %12.3f %10.2f %12llu %12llu %10llu %8llu %10.3f %8llu/%llu\n",
+           kernel.name,
+           result.seconds * 1000.0,
+           result.seconds > 0 ? (double)result.guestInstructions / result.seconds / 1000000.0 : 0.0,
+           (unsigned long long)result.memoryReads,
+           (unsigned long long)result.memoryWrites,
+           (unsigned long long)result.serviceCalls,
+           (unsigned long long)result.jit.blocksCompiled,
+           (double)result.jit.compileTimeNs / 1000000.0,
+           (unsigned long long)(result.jit.codeCacheUsed / 1024),
+           (unsigned long long)(result.jit.codeCacheSize / 1024));
+}
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    if (!options.texture.empty())
+    {
+        // The texture kernels live in the video core, no cpu module is needed for them
+        return RunTextureBenches(options.texture == "all" ? "" : options.texture.c_str(), options.repeats) ? 0 : 1;
+    }
+
+    DynLibHandle lib = DynamicLibraryOpen(options.modulePath.c_str());
+    if (lib == nullptr)
+    {
+        fprintf(stderr, "Failed to load cpu module: %s\n", options.modulePath.c_str());
+        return 1;
+    }
+
+    tyGetModuleInfo GetModuleInfo = (tyGetModuleInfo)DynamicLibraryGetProc(lib, "GetModuleInfo");
+    tyModuleInitialize ModuleInitialize = (tyModuleInitialize)DynamicLibraryGetProc(lib, "ModuleInitialize");
+    tyModuleCleanup ModuleCleanup = (tyModuleCleanup)DynamicLibraryGetProc(lib, "ModuleCleanup");
+    tyCreateCpu CreateCpu = (tyCreateCpu)DynamicLibraryGetProc(lib, "CreateCpu");
+    tyDestroyCpu DestroyCpu = (tyDestroyCpu)DynamicLibraryGetProc(lib, "DestroyCpu");
+    if (GetModuleInfo == nullptr || ModuleInitialize == nullptr || ModuleCleanup == nullptr || CreateCpu == nullptr || DestroyCpu == nullptr)
+    {
+        fprintf(stderr, "%s is not a cpu module\n", options.modulePath.c_str());
+        DynamicLibraryClose(lib);
+        return 1;
+    }
+
+    MODULE_INFO moduleInfo = {0};
+    GetModuleInfo(&moduleInfo);
+    if (moduleInfo.type != MODULE_TYPE_CPU || moduleInfo.version != MODULE_CPU_SPECS_VERSION)
+    {
+        fprintf(stderr, "%s has an unsupported module version\n", options.modulePath.c_str());
+        DynamicLibraryClose(lib);
+        return 1;
+    }
+
+    BenchNotification notification;
+    BenchSettings settings;
+    ModuleInterfaces interfaces = {0};
+    interfaces.notification = &notification;
+    interfaces.settings = &settings;
+    if (ModuleInitialize(interfaces) != 0)
+    {
+        fprintf(stderr, "Failed to initialize %s\n", moduleInfo.name);
+        DynamicLibraryClose(lib);
+        return 1;
+    }
+
+    ICpu * cpu = nullptr;
+    BenchSystem system(cpu);
+    cpu = CreateCpu(system);
+    int exitCode = 1;
+    if (cpu != nullptr && cpu->Initialize())
+    {
+        BenchMemory memory(BENCH_MEMORY_SIZE, options.usePageTable);
+        IExclusiveMonitor * monitor = cpu->CreateExclusiveMonitor(memory, 1);
+
+        printf("Module: %s (%s)\n", moduleInfo.name, options.modulePath.c_str());
+        printf("Iterations: %llu, page table: %s\n\n", (unsigned long long)options.iterations, options.usePageTable ? "yes" : "no");
+        printf("%-10s %12s %10s %12s %12s %10s %8s %10s %s\n", "kernel", "time (ms)", "MIPS", "mem reads", "mem writes", "svcs", "blocks", "jit (ms)", "cache (KB)");
+
+        uint32_t kernelCount;
+        const BenchKernel * kernels = BenchKernels(kernelCount);
+        exitCode = 0;
+        for (uint32_t i = 0; i < kernelCount; i++)
+        {
+            if (!options.kernel.empty() && options.kernel != kernels[i].name)
+            {
+                continue;
+            }
+            BenchResult result = {0};
+            if (!RunKernel(*cpu, monitor, memory, kernels[i], options.iterations, result))
+            {
+                fprintf(stderr, "Failed to create executor for %s\n", kernels[i].name);
+                exitCode = 1;
+                break;
+            }
+            PrintResult(kernels[i], result);
+        }
+        cpu->DestroyExclusiveMonitor(monitor);
+    }
+    else
+    {
+        fprintf(stderr, "Failed to create cpu from %s\n", moduleInfo.name);
+    }
+
+    if (cpu != nullptr)
+    {
+        DestroyCpu(cpu);
+    }
+    ModuleCleanup();
+    DynamicLibraryClose(lib);
+    return exitCode;
+}
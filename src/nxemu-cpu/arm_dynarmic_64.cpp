@@ -1,31 +1,68 @@
 #include "arm_dynarmic_64.h"
+#include "atomic_ops.h"
+#include "translation_cache.h"
 #include "dynarmic/interface/exclusive_monitor.h"
 #include <common/maths.h>
+#include <string.h>
 
 extern IModuleNotification * g_notify;
 
-ArmDynarmic64::ArmDynarmic64(Dynarmic::ExclusiveMonitor * monitor, ISwitchSystem & System, ICpuInfo & CpuInfo, uint32_t coreIndex) :
+ArmDynarmic64::ArmDynarmic64(Dynarmic::ExclusiveMonitor * monitor, ISwitchSystem & System, ICpuInfo & CpuInfo, uint32_t coreIndex, bool usesWallClock, TranslationCache * translationCache, BlockProfiler * blockProfiler) :
     m_jit(nullptr),
     m_system(System),
     m_CpuInfo(CpuInfo),
     m_OperatingSystem(System.OperatingSystem()),
+    m_memory(CpuInfo.Memory()),
     m_monitor(monitor),
-    m_coreIndex(coreIndex)
+    m_translationCache(translationCache),
+    m_blockProfiler(blockProfiler),
+    m_profilerExecutor(nullptr),
+    m_coreIndex(coreIndex),
+    m_usesWallClock(usesWallClock)
 {
     m_jit = MakeJit(monitor);
     m_reg.SetJit(m_jit.get());
+    if (m_blockProfiler != nullptr)
+    {
+        m_profilerExecutor = m_blockProfiler->AddExecutor(*m_jit);
+    }
+}
+
+ArmDynarmic64::~ArmDynarmic64()
+{
+    if (m_profilerExecutor != nullptr)
+    {
+        m_blockProfiler->RemoveExecutor(m_profilerExecutor);
+        m_profilerExecutor = nullptr;
+    }
 }
 
 IArm64Executor::HaltReason ArmDynarmic64::Execute()
 {
     m_jit->ClearExclusiveState();
+    if (m_profilerExecutor != nullptr)
+    {
+        m_blockProfiler->ExecutionStarting(m_profilerExecutor);
+    }
     Dynarmic::HaltReason Reason = m_jit->Run(); 
-    switch (Reason)
+    if (m_profilerExecutor != nullptr)
     {
-    case Dynarmic::HaltReason::UserDefined3: return IArm64Executor::HaltReason::SupervisorCall;
+        m_blockProfiler->ExecutionStopped(m_profilerExecutor);
+    }
+    // An interrupt can arrive while a supervisor call is halting, the svc has to be serviced and the
+    // operating system still sees its own pending interrupt once the call returns
+    if (Dynarmic::Has(Reason, Dynarmic::HaltReason::UserDefined3))
+    {
+        return IArm64Executor::HaltReason::SupervisorCall;
+    }
+    if (Dynarmic::Has(Reason, Dynarmic::HaltReason::UserDefined2))
+    {
+        return IArm64Executor::HaltReason::BreakLoop;
+    }
+    if (Dynarmic::Has(Reason, ~Dynarmic::HaltReason::CacheInvalidation))
+    {
+        g_notify->BreakPoint(__FILE__, __LINE__);
     }
-
-    g_notify->BreakPoint(__FILE__, __LINE__);
     return HaltReason::Stopped;
 }
 
@@ -39,26 +76,89 @@ void ArmDynarmic64::HaltExecution(HaltReason hr)
     switch (hr)
     {
     case HaltReason::SupervisorCall: m_jit->HaltExecution(Dynarmic::HaltReason::UserDefined3); break;
+    case HaltReason::BreakLoop: m_jit->HaltExecution(Dynarmic::HaltReason::UserDefined2); break;
     default:
         g_notify->BreakPoint(__FILE__, __LINE__);
     }
 }
 
+void ArmDynarmic64::GetContext(Arm64ThreadContext & ctx)
+{
+    const std::array<std::uint64_t, 31> regs = m_jit->GetRegisters();
+    const std::array<Dynarmic::A64::Vector, 32> vectors = m_jit->GetVectors();
+    static_assert(sizeof(ctx.r) == sizeof(regs) && sizeof(ctx.v) == sizeof(vectors));
+
+    memcpy(ctx.r, regs.data(), sizeof(ctx.r));
+    ctx.sp = m_jit->GetSP();
+    ctx.pc = m_jit->GetPC();
+    ctx.pstate = m_jit->GetPstate();
+    memcpy(ctx.v, vectors.data(), sizeof(ctx.v));
+    ctx.fpcr = m_jit->GetFpcr();
+    ctx.fpsr = m_jit->GetFpsr();
+    ctx.tpidr = m_reg.m_tpidr_el0;
+}
+
+void ArmDynarmic64::SetContext(const Arm64ThreadContext & ctx)
+{
+    std::array<std::uint64_t, 31> regs;
+    std::array<Dynarmic::A64::Vector, 32> vectors;
+    memcpy(regs.data(), ctx.r, sizeof(ctx.r));
+    memcpy(vectors.data(), ctx.v, sizeof(ctx.v));
+
+    m_jit->SetRegisters(regs);
+    m_jit->SetSP(ctx.sp);
+    m_jit->SetPC(ctx.pc);
+    m_jit->SetPstate(ctx.pstate);
+    m_jit->SetVectors(vectors);
+    m_jit->SetFpcr(ctx.fpcr);
+    m_jit->SetFpsr(ctx.fpsr);
+    m_reg.m_tpidr_el0 = ctx.tpidr;
+}
+
+void ArmDynarmic64::GetSvcArguments(Arm64SvcArguments & args)
+{
+    for (size_t i = 0; i < 8; i++)
+    {
+        args.x[i] = m_jit->GetRegister(i);
+    }
+}
+
+void ArmDynarmic64::SetSvcArguments(const Arm64SvcArguments & args)
+{
+    for (size_t i = 0; i < 8; i++)
+    {
+        m_jit->SetRegister(i, args.x[i]);
+    }
+}
+
+void ArmDynarmic64::GetJitStatistics(Arm64JitStatistics & stats)
+{
+    Dynarmic::A64::Jit::CompilationStatistics statistics = m_jit->GetCompilationStatistics();
+    stats.blocksCompiled = statistics.blocks_compiled;
+    stats.compileTimeNs = statistics.compile_time_ns;
+    stats.codeCacheUsed = statistics.code_cache_used;
+    stats.codeCacheSize = statistics.code_cache_size;
+}
+
 std::unique_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Dynarmic::ExclusiveMonitor * monitor)
 {
     Dynarmic::A64::UserConfig config;
     config.callbacks = this;
-    config.page_table = nullptr; // reinterpret_cast<void **>(page_table->pointers.data());
-    config.page_table_address_space_bits = 27; //address_space_bits;
-    config.page_table_pointer_mask_bits = 2;   // Common::PageTable::ATTRIBUTE_BITS;
+
+    // Page table, pages without a host pointer use the memory callbacks
+    config.page_table = m_memory.PageTablePointers();
+    config.page_table_address_space_bits = m_memory.PageTableAddressSpaceBits();
+    config.page_table_pointer_mask_bits = m_memory.PageTableAttributeBits();
     config.silently_mirror_page_table = false;
     config.absolute_offset_page_table = true;
     config.detect_misaligned_access_via_page_table = 16 | 32 | 64 | 128;
     config.only_detect_misalignment_via_page_table_on_page_boundary = true;
 
-    config.fastmem_pointer = nullptr; //page_table->fastmem_arena;
-    config.fastmem_address_space_bits = 27; //address_space_bits;
+    // Fastmem, faulting blocks are recompiled to use the page table
+    config.fastmem_pointer = m_memory.FastmemArena();
+    config.fastmem_address_space_bits = config.page_table_address_space_bits;
     config.silently_mirror_fastmem = false;
+    config.recompile_on_fastmem_failure = true;
 
     config.fastmem_exclusive_access = config.fastmem_pointer != nullptr;
     config.recompile_on_exclusive_fastmem_failure = true;
@@ -76,14 +176,26 @@ std::unique_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Dynarmic::ExclusiveMo
     config.define_unpredictable_behaviour = true;
 
     // Timing
-    config.wall_clock_cntpct = true; //m_uses_wall_clock;
-    config.enable_cycle_counting = false; //!m_uses_wall_clock;
+    config.wall_clock_cntpct = m_usesWallClock;
+    config.enable_cycle_counting = !m_usesWallClock;
+
+    // Profiling
+    config.enable_block_profiling = m_blockProfiler != nullptr;
 
     // Code cache size
     config.code_cache_size = 0x20000000;
+
+    // Persistent translation cache
+    config.translation_cache = m_translationCache;
     return std::make_unique<Dynarmic::A64::Jit>(config);
 }
 
+template <typename T>
+bool ArmDynarmic64::WriteExclusive(uint64_t vaddr, T value, T expected)
+{
+    return ExclusiveCompareAndSwap(m_memory, vaddr, value, expected);
+}
+
 std::uint8_t ArmDynarmic64::MemoryRead8(std::uint64_t vaddr)
 {
     uint8_t Value;
@@ -159,32 +271,29 @@ void ArmDynarmic64::MemoryWrite128(std::uint64_t vaddr, Dynarmic::A64::Vector va
     m_CpuInfo.WriteMemory(vaddr, (const uint8_t *)&value, sizeof(value));
 }
 
-bool ArmDynarmic64::MemoryWriteExclusive8(std::uint64_t /*vaddr*/, std::uint8_t /*value*/, std::uint8_t /*expected*/)
+bool ArmDynarmic64::MemoryWriteExclusive8(std::uint64_t vaddr, std::uint8_t value, std::uint8_t expected)
 {
-    g_notify->BreakPoint(__FILE__, __LINE__);
-    return false;
+    return WriteExclusive(vaddr, value, expected);
 }
 
-bool ArmDynarmic64::MemoryWriteExclusive16(std::uint64_t /*vaddr*/, std::uint16_t /*value*/, std::uint16_t /*expected*/)
+bool ArmDynarmic64::MemoryWriteExclusive16(std::uint64_t vaddr, std::uint16_t value, std::uint16_t expected)
 {
-    g_notify->BreakPoint(__FILE__, __LINE__);
-    return false;
+    return WriteExclusive(vaddr, value, expected);
 }
 
-bool ArmDynarmic64::MemoryWriteExclusive32(std::uint64_t vaddr, std::uint32_t value, std::uint32_t /*expected*/)
+bool ArmDynarmic64::MemoryWriteExclusive32(std::uint64_t vaddr, std::uint32_t value, std::uint32_t expected)
 {
-    return m_CpuInfo.WriteMemory(vaddr, (const uint8_t *)&value, sizeof(value));
+    return WriteExclusive(vaddr, value, expected);
 }
 
-bool ArmDynarmic64::MemoryWriteExclusive64(std::uint64_t vaddr, std::uint64_t value, std::uint64_t /*expected*/)
+bool ArmDynarmic64::MemoryWriteExclusive64(std::uint64_t vaddr, std::uint64_t value, std::uint64_t expected)
 {
-    return m_CpuInfo.WriteMemory(vaddr, (const uint8_t *)&value, sizeof(value));
+    return WriteExclusive(vaddr, value, expected);
 }
 
-bool ArmDynarmic64::MemoryWriteExclusive128(std::uint64_t /*vaddr*/, Dynarmic::A64::Vector /*value*/, Dynarmic::A64::Vector /*expected*/)
+bool ArmDynarmic64::MemoryWriteExclusive128(std::uint64_t vaddr, Dynarmic::A64::Vector value, Dynarmic::A64::Vector expected)
 {
-    g_notify->BreakPoint(__FILE__, __LINE__);
-    return false;
+    return WriteExclusive(vaddr, value, expected);
 }
 
 bool ArmDynarmic64::IsReadOnlyMemory(std::uint64_t /*vaddr*/)
@@ -223,15 +332,14 @@ void ArmDynarmic64::InstructionSynchronizationBarrierRaised()
     g_notify->BreakPoint(__FILE__, __LINE__);
 }
 
-void ArmDynarmic64::AddTicks(std::uint64_t /*ticks*/)
+void ArmDynarmic64::AddTicks(std::uint64_t ticks)
 {
-    g_notify->BreakPoint(__FILE__, __LINE__);
+    m_CpuInfo.AddTicks(ticks);
 }
 
 std::uint64_t ArmDynarmic64::GetTicksRemaining()
 {
-    g_notify->BreakPoint(__FILE__, __LINE__);
-    return 0;
+    return m_CpuInfo.GetTicksRemaining();
 }
 
 std::uint64_t ArmDynarmic64::GetCNTPCT()
@@ -1,6 +1,7 @@
 #pragma once
 #include "dynarmic/interface/A64/a64.h"
 #include "arm64_registers.h"
+#include "block_profiler.h"
 #include "cpu_manager.h"
 
 class ArmDynarmic64 :
@@ -8,7 +9,8 @@ class ArmDynarmic64 :
     private Dynarmic::A64::UserCallbacks
 {
 public:
-    ArmDynarmic64(Dynarmic::ExclusiveMonitor * monitor, ISwitchSystem & System, ICpuInfo & CpuInfo, uint32_t coreIndex);
+    ArmDynarmic64(Dynarmic::ExclusiveMonitor * monitor, ISwitchSystem & System, ICpuInfo & CpuInfo, uint32_t coreIndex, bool usesWallClock, TranslationCache * translationCache, BlockProfiler * blockProfiler);
+    ~ArmDynarmic64();
 
     IArm64Reg & Reg(void) { return m_reg; }
 
@@ -16,6 +18,11 @@ public:
     HaltReason Execute(void);
     void InvalidateCacheRange(uint64_t addr, uint64_t size);
     void HaltExecution(HaltReason hr);
+    void GetContext(Arm64ThreadContext & ctx);
+    void SetContext(const Arm64ThreadContext & ctx);
+    void GetSvcArguments(Arm64SvcArguments & args);
+    void SetSvcArguments(const Arm64SvcArguments & args);
+    void GetJitStatistics(Arm64JitStatistics & stats);
 
 private:
     ArmDynarmic64() = delete;
@@ -23,6 +30,8 @@ private:
     ArmDynarmic64 & operator=(const ArmDynarmic64 &) = delete;
 
     std::unique_ptr<Dynarmic::A64::Jit> MakeJit(Dynarmic::ExclusiveMonitor * monitor);
+    template <typename T>
+    bool WriteExclusive(uint64_t vaddr, T value, T expected);
 
     //Dynarmic::A64::UserCallbacks
     std::uint8_t MemoryRead8(std::uint64_t vaddr);
@@ -35,11 +44,11 @@ private:
     void MemoryWrite32(std::uint64_t vaddr, std::uint32_t value);
     void MemoryWrite64(std::uint64_t vaddr, std::uint64_t value);
     void MemoryWrite128(std::uint64_t vaddr, Dynarmic::A64::Vector value);
-    bool MemoryWriteExclusive8(std::uint64_t /*vaddr*/, std::uint8_t /*value*/, std::uint8_t /*expected*/);
-    bool MemoryWriteExclusive16(std::uint64_t /*vaddr*/, std::uint16_t /*value*/, std::uint16_t /*expected*/);
-    bool MemoryWriteExclusive32(std::uint64_t /*vaddr*/, std::uint32_t /*value*/, std::uint32_t /*expected*/);
-    bool MemoryWriteExclusive64(std::uint64_t /*vaddr*/, std::uint64_t /*value*/, std::uint64_t /*expected*/);
-    bool MemoryWriteExclusive128(std::uint64_t /*vaddr*/, Dynarmic::A64::Vector /*value*/, Dynarmic::A64::Vector /*expected*/);
+    bool MemoryWriteExclusive8(std::uint64_t vaddr, std::uint8_t value, std::uint8_t expected);
+    bool MemoryWriteExclusive16(std::uint64_t vaddr, std::uint16_t value, std::uint16_t expected);
+    bool MemoryWriteExclusive32(std::uint64_t vaddr, std::uint32_t value, std::uint32_t expected);
+    bool MemoryWriteExclusive64(std::uint64_t vaddr, std::uint64_t value, std::uint64_t expected);
+    bool MemoryWriteExclusive128(std::uint64_t vaddr, Dynarmic::A64::Vector value, Dynarmic::A64::Vector expected);
     bool IsReadOnlyMemory(std::uint64_t /*vaddr*/);
     void InterpreterFallback(std::uint64_t pc, size_t num_instructions);
     void CallSVC(std::uint32_t swi);
@@ -55,7 +64,12 @@ private:
     ISwitchSystem & m_system;
     ICpuInfo & m_CpuInfo;
     IOperatingSystem & m_OperatingSystem;
+    IMemory & m_memory;
     Dynarmic::ExclusiveMonitor * m_monitor;
+    TranslationCache * m_translationCache;
+    BlockProfiler * m_blockProfiler;
+    BlockProfiler::Executor * m_profilerExecutor;
     A64Registers m_reg;
     uint32_t m_coreIndex;
+    bool m_usesWallClock;
 };
@@ -0,0 +1,73 @@
+#pragma once
+#include <nxemu-module-spec/cpu.h>
+#include "dynarmic/interface/A64/config.h"
+#include <stdint.h>
+
+#if _MSC_VER
+#include <intrin.h>
+#else
+#include <cstring>
+#endif
+
+#if _MSC_VER
+
+inline bool AtomicCompareAndSwap(uint8_t * pointer, uint8_t value, uint8_t expected)
+{
+    return (uint8_t)_InterlockedCompareExchange8((volatile char *)pointer, value, expected) == expected;
+}
+
+inline bool AtomicCompareAndSwap(uint16_t * pointer, uint16_t value, uint16_t expected)
+{
+    return (uint16_t)_InterlockedCompareExchange16((volatile short *)pointer, value, expected) == expected;
+}
+
+inline bool AtomicCompareAndSwap(uint32_t * pointer, uint32_t value, uint32_t expected)
+{
+    return (uint32_t)_InterlockedCompareExchange((volatile long *)pointer, value, expected) == expected;
+}
+
+inline bool AtomicCompareAndSwap(uint64_t * pointer, uint64_t value, uint64_t expected)
+{
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)pointer, value, expected) == expected;
+}
+
+inline bool AtomicCompareAndSwap(Dynarmic::A64::Vector * pointer, Dynarmic::A64::Vector value, Dynarmic::A64::Vector expected)
+{
+    return _InterlockedCompareExchange128((volatile __int64 *)pointer, value[1], value[0], (__int64 *)expected.data()) != 0;
+}
+
+#else
+
+template <typename T>
+inline bool AtomicCompareAndSwap(T * pointer, T value, T expected)
+{
+    return __sync_bool_compare_and_swap(pointer, expected, value);
+}
+
+inline bool AtomicCompareAndSwap(Dynarmic::A64::Vector * pointer, Dynarmic::A64::Vector value, Dynarmic::A64::Vector expected)
+{
+    unsigned __int128 value128, expected128;
+    std::memcpy(&value128, value.data(), sizeof(value128));
+    std::memcpy(&expected128, expected.data(), sizeof(expected128));
+    return __sync_bool_compare_and_swap((unsigned __int128 *)pointer, expected128, value128);
+}
+
+#endif
+
+// Exclusive store for both the global monitor and the JIT callbacks. The store goes straight to
+// host memory, so any copy the GPU cached of it is stale once the swap succeeds
+template <typename T>
+inline bool ExclusiveCompareAndSwap(IMemory & memory, uint64_t vaddr, T value, T expected)
+{
+    uint8_t * ptr = memory.GetPointerSilent(vaddr);
+    if (ptr == nullptr)
+    {
+        return true;
+    }
+    if (!AtomicCompareAndSwap((T *)ptr, value, expected))
+    {
+        return false;
+    }
+    memory.InvalidateRegion(vaddr, sizeof(T));
+    return true;
+}
@@ -0,0 +1,232 @@
+#include "block_profiler.h"
+#include <Windows.h>
+#include <algorithm>
+
+namespace
+{
+const uint32_t SAMPLE_INTERVAL_MS = 1;
+const size_t SAMPLES_BEFORE_RESOLVE = 4096;
+} // namespace
+
+BlockProfiler::BlockProfiler() :
+    m_stopSampling(false)
+{
+    m_sampleThread = std::thread(&BlockProfiler::SampleThread, this);
+}
+
+BlockProfiler::~BlockProfiler()
+{
+    m_stopSampling = true;
+    m_sampleThread.join();
+
+    for (std::unique_ptr<Executor> & executor : m_executors)
+    {
+        if (executor->thread != nullptr)
+        {
+            CloseHandle(executor->thread);
+        }
+    }
+}
+
+BlockProfiler::Executor * BlockProfiler::AddExecutor(const Dynarmic::A64::Jit & jit)
+{
+    std::unique_ptr<Executor> executor = std::make_unique<Executor>();
+    executor->jit = &jit;
+    executor->thread = nullptr;
+    executor->threadId = 0;
+    executor->executing = false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_executors.push_back(std::move(executor));
+    return m_executors.back().get();
+}
+
+void BlockProfiler::RemoveExecutor(Executor * executor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::vector<std::unique_ptr<Executor>>::iterator itr = m_executors.begin(); itr != m_executors.end(); itr++)
+    {
+        if (itr->get() != executor)
+        {
+            continue;
+        }
+        // Keep the counts of the executor's blocks after its JIT is gone
+        ResolveSamples(*executor);
+        AddHitCounts(*executor, m_blocks);
+        if (executor->thread != nullptr)
+        {
+            CloseHandle(executor->thread);
+        }
+        m_executors.erase(itr);
+        break;
+    }
+}
+
+void BlockProfiler::ExecutionStarting(Executor * executor)
+{
+    // Executors can be driven from different host threads, the sampler needs a handle to whichever is current
+    uint32_t threadId = GetCurrentThreadId();
+    if (executor->threadId != threadId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (executor->thread != nullptr)
+        {
+            CloseHandle(executor->thread);
+        }
+        HANDLE thread = nullptr;
+        if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &thread, THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, 0))
+        {
+            thread = nullptr;
+        }
+        executor->thread = thread;
+        executor->threadId = threadId;
+    }
+    executor->executing = true;
+}
+
+void BlockProfiler::ExecutionStopped(Executor * executor)
+{
+    executor->executing = false;
+}
+
+void BlockProfiler::ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress)
+{
+    LoadedModule loadedModule;
+    loadedModule.startAddress = baseAddress;
+    loadedModule.endAddress = baseAddress + module.DataSegmentAddr() + module.DataSegmentSize();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_modules.push_back(loadedModule);
+}
+
+uint32_t BlockProfiler::GetBlockProfile(CpuBlockProfile * blocks, uint32_t maxCount)
+{
+    std::vector<CpuBlockProfile> profile;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::unique_ptr<Executor> & executor : m_executors)
+        {
+            ResolveSamples(*executor);
+        }
+        BlockInfoMap blockInfo = m_blocks;
+        for (const std::unique_ptr<Executor> & executor : m_executors)
+        {
+            AddHitCounts(*executor, blockInfo);
+        }
+
+        profile.reserve(blockInfo.size());
+        for (BlockInfoMap::const_iterator itr = blockInfo.begin(); itr != blockInfo.end(); itr++)
+        {
+            CpuBlockProfile block = {0};
+            block.guestAddress = itr->first;
+            block.moduleOffset = itr->first;
+            block.moduleIndex = -1;
+            block.hitCount = itr->second.hitCount;
+            block.samples = itr->second.samples;
+            block.hostBytes = itr->second.hostBytes;
+            for (size_t i = 0, n = m_modules.size(); i < n; i++)
+            {
+                if (itr->first >= m_modules[i].startAddress && itr->first < m_modules[i].endAddress)
+                {
+                    block.moduleIndex = (int32_t)i;
+                    block.moduleOffset = itr->first - m_modules[i].startAddress;
+                    break;
+                }
+            }
+            profile.push_back(block);
+        }
+    }
+
+    std::sort(profile.begin(), profile.end(), [](const CpuBlockProfile & a, const CpuBlockProfile & b) {
+        if (a.samples != b.samples)
+        {
+            return a.samples > b.samples;
+        }
+        if (a.hitCount != b.hitCount)
+        {
+            return a.hitCount > b.hitCount;
+        }
+        return a.guestAddress < b.guestAddress;
+    });
+
+    uint32_t count = (uint32_t)std::min<size_t>(profile.size(), maxCount);
+    std::copy(profile.begin(), profile.begin() + count, blocks);
+    return (uint32_t)profile.size();
+}
+
+void BlockProfiler::SampleThread(void)
+{
+    while (!m_stopSampling)
+    {
+        Sleep(SAMPLE_INTERVAL_MS);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::unique_ptr<Executor> & executor : m_executors)
+        {
+            if (!executor->executing || executor->thread == nullptr)
+            {
+                continue;
+            }
+            if (SuspendThread(executor->thread) == (DWORD)-1)
+            {
+                continue;
+            }
+            CONTEXT context = {0};
+            context.ContextFlags = CONTEXT_CONTROL;
+            BOOL validContext = GetThreadContext(executor->thread, &context);
+            ResumeThread(executor->thread);
+
+            // Only record once the thread is running again, it may have been suspended holding the heap lock
+            if (validContext)
+            {
+                executor->hostSamples.push_back(context.Rip);
+            }
+            if (executor->hostSamples.size() >= SAMPLES_BEFORE_RESOLVE)
+            {
+                ResolveSamples(*executor);
+            }
+        }
+    }
+}
+
+void BlockProfiler::ResolveSamples(Executor & executor)
+{
+    if (executor.hostSamples.empty())
+    {
+        return;
+    }
+
+    std::vector<Dynarmic::A64::Jit::BlockProfile> jitBlocks = executor.jit->GetBlockProfile();
+    jitBlocks.erase(std::remove_if(jitBlocks.begin(), jitBlocks.end(), [](const Dynarmic::A64::Jit::BlockProfile & block) { return block.host_code == nullptr; }), jitBlocks.end());
+    std::sort(jitBlocks.begin(), jitBlocks.end(), [](const Dynarmic::A64::Jit::BlockProfile & a, const Dynarmic::A64::Jit::BlockProfile & b) { return a.host_code < b.host_code; });
+
+    // Samples outside emitted blocks (dispatcher, memory callbacks, svc handling) are not attributed
+    for (uint64_t hostAddress : executor.hostSamples)
+    {
+        const void * hostCode = (const void *)hostAddress;
+        std::vector<Dynarmic::A64::Jit::BlockProfile>::const_iterator itr = std::upper_bound(jitBlocks.begin(), jitBlocks.end(), hostCode, [](const void * code, const Dynarmic::A64::Jit::BlockProfile & block) { return code < block.host_code; });
+        if (itr == jitBlocks.begin())
+        {
+            continue;
+        }
+        itr--;
+        if (hostAddress - (uint64_t)itr->host_code < itr->host_size)
+        {
+            m_blocks[itr->pc].samples += 1;
+        }
+    }
+    executor.hostSamples.clear();
+}
+
+void BlockProfiler::AddHitCounts(const Executor & executor, BlockInfoMap & blocks)
+{
+    for (const Dynarmic::A64::Jit::BlockProfile & jitBlock : executor.jit->GetBlockProfile())
+    {
+        BlockInfo & block = blocks[jitBlock.pc];
+        block.hitCount += jitBlock.hit_count;
+        if (jitBlock.host_size > block.hostBytes)
+        {
+            block.hostBytes = (uint32_t)jitBlock.host_size;
+        }
+    }
+}
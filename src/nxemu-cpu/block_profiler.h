@@ -0,0 +1,65 @@
+#pragma once
+#include <nxemu-module-spec/cpu.h>
+#include "dynarmic/interface/A64/a64.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Collects the per block execution counts from each executor's JIT and attributes host time to
+// guest blocks by periodically sampling the instruction pointer of threads running JIT code.
+class BlockProfiler
+{
+    struct BlockInfo
+    {
+        uint64_t hitCount;
+        uint64_t samples;
+        uint32_t hostBytes;
+    };
+
+    struct LoadedModule
+    {
+        uint64_t startAddress;
+        uint64_t endAddress;
+    };
+
+    typedef std::unordered_map<uint64_t, BlockInfo> BlockInfoMap;
+    typedef std::vector<LoadedModule> LoadedModules;
+
+public:
+    struct Executor
+    {
+        const Dynarmic::A64::Jit * jit;
+        void * thread;
+        uint32_t threadId;
+        std::atomic<bool> executing;
+        std::vector<uint64_t> hostSamples;
+    };
+
+    BlockProfiler();
+    ~BlockProfiler();
+
+    Executor * AddExecutor(const Dynarmic::A64::Jit & jit);
+    void RemoveExecutor(Executor * executor);
+    void ExecutionStarting(Executor * executor);
+    void ExecutionStopped(Executor * executor);
+    void ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress);
+    uint32_t GetBlockProfile(CpuBlockProfile * blocks, uint32_t maxCount);
+
+private:
+    BlockProfiler(const BlockProfiler &) = delete;
+    BlockProfiler & operator=(const BlockProfiler &) = delete;
+
+    void SampleThread(void);
+    void ResolveSamples(Executor & executor);
+    static void AddHitCounts(const Executor & executor, BlockInfoMap & blocks);
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Executor>> m_executors;
+    BlockInfoMap m_blocks;
+    LoadedModules m_modules;
+    std::atomic<bool> m_stopSampling;
+    std::thread m_sampleThread;
+};
@@ -1,6 +1,11 @@
 #include "cpu_manager.h"
 #include "arm_dynarmic_64.h"
+#include "block_profiler.h"
 #include "exclusive_monitor_interface.h"
+#include "translation_cache.h"
+#include <nxemu-core/settings/identifiers.h>
+
+extern IModuleSettings * g_settings;
 
 CpuManager::CpuManager(ISwitchSystem & system) :
     m_system(system)
@@ -13,6 +18,14 @@ CpuManager::~CpuManager()
 
 bool CpuManager::Initialize(void)
 {
+    if (g_settings->GetBool(NXCoreSetting::JitTranslationCache))
+    {
+        m_translationCache = std::make_unique<TranslationCache>();
+    }
+    if (g_settings->GetBool(NXCoreSetting::JitBlockProfiling))
+    {
+        m_blockProfiler = std::make_unique<BlockProfiler>();
+    }
     return true;
 }
 
@@ -34,12 +47,41 @@ void CpuManager::DestroyExclusiveMonitor(IExclusiveMonitor * monitor)
     }
 }
 
-IArm64Executor * CpuManager::CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex)
+IArm64Executor * CpuManager::CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex, bool usesWallClock)
 {
-    return new ArmDynarmic64(monitor == m_exclusiveMonitor.get() ? m_exclusiveMonitor.get() : nullptr, m_system, info, coreIndex);
+    return new ArmDynarmic64(monitor == m_exclusiveMonitor.get() ? m_exclusiveMonitor.get() : nullptr, m_system, info, coreIndex, usesWallClock, m_translationCache.get(), m_blockProfiler.get());
 }
 
 void CpuManager::DestroyArm64Executor(IArm64Executor * executor)
 {
     delete (ArmDynarmic64 *)executor;
 }
+
+void CpuManager::ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress)
+{
+    if (m_translationCache)
+    {
+        m_translationCache->ModuleLoaded(module, baseAddress);
+    }
+    if (m_blockProfiler)
+    {
+        m_blockProfiler->ModuleLoaded(module, baseAddress);
+    }
+}
+
+void CpuManager::EmulationStopping(void)
+{
+    if (m_translationCache)
+    {
+        m_translationCache->Save();
+    }
+}
+
+uint32_t CpuManager::GetBlockProfile(CpuBlockProfile * blocks, uint32_t maxCount)
+{
+    if (!m_blockProfiler)
+    {
+        return 0;
+    }
+    return m_blockProfiler->GetBlockProfile(blocks, maxCount);
+}
@@ -2,7 +2,9 @@
 #include <nxemu-module-spec/cpu.h>
 #include <memory>
 
+class BlockProfiler;
 class ExclusiveMonitor;
+class TranslationCache;
 
 class CpuManager :
     public ICpu
@@ -15,8 +17,12 @@ public:
     bool Initialize(void);
     IExclusiveMonitor * CreateExclusiveMonitor(IMemory & memory, uint32_t processorCount);
     void DestroyExclusiveMonitor(IExclusiveMonitor * monitor);
-    IArm64Executor * CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex);
+    IArm64Executor * CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex, bool usesWallClock);
     void DestroyArm64Executor(IArm64Executor * executor);
+    void ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress);
+    uint32_t GetBlockProfile(CpuBlockProfile * blocks, uint32_t maxCount);
+
+    void EmulationStopping(void);
 
 private:
     CpuManager() = delete;
@@ -24,5 +30,7 @@ private:
     CpuManager & operator=(const CpuManager &) = delete;
 
     std::unique_ptr<ExclusiveMonitor> m_exclusiveMonitor;
+    std::unique_ptr<TranslationCache> m_translationCache;
+    std::unique_ptr<BlockProfiler> m_blockProfiler;
     ISwitchSystem & m_system;
 };
@@ -92,6 +92,17 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) {
     code.align();
     const u8* const entrypoint = code.getCurr();
 
+    if (conf.enable_block_profiling) {
+        u64* hit_count;
+        {
+            std::lock_guard lock{block_profile_mutex};
+            hit_count = &block_profiles[block.Location().Value()].hit_count;
+        }
+        // No guest state is held in host registers on block entry
+        code.mov(rax, reinterpret_cast<u64>(hit_count));
+        code.inc(qword[rax]);
+    }
+
     ASSERT(block.GetCondition() == IR::Cond::AL);
 
     for (auto iter = block.begin(); iter != block.end(); ++iter) {
@@ -146,6 +157,13 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) {
     const auto range = boost::icl::discrete_interval<u64>::closed(descriptor.PC(), end_location.PC() - 1);
     block_ranges.AddRange(range, descriptor);
 
+    if (conf.enable_block_profiling) {
+        std::lock_guard lock{block_profile_mutex};
+        BlockProfileInfo& profile = block_profiles[descriptor.UniqueHash()];
+        profile.entrypoint = entrypoint;
+        profile.size = size;
+    }
+
     return RegisterBlock(descriptor, entrypoint, size);
 }
 
@@ -154,10 +172,51 @@ void A64EmitX64::ClearCache() {
     block_ranges.ClearCache();
     ClearFastDispatchTable();
     fastmem_patch_info.clear();
+
+    if (conf.enable_block_profiling) {
+        std::lock_guard lock{block_profile_mutex};
+        for (auto& [location, profile] : block_profiles) {
+            profile.entrypoint = nullptr;
+            profile.size = 0;
+        }
+    }
 }
 
 void A64EmitX64::InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges) {
-    InvalidateBasicBlocks(block_ranges.InvalidateRanges(ranges));
+    const auto locations = block_ranges.InvalidateRanges(ranges);
+    ClearBlockProfileCode(locations);
+    InvalidateBasicBlocks(locations);
+}
+
+std::vector<A64::Jit::BlockProfile> A64EmitX64::GetBlockProfile() const {
+    std::lock_guard lock{block_profile_mutex};
+
+    std::vector<A64::Jit::BlockProfile> result;
+    result.reserve(block_profiles.size());
+    for (const auto& [location, profile] : block_profiles) {
+        result.push_back(A64::Jit::BlockProfile{
+            .pc = A64::LocationDescriptor{IR::LocationDescriptor{location}}.PC(),
+            .hit_count = profile.hit_count,
+            .host_code = profile.entrypoint,
+            .host_size = profile.size,
+        });
+    }
+    return result;
+}
+
+void A64EmitX64::ClearBlockProfileCode(const tsl::robin_set<IR::LocationDescriptor>& locations) {
+    if (!conf.enable_block_profiling) {
+        return;
+    }
+
+    std::lock_guard lock{block_profile_mutex};
+    for (const auto& location : locations) {
+        const auto iter = block_profiles.find(location.Value());
+        if (iter != block_profiles.end()) {
+            iter->second.entrypoint = nullptr;
+            iter->second.size = 0;
+        }
+    }
 }
 
 void A64EmitX64::ClearFastDispatchTable() {
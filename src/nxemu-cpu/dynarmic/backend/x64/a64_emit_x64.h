@@ -7,8 +7,11 @@
 
 #include <array>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "dynarmic/backend/block_range_information.h"
 #include "dynarmic/backend/x64/a64_jitstate.h"
@@ -51,6 +54,9 @@ public:
 
     void InvalidateCacheRanges(const boost::icl::interval_set<u64>& ranges);
 
+    /// Execution counts of all blocks emitted while block profiling is enabled. Thread-safe.
+    std::vector<A64::Jit::BlockProfile> GetBlockProfile() const;
+
 protected:
     const A64::UserConfig conf;
     A64::Jit* jit_interface;
@@ -94,6 +100,17 @@ protected:
     // Helpers
     std::string LocationDescriptorToFriendlyName(const IR::LocationDescriptor&) const override;
 
+    // Block profiling
+    struct BlockProfileInfo {
+        u64 hit_count = 0;
+        CodePtr entrypoint = nullptr;
+        size_t size = 0;
+    };
+    // Node-based so the counter addresses embedded in emitted code stay valid as blocks are added.
+    std::unordered_map<u64, BlockProfileInfo> block_profiles;
+    mutable std::mutex block_profile_mutex;
+    void ClearBlockProfileCode(const tsl::robin_set<IR::LocationDescriptor>& locations);
+
     // Fastmem information
     using DoNotFastmemMarker = std::tuple<IR::LocationDescriptor, unsigned>;
     struct FastmemPatchInfo {
@@ -3,9 +3,14 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include <boost/icl/interval_set.hpp>
 #include <mcl/assert.hpp>
@@ -23,6 +28,7 @@
 #include "dynarmic/interface/A64/a64.h"
 #include "dynarmic/ir/basic_block.h"
 #include "dynarmic/ir/opt/passes.h"
+#include "dynarmic/ir/serialization.h"
 
 namespace Dynarmic::A64 {
 
@@ -123,6 +129,9 @@ public:
         const auto end_address = static_cast<u64>(start_address + length - 1);
         const auto range = boost::icl::discrete_interval<u64>::closed(start_address, end_address);
         invalid_cache_ranges.add(range);
+        if (conf.translation_cache) {
+            conf.translation_cache->Invalidate(start_address, length);
+        }
         HaltExecution(HaltReason::CacheInvalidation);
     }
 
@@ -228,6 +237,17 @@ public:
         return is_executing;
     }
 
+    CompilationStatistics GetCompilationStatistics() const {
+        CompilationStatistics statistics = compilation_statistics;
+        statistics.code_cache_size = block_of_code.GetTotalCodeSize();
+        statistics.code_cache_used = statistics.code_cache_size - block_of_code.SpaceRemaining();
+        return statistics;
+    }
+
+    std::vector<BlockProfile> GetBlockProfile() const {
+        return emitter.GetBlockProfile();
+    }
+
     void DumpDisassembly() const {
         const size_t size = reinterpret_cast<const char*>(block_of_code.getCurr()) - reinterpret_cast<const char*>(block_of_code.GetCodeBegin());
         Common::DumpDisassembledX64(block_of_code.GetCodeBegin(), size);
@@ -269,6 +289,20 @@ private:
         block_of_code.EnsureMemoryCommitted(MINIMUM_REMAINING_CODESIZE);
 
         // JIT Compile
+        const auto compile_start = std::chrono::steady_clock::now();
+        std::optional<IR::Block> ir_block = LoadCachedBlock(current_location);
+        if (!ir_block) {
+            ir_block = TranslateBlock(current_location);
+            StoreCachedBlock(*ir_block);
+        }
+        const CodePtr entrypoint = emitter.Emit(*ir_block).entrypoint;
+
+        compilation_statistics.blocks_compiled++;
+        compilation_statistics.compile_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - compile_start).count();
+        return entrypoint;
+    }
+
+    IR::Block TranslateBlock(IR::LocationDescriptor current_location) {
         const auto get_code = [this](u64 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
         IR::Block ir_block = A64::Translate(A64::LocationDescriptor{current_location}, get_code,
                                             {conf.define_unpredictable_behaviour, conf.wall_clock_cntpct});
@@ -287,7 +321,107 @@ private:
             Optimization::A64MergeInterpretBlocksPass(ir_block, conf.callbacks);
         }
         Optimization::VerificationPass(ir_block);
-        return emitter.Emit(ir_block).entrypoint;
+        return ir_block;
+    }
+
+    /// Options which influence the output of the frontend and the IR passes
+    u64 TranslationFingerprint() const {
+        u64 fingerprint = static_cast<u64>(conf.optimizations);
+        fingerprint |= u64{conf.unsafe_optimizations} << 32;
+        fingerprint |= u64{conf.define_unpredictable_behaviour} << 33;
+        fingerprint |= u64{conf.wall_clock_cntpct} << 34;
+        fingerprint |= u64{conf.check_halt_on_memory_access} << 35;
+        fingerprint |= u64{conf.hook_data_cache_operations} << 36;
+        fingerprint |= u64{conf.dczid_el0 & 0b1111} << 40;
+        fingerprint |= u64{polyfill_options.sha256} << 44;
+        fingerprint |= u64{polyfill_options.vector_multiply_widen} << 45;
+        return fingerprint;
+    }
+
+    // Translation cache entry layout: u64 translation fingerprint, u32 instruction count,
+    // the guest instruction words the block was translated from, then the serialized IR.
+    std::optional<IR::Block> LoadCachedBlock(IR::LocationDescriptor current_location) {
+        if (!conf.translation_cache) {
+            return std::nullopt;
+        }
+
+        std::vector<u8> data;
+        if (!conf.translation_cache->Load(current_location.Value(), data)) {
+            return std::nullopt;
+        }
+
+        u64 fingerprint;
+        u32 word_count;
+        if (data.size() < sizeof(fingerprint) + sizeof(word_count)) {
+            return std::nullopt;
+        }
+        std::memcpy(&fingerprint, data.data(), sizeof(fingerprint));
+        std::memcpy(&word_count, data.data() + sizeof(fingerprint), sizeof(word_count));
+        if (fingerprint != TranslationFingerprint()) {
+            return std::nullopt;
+        }
+        const size_t words_offset = sizeof(fingerprint) + sizeof(word_count);
+        const size_t words_size = size_t{word_count} * sizeof(u32);
+        if (data.size() - words_offset < words_size) {
+            return std::nullopt;
+        }
+
+        // Guest code may have changed since the entry was recorded
+        const u64 pc = A64::LocationDescriptor{current_location}.PC();
+        for (size_t i = 0; i < word_count; i++) {
+            u32 expected;
+            std::memcpy(&expected, data.data() + words_offset + i * sizeof(u32), sizeof(u32));
+            const auto word = conf.callbacks->MemoryReadCode(pc + i * sizeof(u32));
+            if (!word || *word != expected) {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<IR::Block> ir_block = IR::DeserializeBlock(std::span<const u8>{data}.subspan(words_offset + words_size));
+        if (!ir_block || ir_block->Location() != current_location) {
+            return std::nullopt;
+        }
+
+        // The stored IR has already been through every pass, and the fingerprint covers the
+        // polyfills the host needed, so only the names need to be rebuilt
+        Optimization::NamingPass(*ir_block);
+        Optimization::VerificationPass(*ir_block);
+        return ir_block;
+    }
+
+    void StoreCachedBlock(const IR::Block& ir_block) {
+        if (!conf.translation_cache) {
+            return;
+        }
+
+        const u64 start_address = A64::LocationDescriptor{ir_block.Location()}.PC();
+        u64 end_address = A64::LocationDescriptor{ir_block.EndLocation()}.PC();
+        const IR::Terminal terminal = ir_block.GetTerminal();
+        if (const auto* term = boost::get<IR::Term::Interpret>(&terminal)) {
+            end_address = std::max(end_address, A64::LocationDescriptor{term->next}.PC() + term->num_instructions * sizeof(u32));
+        }
+        if (end_address <= start_address) {
+            return;
+        }
+
+        const u64 fingerprint = TranslationFingerprint();
+        const u32 word_count = static_cast<u32>((end_address - start_address) / sizeof(u32));
+        const size_t words_offset = sizeof(fingerprint) + sizeof(word_count);
+        std::vector<u8> data(words_offset + size_t{word_count} * sizeof(u32));
+        std::memcpy(data.data(), &fingerprint, sizeof(fingerprint));
+        std::memcpy(data.data() + sizeof(fingerprint), &word_count, sizeof(word_count));
+        for (size_t i = 0; i < word_count; i++) {
+            const auto word = conf.callbacks->MemoryReadCode(start_address + i * sizeof(u32));
+            if (!word) {
+                return;
+            }
+            std::memcpy(data.data() + words_offset + i * sizeof(u32), &*word, sizeof(u32));
+        }
+
+        if (!IR::SerializeBlock(ir_block, data)) {
+            return;
+        }
+        conf.translation_cache->Store(ir_block.Location().Value(), start_address, end_address, std::move(data));
     }
 
     void PerformRequestedCacheInvalidation(HaltReason hr) {
@@ -319,6 +453,7 @@ private:
     BlockOfCode block_of_code;
     A64EmitX64 emitter;
     Optimization::PolyfillOptions polyfill_options;
+    CompilationStatistics compilation_statistics;
 
     bool invalidate_entire_cache = false;
     boost::icl::interval_set<u64> invalid_cache_ranges;
@@ -438,6 +573,14 @@ bool Jit::IsExecuting() const {
     return impl->IsExecuting();
 }
 
+Jit::CompilationStatistics Jit::GetCompilationStatistics() const {
+    return impl->GetCompilationStatistics();
+}
+
+std::vector<Jit::BlockProfile> Jit::GetBlockProfile() const {
+    return impl->GetBlockProfile();
+}
+
 void Jit::DumpDisassembly() const {
     return impl->DumpDisassembly();
 }
@@ -119,6 +119,34 @@ public:
      */
     bool IsExecuting() const;
 
+    struct CompilationStatistics {
+        /// Number of blocks compiled since construction.
+        std::uint64_t blocks_compiled = 0;
+        /// Total host time spent translating, optimizing and emitting those blocks.
+        std::uint64_t compile_time_ns = 0;
+        /// Bytes of the code cache currently in use, including the prelude.
+        std::size_t code_cache_used = 0;
+        /// Total size of the code cache in bytes.
+        std::size_t code_cache_size = 0;
+    };
+
+    /// Retrieves statistics about code compiled by this instance.
+    CompilationStatistics GetCompilationStatistics() const;
+
+    struct BlockProfile {
+        /// Guest address of the start of the block.
+        std::uint64_t pc;
+        /// Number of times the block has been entered.
+        std::uint64_t hit_count;
+        /// Emitted code for the block, nullptr if it is no longer in the code cache.
+        const void* host_code;
+        /// Size in bytes of the emitted code.
+        std::size_t host_size;
+    };
+
+    /// Retrieves execution counts for blocks compiled with UserConfig::enable_block_profiling set.
+    std::vector<BlockProfile> GetBlockProfile() const;
+
     /// Debugging: Dump a disassembly all of compiled code to the console.
     void DumpDisassembly() const;
 
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "dynarmic/interface/optimization_flags.h"
 
@@ -135,6 +136,24 @@ struct UserCallbacks {
     virtual std::uint64_t GetCNTPCT() = 0;
 };
 
+/// Persistent storage for optimized IR, used to skip the frontend and IR optimization passes
+/// for blocks translated in a previous run. Implementations are shared between Jit instances
+/// and must be thread-safe. Stored data is opaque to the implementation.
+class TranslationCache {
+public:
+    virtual ~TranslationCache() = default;
+
+    /// Retrieves the entry for the block at location. Returns false if there is none.
+    virtual bool Load(std::uint64_t location, std::vector<std::uint8_t>& data) = 0;
+
+    /// Records the entry for the block at location, which was translated from the guest code
+    /// in [start_address, end_address).
+    virtual void Store(std::uint64_t location, VAddr start_address, VAddr end_address, std::vector<std::uint8_t> data) = 0;
+
+    /// Discards all entries whose guest code overlaps [start_address, start_address + length).
+    virtual void Invalidate(VAddr start_address, std::uint64_t length) = 0;
+};
+
 struct UserConfig {
     UserCallbacks* callbacks;
 
@@ -285,10 +304,18 @@ struct UserConfig {
     /// AddTicks and GetTicksRemaining are never called, and no cycle counting is done.
     bool enable_cycle_counting = true;
 
+    /// This option enables a per-block execution counter, incremented on every block entry.
+    /// The counts can be retrieved with Jit::GetBlockProfile.
+    bool enable_block_profiling = false;
+
     // Minimum size is about 8MiB. Maximum size is about 128MiB (arm64 host) or 2GiB (x64 host).
     // Maximum size is limited by the maximum length of a x86_64 / arm64 jump.
     size_t code_cache_size = 128 * 1024 * 1024;  // bytes
 
+    /// When set, translated blocks are looked up in and recorded to this cache. Entries are
+    /// validated against guest memory before use.
+    TranslationCache* translation_cache = nullptr;
+
     /// Internal use only
     bool very_verbose_debugging_output = false;
 };
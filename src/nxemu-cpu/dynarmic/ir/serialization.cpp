@@ -0,0 +1,471 @@
+/* This file is part of the dynarmic project.
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include "dynarmic/ir/serialization.h"
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+#include "dynarmic/frontend/A64/a64_types.h"
+#include "dynarmic/ir/acc_type.h"
+#include "dynarmic/ir/cond.h"
+#include "dynarmic/ir/microinstruction.h"
+#include "dynarmic/ir/opcodes.h"
+#include "dynarmic/ir/terminal.h"
+#include "dynarmic/ir/type.h"
+#include "dynarmic/ir/value.h"
+
+namespace Dynarmic::IR {
+
+namespace {
+
+constexpr u32 serialization_magic = 0x42524944;  // "DIRB"
+constexpr u32 serialization_version = 1;
+constexpr size_t max_terminal_depth = 16;
+
+enum class TerminalKind : u8 {
+    Invalid,
+    Interpret,
+    ReturnToDispatch,
+    LinkBlock,
+    LinkBlockFast,
+    PopRSBHint,
+    FastDispatchHint,
+    If,
+    CheckBit,
+    CheckHalt,
+};
+
+class Writer {
+public:
+    explicit Writer(std::vector<u8>& out)
+            : out(out) {}
+
+    template<typename T>
+    void Write(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+private:
+    std::vector<u8>& out;
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data)
+            : data(data) {}
+
+    template<typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool AtEnd() const { return offset == data.size(); }
+    size_t Remaining() const { return data.size() - offset; }
+
+private:
+    std::span<const u8> data;
+    size_t offset = 0;
+};
+
+bool WriteValue(Writer& w, const Value& value, const std::unordered_map<const Inst*, u32>& inst_indices) {
+    if (value.IsEmpty()) {
+        w.Write(static_cast<u32>(Type::Void));
+        return true;
+    }
+
+    if (!value.IsImmediate()) {
+        const auto iter = inst_indices.find(value.GetInst());
+        if (iter == inst_indices.end()) {
+            return false;
+        }
+        w.Write(static_cast<u32>(Type::Opaque));
+        w.Write(iter->second);
+        return true;
+    }
+
+    const Type type = value.GetType();
+    w.Write(static_cast<u32>(type));
+    switch (type) {
+    case Type::A64Reg:
+        w.Write(static_cast<u8>(value.GetA64RegRef()));
+        return true;
+    case Type::A64Vec:
+        w.Write(static_cast<u8>(value.GetA64VecRef()));
+        return true;
+    case Type::U1:
+        w.Write(static_cast<u8>(value.GetU1()));
+        return true;
+    case Type::U8:
+        w.Write(value.GetU8());
+        return true;
+    case Type::U16:
+        w.Write(value.GetU16());
+        return true;
+    case Type::U32:
+        w.Write(value.GetU32());
+        return true;
+    case Type::U64:
+        w.Write(value.GetU64());
+        return true;
+    case Type::CoprocInfo:
+        w.Write(value.GetCoprocInfo());
+        return true;
+    case Type::NZCVFlags:
+        // EmptyNZCVImmediateMarker carries no payload
+        return true;
+    case Type::Cond:
+        w.Write(static_cast<u8>(value.GetCond()));
+        return true;
+    case Type::AccType:
+        w.Write(static_cast<u8>(value.GetAccType()));
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::optional<Value> ReadValue(Reader& r, const std::vector<Inst*>& insts) {
+    u32 raw_type;
+    if (!r.Read(raw_type)) {
+        return std::nullopt;
+    }
+
+    switch (static_cast<Type>(raw_type)) {
+    case Type::Void:
+        return Value{};
+    case Type::Opaque: {
+        u32 index;
+        if (!r.Read(index) || index >= insts.size()) {
+            return std::nullopt;
+        }
+        return Value{insts[index]};
+    }
+    case Type::A64Reg: {
+        u8 reg;
+        if (!r.Read(reg) || reg > static_cast<u8>(A64::Reg::R31)) {
+            return std::nullopt;
+        }
+        return Value{static_cast<A64::Reg>(reg)};
+    }
+    case Type::A64Vec: {
+        u8 vec;
+        if (!r.Read(vec) || vec > static_cast<u8>(A64::Vec::V31)) {
+            return std::nullopt;
+        }
+        return Value{static_cast<A64::Vec>(vec)};
+    }
+    case Type::U1: {
+        u8 imm;
+        if (!r.Read(imm) || imm > 1) {
+            return std::nullopt;
+        }
+        return Value{imm != 0};
+    }
+    case Type::U8: {
+        u8 imm;
+        if (!r.Read(imm)) {
+            return std::nullopt;
+        }
+        return Value{imm};
+    }
+    case Type::U16: {
+        u16 imm;
+        if (!r.Read(imm)) {
+            return std::nullopt;
+        }
+        return Value{imm};
+    }
+    case Type::U32: {
+        u32 imm;
+        if (!r.Read(imm)) {
+            return std::nullopt;
+        }
+        return Value{imm};
+    }
+    case Type::U64: {
+        u64 imm;
+        if (!r.Read(imm)) {
+            return std::nullopt;
+        }
+        return Value{imm};
+    }
+    case Type::CoprocInfo: {
+        Value::CoprocessorInfo info;
+        if (!r.Read(info)) {
+            return std::nullopt;
+        }
+        return Value{info};
+    }
+    case Type::NZCVFlags:
+        return Value::EmptyNZCVImmediateMarker();
+    case Type::Cond: {
+        u8 cond;
+        if (!r.Read(cond) || cond > static_cast<u8>(Cond::NV)) {
+            return std::nullopt;
+        }
+        return Value{static_cast<Cond>(cond)};
+    }
+    case Type::AccType: {
+        u8 acc_type;
+        if (!r.Read(acc_type) || acc_type > static_cast<u8>(AccType::SWAP)) {
+            return std::nullopt;
+        }
+        return Value{static_cast<AccType>(acc_type)};
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+void WriteTerminal(Writer& w, const Terminal& terminal) {
+    const auto kind = static_cast<TerminalKind>(terminal.which());
+    w.Write(kind);
+    switch (kind) {
+    case TerminalKind::Interpret: {
+        const auto& term = boost::get<Term::Interpret>(terminal);
+        w.Write(term.next.Value());
+        w.Write(static_cast<u64>(term.num_instructions));
+        break;
+    }
+    case TerminalKind::LinkBlock:
+        w.Write(boost::get<Term::LinkBlock>(terminal).next.Value());
+        break;
+    case TerminalKind::LinkBlockFast:
+        w.Write(boost::get<Term::LinkBlockFast>(terminal).next.Value());
+        break;
+    case TerminalKind::If: {
+        const auto& term = boost::get<Term::If>(terminal);
+        w.Write(static_cast<u8>(term.if_));
+        WriteTerminal(w, term.then_);
+        WriteTerminal(w, term.else_);
+        break;
+    }
+    case TerminalKind::CheckBit: {
+        const auto& term = boost::get<Term::CheckBit>(terminal);
+        WriteTerminal(w, term.then_);
+        WriteTerminal(w, term.else_);
+        break;
+    }
+    case TerminalKind::CheckHalt:
+        WriteTerminal(w, boost::get<Term::CheckHalt>(terminal).else_);
+        break;
+    default:
+        break;
+    }
+}
+
+std::optional<Terminal> ReadTerminal(Reader& r, size_t depth) {
+    TerminalKind kind;
+    if (depth > max_terminal_depth || !r.Read(kind)) {
+        return std::nullopt;
+    }
+
+    switch (kind) {
+    case TerminalKind::Invalid:
+        return Term::Invalid{};
+    case TerminalKind::Interpret: {
+        u64 next, num_instructions;
+        if (!r.Read(next) || !r.Read(num_instructions)) {
+            return std::nullopt;
+        }
+        Term::Interpret term{LocationDescriptor{next}};
+        term.num_instructions = static_cast<size_t>(num_instructions);
+        return term;
+    }
+    case TerminalKind::ReturnToDispatch:
+        return Term::ReturnToDispatch{};
+    case TerminalKind::LinkBlock: {
+        u64 next;
+        if (!r.Read(next)) {
+            return std::nullopt;
+        }
+        return Term::LinkBlock{LocationDescriptor{next}};
+    }
+    case TerminalKind::LinkBlockFast: {
+        u64 next;
+        if (!r.Read(next)) {
+            return std::nullopt;
+        }
+        return Term::LinkBlockFast{LocationDescriptor{next}};
+    }
+    case TerminalKind::PopRSBHint:
+        return Term::PopRSBHint{};
+    case TerminalKind::FastDispatchHint:
+        return Term::FastDispatchHint{};
+    case TerminalKind::If: {
+        u8 cond;
+        if (!r.Read(cond) || cond > static_cast<u8>(Cond::NV)) {
+            return std::nullopt;
+        }
+        auto then_ = ReadTerminal(r, depth + 1);
+        if (!then_) {
+            return std::nullopt;
+        }
+        auto else_ = ReadTerminal(r, depth + 1);
+        if (!else_) {
+            return std::nullopt;
+        }
+        return Term::If{static_cast<Cond>(cond), std::move(*then_), std::move(*else_)};
+    }
+    case TerminalKind::CheckBit: {
+        auto then_ = ReadTerminal(r, depth + 1);
+        if (!then_) {
+            return std::nullopt;
+        }
+        auto else_ = ReadTerminal(r, depth + 1);
+        if (!else_) {
+            return std::nullopt;
+        }
+        return Term::CheckBit{std::move(*then_), std::move(*else_)};
+    }
+    case TerminalKind::CheckHalt: {
+        auto else_ = ReadTerminal(r, depth + 1);
+        if (!else_) {
+            return std::nullopt;
+        }
+        return Term::CheckHalt{std::move(*else_)};
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+void AppendInst(Block& block, Opcode op, const std::array<Value, max_arg_count>& args) {
+    switch (GetNumArgsOf(op)) {
+    case 0:
+        block.AppendNewInst(op, {});
+        break;
+    case 1:
+        block.AppendNewInst(op, {args[0]});
+        break;
+    case 2:
+        block.AppendNewInst(op, {args[0], args[1]});
+        break;
+    case 3:
+        block.AppendNewInst(op, {args[0], args[1], args[2]});
+        break;
+    case 4:
+        block.AppendNewInst(op, {args[0], args[1], args[2], args[3]});
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
+}  // anonymous namespace
+
+bool SerializeBlock(const Block& block, std::vector<u8>& out) {
+    std::vector<u8> result;
+    Writer w{result};
+
+    w.Write(serialization_magic);
+    w.Write(serialization_version);
+    w.Write(static_cast<u32>(OpcodeCount));
+
+    w.Write(block.Location().Value());
+    w.Write(block.EndLocation().Value());
+    w.Write(static_cast<u8>(block.GetCondition()));
+    w.Write(static_cast<u8>(block.HasConditionFailedLocation()));
+    w.Write(block.HasConditionFailedLocation() ? block.ConditionFailedLocation().Value() : u64{0});
+    w.Write(static_cast<u64>(block.ConditionFailedCycleCount()));
+    w.Write(static_cast<u64>(block.CycleCount()));
+
+    std::unordered_map<const Inst*, u32> inst_indices;
+    w.Write(static_cast<u32>(block.size()));
+    for (const auto& inst : block) {
+        w.Write(static_cast<u16>(inst.GetOpcode()));
+        for (size_t i = 0; i < inst.NumArgs(); i++) {
+            if (!WriteValue(w, inst.GetArg(i), inst_indices)) {
+                return false;
+            }
+        }
+        inst_indices.emplace(&inst, static_cast<u32>(inst_indices.size()));
+    }
+
+    WriteTerminal(w, block.GetTerminal());
+
+    out.insert(out.end(), result.begin(), result.end());
+    return true;
+}
+
+std::optional<Block> DeserializeBlock(std::span<const u8> data) {
+    Reader r{data};
+
+    u32 magic, version, opcode_count;
+    if (!r.Read(magic) || !r.Read(version) || !r.Read(opcode_count)) {
+        return std::nullopt;
+    }
+    if (magic != serialization_magic || version != serialization_version || opcode_count != OpcodeCount) {
+        return std::nullopt;
+    }
+
+    u64 location, end_location, cond_failed, cond_failed_cycle_count, cycle_count;
+    u8 cond, has_cond_failed;
+    if (!r.Read(location) || !r.Read(end_location) || !r.Read(cond) || !r.Read(has_cond_failed) || !r.Read(cond_failed) || !r.Read(cond_failed_cycle_count) || !r.Read(cycle_count)) {
+        return std::nullopt;
+    }
+    if (cond > static_cast<u8>(Cond::NV)) {
+        return std::nullopt;
+    }
+
+    Block block{LocationDescriptor{location}};
+    block.SetEndLocation(LocationDescriptor{end_location});
+    block.SetCondition(static_cast<Cond>(cond));
+    if (has_cond_failed) {
+        block.SetConditionFailedLocation(LocationDescriptor{cond_failed});
+    }
+    block.ConditionFailedCycleCount() = static_cast<size_t>(cond_failed_cycle_count);
+    block.CycleCount() = static_cast<size_t>(cycle_count);
+
+    // Every instruction takes at least its opcode, so a count the rest of the data cannot hold is
+    // corrupt and must not size the reservation below
+    u32 inst_count;
+    if (!r.Read(inst_count) || inst_count > r.Remaining() / sizeof(u16)) {
+        return std::nullopt;
+    }
+
+    std::vector<Inst*> insts;
+    insts.reserve(inst_count);
+    for (u32 index = 0; index < inst_count; index++) {
+        u16 raw_op;
+        if (!r.Read(raw_op) || raw_op >= OpcodeCount) {
+            return std::nullopt;
+        }
+
+        const Opcode op = static_cast<Opcode>(raw_op);
+        std::array<Value, max_arg_count> args;
+        for (size_t i = 0; i < GetNumArgsOf(op); i++) {
+            auto arg = ReadValue(r, insts);
+            if (!arg || !AreTypesCompatible(arg->GetType(), GetArgTypeOf(op, i))) {
+                return std::nullopt;
+            }
+            args[i] = *arg;
+        }
+
+        AppendInst(block, op, args);
+        insts.push_back(&block.back());
+    }
+
+    auto terminal = ReadTerminal(r, 0);
+    if (!terminal || !r.AtEnd()) {
+        return std::nullopt;
+    }
+    block.SetTerminal(std::move(*terminal));
+
+    return block;
+}
+
+}  // namespace Dynarmic::IR
@@ -0,0 +1,32 @@
+/* This file is part of the dynarmic project.
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <mcl/stdint.hpp>
+
+#include "dynarmic/ir/basic_block.h"
+
+namespace Dynarmic::IR {
+
+/**
+ * Appends a position-independent binary representation of an optimized block to out.
+ * Instruction arguments referring to other instructions are stored as indices into the block.
+ * @returns false if the block contains values which cannot be serialized (e.g. A32 register references),
+ *          in which case out is left unmodified.
+ */
+bool SerializeBlock(const Block& block, std::vector<u8>& out);
+
+/**
+ * Reconstructs a block previously written by SerializeBlock.
+ * Inst names are not preserved, run NamingPass on the result before emission.
+ * @returns std::nullopt if data is truncated, malformed or was written by an incompatible version.
+ */
+std::optional<Block> DeserializeBlock(std::span<const u8> data);
+
+}  // namespace Dynarmic::IR
@@ -1,59 +1,76 @@
 #include "exclusive_monitor_interface.h"
+#include "atomic_ops.h"
+#include <string.h>
 
-ExclusiveMonitor::ExclusiveMonitor(IMemory & /*memory*/, uint32_t processorCount) :
-    Dynarmic::ExclusiveMonitor(processorCount)
+ExclusiveMonitor::ExclusiveMonitor(IMemory & memory, uint32_t processorCount) :
+    Dynarmic::ExclusiveMonitor(processorCount),
+    m_memory(memory)
 {
 }
 
-uint8_t ExclusiveMonitor::ExclusiveRead8(uint32_t /*coreIndex*/, uint64_t /*addr*/)
+uint8_t ExclusiveMonitor::ExclusiveRead8(uint32_t coreIndex, uint64_t addr)
 {
-    __debugbreak();
-    return 0;
+    return ExclusiveRead<uint8_t>(coreIndex, addr);
 }
 
-uint16_t ExclusiveMonitor::ExclusiveRead16(uint32_t /*coreIndex*/, uint64_t /*addr*/)
+uint16_t ExclusiveMonitor::ExclusiveRead16(uint32_t coreIndex, uint64_t addr)
 {
-    __debugbreak();
-    return 0;
+    return ExclusiveRead<uint16_t>(coreIndex, addr);
 }
 
-uint32_t ExclusiveMonitor::ExclusiveRead32(uint32_t /*coreIndex*/, uint64_t /*addr*/)
+uint32_t ExclusiveMonitor::ExclusiveRead32(uint32_t coreIndex, uint64_t addr)
 {
-    __debugbreak();
-    return 0;
+    return ExclusiveRead<uint32_t>(coreIndex, addr);
 }
 
-uint64_t ExclusiveMonitor::ExclusiveRead64(uint32_t /*coreIndex*/, uint64_t /*addr*/)
+uint64_t ExclusiveMonitor::ExclusiveRead64(uint32_t coreIndex, uint64_t addr)
 {
-    __debugbreak();
-    return 0;
+    return ExclusiveRead<uint64_t>(coreIndex, addr);
 }
 
-void ExclusiveMonitor::ClearExclusive(uint32_t /*coreIndex*/)
+void ExclusiveMonitor::ClearExclusive(uint32_t coreIndex)
 {
-    __debugbreak();
+    ClearProcessor(coreIndex);
 }
 
-bool ExclusiveMonitor::ExclusiveWrite8(uint32_t /*coreIndex*/, uint64_t /*addr*/, uint8_t /*value*/)
+bool ExclusiveMonitor::ExclusiveWrite8(uint32_t coreIndex, uint64_t addr, uint8_t value)
 {
-    __debugbreak();
-    return false;
+    return ExclusiveWrite<uint8_t>(coreIndex, addr, value);
 }
 
-bool ExclusiveMonitor::ExclusiveWrite16(uint32_t /*coreIndex*/, uint64_t /*addr*/, uint16_t /*value*/)
+bool ExclusiveMonitor::ExclusiveWrite16(uint32_t coreIndex, uint64_t addr, uint16_t value)
 {
-    __debugbreak();
-    return false;
+    return ExclusiveWrite<uint16_t>(coreIndex, addr, value);
 }
 
-bool ExclusiveMonitor::ExclusiveWrite32(uint32_t /*coreIndex*/, uint64_t /*addr*/, uint32_t /*value*/)
+bool ExclusiveMonitor::ExclusiveWrite32(uint32_t coreIndex, uint64_t addr, uint32_t value)
 {
-    __debugbreak();
-    return false;
+    return ExclusiveWrite<uint32_t>(coreIndex, addr, value);
 }
 
-bool ExclusiveMonitor::ExclusiveWrite64(uint32_t /*coreIndex*/, uint64_t /*addr*/, uint64_t /*value*/)
+bool ExclusiveMonitor::ExclusiveWrite64(uint32_t coreIndex, uint64_t addr, uint64_t value)
 {
-    __debugbreak();
-    return false;
+    return ExclusiveWrite<uint64_t>(coreIndex, addr, value);
+}
+
+template <typename T>
+T ExclusiveMonitor::ExclusiveRead(uint32_t coreIndex, uint64_t addr)
+{
+    return ReadAndMark<T>(coreIndex, addr, [&]() -> T {
+        T value = 0;
+        const uint8_t * ptr = m_memory.GetPointerSilent(addr);
+        if (ptr != nullptr)
+        {
+            memcpy(&value, ptr, sizeof(value));
+        }
+        return value;
+    });
+}
+
+template <typename T>
+bool ExclusiveMonitor::ExclusiveWrite(uint32_t coreIndex, uint64_t addr, T value)
+{
+    return DoExclusiveOperation<T>(coreIndex, addr, [&](T expected) -> bool {
+        return ExclusiveCompareAndSwap(m_memory, addr, value, expected);
+    });
 }
\ No newline at end of file
@@ -27,4 +27,11 @@ private:
     ExclusiveMonitor() = delete;
     ExclusiveMonitor(const ExclusiveMonitor &) = delete;
     ExclusiveMonitor & operator=(const ExclusiveMonitor &) = delete;
+
+    template <typename T>
+    T ExclusiveRead(uint32_t coreIndex, uint64_t addr);
+    template <typename T>
+    bool ExclusiveWrite(uint32_t coreIndex, uint64_t addr, T value);
+
+    IMemory & m_memory;
 };
\ No newline at end of file
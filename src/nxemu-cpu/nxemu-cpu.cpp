@@ -69,6 +69,10 @@ Output: None
 */
 void CALL EmulationStopping()
 {
+    if (g_cpuManager)
+    {
+        g_cpuManager->EmulationStopping();
+    }
 }
 
 ICpu * CALL CreateCpu(ISwitchSystem & System)
@@ -0,0 +1,302 @@
+#include "translation_cache.h"
+#include <common/file.h>
+#include <common/sha256.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+const uint32_t CACHE_FILE_MAGIC = 0x434A584E; // "NXJC"
+const uint32_t CACHE_FILE_VERSION = 1;
+
+struct CacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+};
+static_assert(sizeof(CacheFileHeader) == 0xC, "CacheFileHeader has incorrect size");
+
+struct CacheFileEntry
+{
+    uint64_t location;
+    uint64_t startAddress;
+    uint64_t endAddress;
+    uint32_t dataSize;
+    uint32_t reserved;
+};
+static_assert(sizeof(CacheFileEntry) == 0x20, "CacheFileEntry has incorrect size");
+} // namespace
+
+TranslationCache::TranslationCache() :
+    m_maxBlockSize(0),
+    m_changed(false),
+    m_stopSaving(false)
+{
+    m_saveThread = std::thread(&TranslationCache::SaveThread, this);
+}
+
+TranslationCache::~TranslationCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        m_stopSaving = true;
+    }
+    m_saveEvent.notify_one();
+    m_saveThread.join();
+    Save();
+}
+
+void TranslationCache::ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress)
+{
+    CachedModule cachedModule;
+    cachedModule.file = CacheFile(module, baseAddress);
+    cachedModule.codeStart = baseAddress + module.CodeSegmentAddr();
+    cachedModule.codeEnd = cachedModule.codeStart + module.CodeSegmentSize();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    LoadModuleCache(cachedModule);
+    m_modules.push_back(cachedModule);
+}
+
+void TranslationCache::Save(void)
+{
+    // The files are built under the lock but written outside it, so the JIT is not held up by disk I/O.
+    // Saves are serialized so an older snapshot never overwrites a newer one.
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    std::vector<std::pair<CachedModule, std::vector<uint8_t>>> moduleFiles;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_changed)
+        {
+            return;
+        }
+        for (const CachedModule & module : m_modules)
+        {
+            moduleFiles.emplace_back(module, BuildModuleCache(module));
+        }
+        m_changed = false;
+    }
+    for (const std::pair<CachedModule, std::vector<uint8_t>> & moduleFile : moduleFiles)
+    {
+        WriteModuleCache(moduleFile.first, moduleFile.second);
+    }
+}
+
+bool TranslationCache::Load(uint64_t location, std::vector<uint8_t> & data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CacheEntries::const_iterator itr = m_entries.find(location);
+    if (itr == m_entries.end())
+    {
+        return false;
+    }
+    data = itr->second.data;
+    return true;
+}
+
+void TranslationCache::Store(uint64_t location, uint64_t startAddress, uint64_t endAddress, std::vector<uint8_t> data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const CachedModule & module : m_modules)
+    {
+        // Only code backed by a loaded module can be matched against a later run
+        if (startAddress >= module.codeStart && endAddress <= module.codeEnd)
+        {
+            AddEntry(location, CacheEntry{startAddress, endAddress, std::move(data)});
+            m_changed = true;
+            return;
+        }
+    }
+}
+
+void TranslationCache::Invalidate(uint64_t startAddress, uint64_t length)
+{
+    const uint64_t endAddress = startAddress + length;
+
+    // No block is longer than m_maxBlockSize, so only blocks starting in that window before the
+    // range can reach into it
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t firstStart = startAddress > m_maxBlockSize ? startAddress - m_maxBlockSize : 0;
+    for (CacheRanges::iterator itr = m_ranges.lower_bound(firstStart); itr != m_ranges.end() && itr->first < endAddress;)
+    {
+        CacheEntries::iterator entry = m_entries.find(itr->second);
+        if (entry != m_entries.end() && startAddress < entry->second.endAddress)
+        {
+            m_entries.erase(entry);
+            itr = m_ranges.erase(itr);
+            m_changed = true;
+        }
+        else
+        {
+            itr++;
+        }
+    }
+}
+
+void TranslationCache::AddEntry(uint64_t location, CacheEntry entry)
+{
+    CacheEntries::iterator itr = m_entries.find(location);
+    if (itr != m_entries.end())
+    {
+        RemoveRange(location, itr->second.startAddress);
+    }
+    m_ranges.emplace(entry.startAddress, location);
+    if (entry.endAddress - entry.startAddress > m_maxBlockSize)
+    {
+        m_maxBlockSize = entry.endAddress - entry.startAddress;
+    }
+    m_entries[location] = std::move(entry);
+}
+
+void TranslationCache::RemoveRange(uint64_t location, uint64_t startAddress)
+{
+    std::pair<CacheRanges::iterator, CacheRanges::iterator> range = m_ranges.equal_range(startAddress);
+    for (CacheRanges::iterator itr = range.first; itr != range.second; itr++)
+    {
+        if (itr->second == location)
+        {
+            m_ranges.erase(itr);
+            return;
+        }
+    }
+}
+
+void TranslationCache::SaveThread(void)
+{
+    // Saved periodically as well as on exit, so a session that is killed or crashes keeps what it recorded
+    const std::chrono::seconds SAVE_INTERVAL(30);
+
+    std::unique_lock<std::mutex> lock(m_saveMutex);
+    while (!m_saveEvent.wait_for(lock, SAVE_INTERVAL, [this] { return m_stopSaving; }))
+    {
+        lock.unlock();
+        Save();
+        lock.lock();
+    }
+}
+
+Path TranslationCache::CacheFile(const IModuleInfo & module, uint64_t baseAddress)
+{
+    const uint64_t segmentInfo[] = {
+        baseAddress,
+        module.CodeSegmentAddr(),
+        module.CodeSegmentOffset(),
+        module.CodeSegmentSize(),
+    };
+
+    SHA256 sha256;
+    sha256.init();
+    sha256.update((const unsigned char *)segmentInfo, sizeof(segmentInfo));
+    if (module.CodeSegmentOffset() + module.CodeSegmentSize() <= module.DataSize())
+    {
+        sha256.update(module.Data() + module.CodeSegmentOffset(), (unsigned int)module.CodeSegmentSize());
+    }
+    unsigned char digest[SHA256::DIGEST_SIZE];
+    sha256.final(digest);
+
+    char fileName[SHA256::DIGEST_SIZE * 2 + 5];
+    for (uint32_t i = 0; i < SHA256::DIGEST_SIZE; i++)
+    {
+        sprintf(&fileName[i * 2], "%02x", digest[i]);
+    }
+    strcat(fileName, ".jit");
+
+    Path cacheFile(Path::MODULE_DIRECTORY, fileName);
+    cacheFile.AppendDirectory("cache");
+    cacheFile.AppendDirectory("jit");
+    return cacheFile;
+}
+
+void TranslationCache::LoadModuleCache(const CachedModule & module)
+{
+    if (!module.file.FileExists())
+    {
+        return;
+    }
+
+    File cacheFile;
+    if (!cacheFile.Open(module.file, IFile::modeRead))
+    {
+        return;
+    }
+    uint64_t fileSize = cacheFile.GetLength();
+    std::vector<uint8_t> fileData((size_t)fileSize);
+    if (fileSize == 0 || cacheFile.Read(fileData.data(), (uint32_t)fileSize) != fileSize)
+    {
+        return;
+    }
+
+    CacheFileHeader header;
+    if (fileSize < sizeof(header))
+    {
+        return;
+    }
+    memcpy(&header, fileData.data(), sizeof(header));
+    if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION)
+    {
+        return;
+    }
+
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.entryCount; i++)
+    {
+        CacheFileEntry entry;
+        if (fileSize - offset < sizeof(entry))
+        {
+            break;
+        }
+        memcpy(&entry, fileData.data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+        if (fileSize - offset < entry.dataSize)
+        {
+            break;
+        }
+        if (entry.endAddress <= entry.startAddress)
+        {
+            break;
+        }
+        const uint8_t * data = fileData.data() + offset;
+        AddEntry(entry.location, CacheEntry{entry.startAddress, entry.endAddress, std::vector<uint8_t>(data, data + entry.dataSize)});
+        offset += entry.dataSize;
+    }
+}
+
+std::vector<uint8_t> TranslationCache::BuildModuleCache(const CachedModule & module) const
+{
+    std::vector<uint8_t> fileData(sizeof(CacheFileHeader));
+    uint32_t entryCount = 0;
+    for (CacheRanges::const_iterator itr = m_ranges.lower_bound(module.codeStart); itr != m_ranges.end() && itr->first < module.codeEnd; itr++)
+    {
+        CacheEntries::const_iterator cacheItr = m_entries.find(itr->second);
+        if (cacheItr == m_entries.end() || cacheItr->second.endAddress > module.codeEnd)
+        {
+            continue;
+        }
+        const CacheEntry & cacheEntry = cacheItr->second;
+        CacheFileEntry entry = {cacheItr->first, cacheEntry.startAddress, cacheEntry.endAddress, (uint32_t)cacheEntry.data.size(), 0};
+        const uint8_t * entryData = (const uint8_t *)&entry;
+        fileData.insert(fileData.end(), entryData, entryData + sizeof(entry));
+        fileData.insert(fileData.end(), cacheEntry.data.begin(), cacheEntry.data.end());
+        entryCount += 1;
+    }
+    CacheFileHeader header = {CACHE_FILE_MAGIC, CACHE_FILE_VERSION, entryCount};
+    memcpy(fileData.data(), &header, sizeof(header));
+    return fileData;
+}
+
+void TranslationCache::WriteModuleCache(const CachedModule & module, const std::vector<uint8_t> & fileData)
+{
+    Path cacheDir(module.file.GetDriveDirectory(), "");
+    if (!cacheDir.DirectoryExists() && !cacheDir.DirectoryCreate())
+    {
+        return;
+    }
+    File cacheFile;
+    if (!cacheFile.Open(module.file, IFile::modeWrite | IFile::modeCreate))
+    {
+        return;
+    }
+    cacheFile.Write(fileData.data(), (uint32_t)fileData.size());
+}
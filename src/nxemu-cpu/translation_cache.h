@@ -0,0 +1,69 @@
+#pragma once
+#include <nxemu-module-spec/base.h>
+#include "dynarmic/interface/A64/config.h"
+#include <common/path.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class TranslationCache :
+    public Dynarmic::A64::TranslationCache
+{
+    struct CacheEntry
+    {
+        uint64_t startAddress;
+        uint64_t endAddress;
+        std::vector<uint8_t> data;
+    };
+
+    struct CachedModule
+    {
+        Path file;
+        uint64_t codeStart;
+        uint64_t codeEnd;
+    };
+
+    typedef std::unordered_map<uint64_t, CacheEntry> CacheEntries;
+    typedef std::multimap<uint64_t, uint64_t> CacheRanges;
+    typedef std::vector<CachedModule> CachedModules;
+
+public:
+    TranslationCache();
+    ~TranslationCache();
+
+    void ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress);
+    void Save(void);
+
+    // Dynarmic::A64::TranslationCache
+    bool Load(uint64_t location, std::vector<uint8_t> & data);
+    void Store(uint64_t location, uint64_t startAddress, uint64_t endAddress, std::vector<uint8_t> data);
+    void Invalidate(uint64_t startAddress, uint64_t length);
+
+private:
+    TranslationCache(const TranslationCache &) = delete;
+    TranslationCache & operator=(const TranslationCache &) = delete;
+
+    static Path CacheFile(const IModuleInfo & module, uint64_t baseAddress);
+    void AddEntry(uint64_t location, CacheEntry entry);
+    void RemoveRange(uint64_t location, uint64_t startAddress);
+    void LoadModuleCache(const CachedModule & module);
+    std::vector<uint8_t> BuildModuleCache(const CachedModule & module) const;
+    static void WriteModuleCache(const CachedModule & module, const std::vector<uint8_t> & fileData);
+    void SaveThread(void);
+
+    std::mutex m_mutex;
+    CacheEntries m_entries;
+    CacheRanges m_ranges;
+    uint64_t m_maxBlockSize;
+    CachedModules m_modules;
+    bool m_changed;
+
+    std::mutex m_writeMutex;
+    std::mutex m_saveMutex;
+    std::condition_variable m_saveEvent;
+    bool m_stopSaving;
+    std::thread m_saveThread;
+};
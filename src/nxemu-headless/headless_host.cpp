@@ -0,0 +1,21 @@
+#include "headless_host.h"
+#include <stdio.h>
+
+void HeadlessNotification::DisplayError(const char * message) const
+{
+    fprintf(stderr, "Error: %s\n", message);
+}
+
+void HeadlessNotification::BreakPoint(const char * fileName, uint32_t lineNumber)
+{
+    fprintf(stderr, "Break point found at %s(%d)\n", fileName, lineNumber);
+}
+
+void HeadlessNotification::AppInitDone(void)
+{
+}
+
+void * HeadlessRenderWindow::RenderSurface(void) const
+{
+    return nullptr;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <nxemu-core/notification.h>
+#ifndef EXPORT
+#define EXPORT
+#endif
+#include <nxemu-module-spec/base.h>
+
+class HeadlessNotification :
+    public INotification
+{
+public:
+    HeadlessNotification() = default;
+
+    // INotification
+    void DisplayError(const char * message) const;
+    void BreakPoint(const char * fileName, uint32_t lineNumber);
+    void AppInitDone(void);
+
+private:
+    HeadlessNotification(const HeadlessNotification &) = delete;
+    HeadlessNotification & operator=(const HeadlessNotification &) = delete;
+};
+
+// Render window without a surface, only usable with the null renderer
+class HeadlessRenderWindow :
+    public IRenderWindow
+{
+public:
+    HeadlessRenderWindow() = default;
+
+    // IRenderWindow
+    void * RenderSurface(void) const;
+
+private:
+    HeadlessRenderWindow(const HeadlessRenderWindow &) = delete;
+    HeadlessRenderWindow & operator=(const HeadlessRenderWindow &) = delete;
+};
@@ -0,0 +1,285 @@
+#include "headless_host.h"
+#include <chrono>
+#include <nxemu-core/app_init.h>
+#include <nxemu-core/machine/switch_system.h>
+#include <nxemu-core/settings/identifiers.h>
+#include <nxemu-core/settings/settings.h>
+#include <nxemu-core/switch_rom.h>
+#include <nxemu-module-spec/cpu.h>
+#include <nxemu-module-spec/operating_system.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct HeadlessOptions
+{
+    std::string romFile;
+    uint64_t frames;
+    double seconds;
+    uint32_t intervalMs;
+    uint32_t profileBlocks;
+    std::string ipcProfileFile;
+    bool sharedServices;
+};
+
+struct RunSummary
+{
+    uint64_t samples;
+    double wallSeconds;
+    double speedTotal;
+    double frametimeTotal;
+    double frametimeMin;
+    double frametimeMax;
+    uint64_t startFrame;
+    uint64_t endFrame;
+};
+
+void Usage(const char * program)
+{
+    printf("Usage: %s <rom> [--frames <count>] [--seconds <count>] [--interval <ms>] [--profile <blocks>] [--ipc-profile <csv file>] [--shared-services]\n", program);
+    printf("Runs the rom with the null renderer until the frame or time limit is reached (default 30 seconds)\n");
+    printf("--profile enables JIT block profiling and reports the hottest guest blocks\n");
+    printf("--ipc-profile enables HLE IPC profiling and writes per command timings to the file\n");
+    printf("--shared-services serves the lightweight HLE services from a single thread\n");
+}
+
+bool ParseOptions(int argc, char * argv[], HeadlessOptions & options)
+{
+    options.frames = 0;
+    options.seconds = 0;
+    options.intervalMs = 1000;
+    options.profileBlocks = 0;
+    options.sharedServices = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            options.frames = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            options.seconds = strtod(argv[++i], nullptr);
+        }
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+        {
+            options.intervalMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+        {
+            options.profileBlocks = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--ipc-profile") == 0 && i + 1 < argc)
+        {
+            options.ipcProfileFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--shared-services") == 0)
+        {
+            options.sharedServices = true;
+        }
+        else if (argv[i][0] != '-' && options.romFile.empty())
+        {
+            options.romFile = argv[i];
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (options.frames == 0 && options.seconds <= 0)
+    {
+        options.seconds = 30;
+    }
+    if (options.intervalMs == 0)
+    {
+        options.intervalMs = 1000;
+    }
+    return !options.romFile.empty();
+}
+
+void RunRom(IOperatingSystem & operatingSystem, const HeadlessOptions & options, RunSummary & summary)
+{
+    OperatingSystemPerfStats stats = {0};
+    operatingSystem.GetAndResetPerfStats(stats);
+
+    summary.startFrame = stats.systemFrames;
+    summary.endFrame = stats.systemFrames;
+    printf("%10s %10s %8s %8s %14s %8s\n", "time (s)", "frames", "fps", "game fps", "frametime (ms)", "speed");
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.intervalMs));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (operatingSystem.GetAndResetPerfStats(stats))
+        {
+            double frametimeMs = stats.frametime * 1000.0;
+            printf("%10.1f %10llu %8.1f %8.1f %14.2f %7.1f%%\n", elapsed, (unsigned long long)stats.systemFrames, stats.systemFps, stats.averageGameFps, frametimeMs, stats.emulationSpeed * 100.0);
+
+            summary.endFrame = stats.systemFrames;
+            if (stats.systemFps > 0)
+            {
+                summary.frametimeMin = summary.samples == 0 || frametimeMs < summary.frametimeMin ? frametimeMs : summary.frametimeMin;
+                summary.frametimeMax = frametimeMs > summary.frametimeMax ? frametimeMs : summary.frametimeMax;
+                summary.frametimeTotal += frametimeMs;
+                summary.speedTotal += stats.emulationSpeed;
+                summary.samples += 1;
+            }
+        }
+        summary.wallSeconds = elapsed;
+
+        if (options.frames != 0 && summary.endFrame - summary.startFrame >= options.frames)
+        {
+            break;
+        }
+        if (options.seconds > 0 && elapsed >= options.seconds)
+        {
+            break;
+        }
+    }
+}
+
+void PrintThreadTimes(IOperatingSystem & operatingSystem, double wallSeconds)
+{
+    std::vector<OperatingSystemThreadTime> threadTimes(operatingSystem.GetThreadCpuTimes(nullptr, 0));
+    threadTimes.resize(operatingSystem.GetThreadCpuTimes(threadTimes.data(), (uint32_t)threadTimes.size()));
+
+    printf("\n%10s %6s %14s %8s\n", "thread", "core", "cpu time (ms)", "busy");
+    for (const OperatingSystemThreadTime & thread : threadTimes)
+    {
+        double cpuMs = (double)thread.cpuTimeNs / 1000000.0;
+        printf("%10llu %6d %14.1f %7.1f%%\n", (unsigned long long)thread.threadId, thread.core, cpuMs, wallSeconds > 0 ? cpuMs / (wallSeconds * 10.0) : 0.0);
+    }
+}
+
+void PrintBlockProfile(ICpu & cpu, uint32_t maxBlocks)
+{
+    std::vector<CpuBlockProfile> blocks(cpu.GetBlockProfile(nullptr, 0));
+    blocks.resize(cpu.GetBlockProfile(blocks.data(), (uint32_t)blocks.size()));
+
+    uint64_t totalSamples = 0;
+    for (const CpuBlockProfile & block : blocks)
+    {
+        totalSamples += block.samples;
+    }
+
+    printf("\n%18s %20s %14s %10s %8s %10s\n", "guest address", "module", "hits", "samples", "time", "host bytes");
+    for (size_t i = 0, n = blocks.size() < maxBlocks ? blocks.size() : maxBlocks; i < n; i++)
+    {
+        const CpuBlockProfile & block = blocks[i];
+        char module[32];
+        if (block.moduleIndex >= 0)
+        {
+            snprintf(module, sizeof(module), "%d+0x%llx", block.moduleIndex, (unsigned long long)block.moduleOffset);
+        }
+        else
+        {
+            snprintf(module, sizeof(module), "-");
+        }
+        printf("0x%016llx %20s %14llu %10llu %7.2f%% %10u\n", (unsigned long long)block.guestAddress, module, (unsigned long long)block.hitCount, (unsigned long long)block.samples, totalSamples != 0 ? block.samples * 100.0 / totalSamples : 0.0, block.hostBytes);
+    }
+    printf("%u blocks profiled, %llu samples\n", (uint32_t)blocks.size(), (unsigned long long)totalSamples);
+}
+
+bool WriteIpcProfile(IOperatingSystem & operatingSystem, const char * fileName)
+{
+    OperatingSystemIpcDispatchStats dispatch = {0};
+    std::vector<OperatingSystemIpcCommandStats> commands(operatingSystem.GetIpcProfile(dispatch, nullptr, 0));
+    commands.resize(operatingSystem.GetIpcProfile(dispatch, commands.data(), (uint32_t)commands.size()));
+
+    FILE * file = fopen(fileName, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    fprintf(file, "service,command,id,tipc,calls,total_us,mean_us,max_us,queue_mean_us,queue_max_us");
+    for (uint32_t i = 0; i + 1 < OperatingSystemIpcHistogramBuckets; i++)
+    {
+        fprintf(file, ",under_%uus", 1u << i);
+    }
+    fprintf(file, ",over_%uus\n", 1u << (OperatingSystemIpcHistogramBuckets - 2));
+
+    uint64_t handlerTimeNs = 0;
+    for (const OperatingSystemIpcCommandStats & command : commands)
+    {
+        fprintf(file, "%s,%s,%u,%u,%llu,%.1f,%.2f,%.1f,%.2f,%.1f", command.service, command.command, command.commandId, command.tipc, (unsigned long long)command.calls,
+                command.handlerTimeNs / 1000.0, command.calls != 0 ? command.handlerTimeNs / 1000.0 / command.calls : 0.0, command.handlerMaxNs / 1000.0,
+                command.calls != 0 ? command.queueTimeNs / 1000.0 / command.calls : 0.0, command.queueMaxNs / 1000.0);
+        for (uint32_t i = 0; i < OperatingSystemIpcHistogramBuckets; i++)
+        {
+            fprintf(file, ",%llu", (unsigned long long)command.handlerHistogram[i]);
+        }
+        fprintf(file, "\n");
+        handlerTimeNs += command.handlerTimeNs;
+    }
+    fclose(file);
+
+    printf("\nipc: %llu requests, %.1f ms processing (%.1f ms in handlers), %.1f ms waiting, %u commands written to %s\n", (unsigned long long)dispatch.requests,
+           dispatch.processTimeNs / 1000000.0, handlerTimeNs / 1000000.0, dispatch.waitTimeNs / 1000000.0, (uint32_t)commands.size(), fileName);
+    return true;
+}
+
+void PrintSummary(const RunSummary & summary)
+{
+    uint64_t frames = summary.endFrame - summary.startFrame;
+    printf("\nframes: %llu in %.1f s (%.1f fps)\n", (unsigned long long)frames, summary.wallSeconds, summary.wallSeconds > 0 ? frames / summary.wallSeconds : 0.0);
+    if (summary.samples != 0)
+    {
+        printf("frametime: mean %.2f ms, min %.2f ms, max %.2f ms\n", summary.frametimeTotal / summary.samples, summary.frametimeMin, summary.frametimeMax);
+        printf("emulation speed: mean %.1f%%\n", summary.speedTotal / summary.samples * 100.0);
+    }
+}
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    HeadlessOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    HeadlessNotification notification;
+    if (!AppInit(&notification))
+    {
+        fprintf(stderr, "Failed to initialize\n");
+        return 1;
+    }
+    Settings::GetInstance().SetBool(NXCoreSetting::NullRenderer, true);
+    Settings::GetInstance().SetBool(NXCoreSetting::JitBlockProfiling, options.profileBlocks != 0);
+    Settings::GetInstance().SetBool(NXCoreSetting::IpcProfiling, !options.ipcProfileFile.empty());
+    Settings::GetInstance().SetBool(NXCoreSetting::SharedServiceHost, options.sharedServices);
+
+    HeadlessRenderWindow window;
+    int exitCode = 1;
+    if (LaunchSwitchRom(window, options.romFile.c_str()))
+    {
+        IOperatingSystem & operatingSystem = SwitchSystem::GetInstance()->OperatingSystem();
+        RunSummary summary = {0};
+        RunRom(operatingSystem, options, summary);
+        PrintThreadTimes(operatingSystem, summary.wallSeconds);
+        if (options.profileBlocks != 0)
+        {
+            PrintBlockProfile(SwitchSystem::GetInstance()->Cpu(), options.profileBlocks);
+        }
+        if (!options.ipcProfileFile.empty() && !WriteIpcProfile(operatingSystem, options.ipcProfileFile.c_str()))
+        {
+            fprintf(stderr, "Failed to write %s\n", options.ipcProfileFile.c_str());
+        }
+        PrintSummary(summary);
+        SwitchSystem::GetInstance()->StopEmulation();
+        exitCode = 0;
+    }
+    else
+    {
+        fprintf(stderr, "Failed to launch %s\n", options.romFile.c_str());
+    }
+    AppCleanup();
+    return exitCode;
+}
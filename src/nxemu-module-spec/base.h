@@ -60,6 +60,21 @@ __interface IRenderWindow
     void * RenderSurface(void) const;
 };
 
+__interface IModuleInfo
+{
+    const uint8_t * Data(void) const = 0;
+    uint32_t DataSize(void) const = 0;
+    uint64_t CodeSegmentAddr(void) const = 0;
+    uint64_t CodeSegmentOffset(void) const = 0;
+    uint64_t CodeSegmentSize(void) const = 0;
+    uint64_t RODataSegmentAddr(void) const = 0;
+    uint64_t RODataSegmentOffset(void) const = 0;
+    uint64_t RODataSegmentSize(void) const = 0;
+    uint64_t DataSegmentAddr(void) const = 0;
+    uint64_t DataSegmentOffset(void) const = 0;
+    uint64_t DataSegmentSize(void) const = 0;
+};
+
 __interface IOperatingSystem;
 __interface IVideo;
 __interface ICpu;
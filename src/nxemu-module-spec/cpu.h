@@ -37,24 +37,61 @@ __interface IArm64Reg
     void SetFPSR(uint32_t value) = 0;
 };
 
+typedef struct
+{
+    uint64_t r[31]; // X0-X28, FP (X29), LR (X30)
+    uint64_t sp;
+    uint64_t pc;
+    uint32_t pstate;
+    uint32_t padding;
+    uint64_t v[32][2]; // Q0-Q31, low doubleword first
+    uint32_t fpcr;
+    uint32_t fpsr;
+    uint64_t tpidr;
+} Arm64ThreadContext;
+
+typedef struct
+{
+    uint64_t x[8]; // X0-X7
+} Arm64SvcArguments;
+
+typedef struct
+{
+    uint64_t blocksCompiled;
+    uint64_t compileTimeNs;
+    uint64_t codeCacheUsed;
+    uint64_t codeCacheSize;
+} Arm64JitStatistics;
+
 __interface IArm64Executor
 {
     enum class HaltReason
     {
         Stopped,
         SupervisorCall,
+        BreakLoop,
     };
 
     IArm64Reg & Reg(void) = 0;
     HaltReason Execute(void) = 0;
     void InvalidateCacheRange(uint64_t addr, uint64_t size) = 0;
-    void HaltExecution(HaltReason hr) = 0;
+    void HaltExecution(HaltReason hr) = 0; // BreakLoop may be requested from any thread while Execute is running
+    void GetContext(Arm64ThreadContext & ctx) = 0;
+    void SetContext(const Arm64ThreadContext & ctx) = 0;
+    void GetSvcArguments(Arm64SvcArguments & args) = 0;
+    void SetSvcArguments(const Arm64SvcArguments & args) = 0;
+    void GetJitStatistics(Arm64JitStatistics & stats) = 0;
 };
 
 __interface IMemory
 {
     void RasterizerMarkRegionCached(uint64_t vaddr, uint64_t size, bool cached) = 0;
     uint8_t * GetPointerSilent(uint64_t vaddr) = 0;
+    void InvalidateRegion(uint64_t vaddr, uint64_t size) = 0;
+    void ** PageTablePointers() = 0;
+    uint32_t PageTableAddressSpaceBits() const = 0;
+    uint32_t PageTableAttributeBits() const = 0;
+    uint8_t * FastmemArena() = 0;
 };
 
 __interface ICpuInfo
@@ -63,6 +100,9 @@ __interface ICpuInfo
     void ServiceCall(uint32_t index) = 0;
     bool ReadMemory(uint64_t addr, uint8_t * buffer, uint32_t len) = 0;
     bool WriteMemory(uint64_t addr, const uint8_t * buffer, uint32_t len) = 0;
+    IMemory & Memory() = 0;
+    void AddTicks(uint64_t ticks) = 0;
+    uint64_t GetTicksRemaining() = 0;
 };
 
 __interface IExclusiveMonitor
@@ -79,6 +119,16 @@ __interface IExclusiveMonitor
     bool ExclusiveWrite64(uint32_t coreIndex, uint64_t addr, uint64_t value) = 0;
 };
 
+typedef struct
+{
+    uint64_t guestAddress;
+    uint64_t moduleOffset; // Offset from the containing module, or the guest address if not in a module
+    uint64_t hitCount;     // Times the block was entered
+    uint64_t samples;      // Host time samples that landed in the block's emitted code
+    uint32_t hostBytes;    // Size of the emitted code
+    int32_t moduleIndex;   // Index of the containing module in load order, -1 if none
+} CpuBlockProfile;
+
 __interface ICpu
 {
     bool Initialize(void) = 0;
@@ -86,8 +136,11 @@ __interface ICpu
     IExclusiveMonitor * CreateExclusiveMonitor(IMemory & memory, uint32_t processorCount) = 0;
     void DestroyExclusiveMonitor(IExclusiveMonitor * monitor) = 0;
 
-    IArm64Executor * CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex) = 0;
+    IArm64Executor * CreateArm64Executor(IExclusiveMonitor * monitor, ICpuInfo & info, uint32_t coreIndex, bool usesWallClock) = 0;
     void DestroyArm64Executor(IArm64Executor * executor) = 0;
+
+    void ModuleLoaded(const IModuleInfo & module, uint64_t baseAddress) = 0;
+    uint32_t GetBlockProfile(CpuBlockProfile * blocks, uint32_t maxCount) = 0;
 };
 
 EXPORT ICpu * CALL CreateCpu(ISwitchSystem & System);
@@ -34,35 +34,67 @@ __interface IProgramMetadata
     const char * GetName() const;
 };
 
-__interface IModuleInfo
+__interface IDeviceMemory
 {
-    const uint8_t * Data(void) const = 0;
-    uint32_t DataSize(void) const = 0;
-    uint64_t CodeSegmentAddr(void) const = 0;
-    uint64_t CodeSegmentOffset(void) const = 0;
-    uint64_t CodeSegmentSize(void) const = 0;
-    uint64_t RODataSegmentAddr(void) const = 0;
-    uint64_t RODataSegmentOffset(void) const = 0;
-    uint64_t RODataSegmentSize(void) const = 0;
-    uint64_t DataSegmentAddr(void) const = 0;
-    uint64_t DataSegmentOffset(void) const = 0;
-    uint64_t DataSegmentSize(void) const = 0;
+    const uint8_t * BackingBasePointer() const = 0;
 };
 
-__interface IDeviceMemory
+typedef struct
 {
-    const uint8_t * BackingBasePointer() const = 0;
+    uint64_t systemFrames;  // System frames presented since the application started
+    double systemFps;       // System frames per second since the last call
+    double averageGameFps;  // Game frames per second since the last call
+    double frametime;       // Mean host seconds per system frame since the last call, excluding waits
+    double emulationSpeed;  // Emulated time / wall time since the last call
+} OperatingSystemPerfStats;
+
+typedef struct
+{
+    uint64_t threadId;
+    int32_t core;
+    uint32_t padding;
+    uint64_t cpuTimeNs; // Emulated time the thread has been scheduled on a core
+} OperatingSystemThreadTime;
+
+enum
+{
+    OperatingSystemIpcHistogramBuckets = 16,
 };
 
+typedef struct
+{
+    char service[64];
+    char command[64];
+    uint32_t commandId;
+    uint32_t tipc;
+    uint64_t calls;
+    uint64_t handlerTimeNs;
+    uint64_t handlerMaxNs;
+    uint64_t queueTimeNs; // Host time from the client sending the request to the handler starting
+    uint64_t queueMaxNs;
+    uint64_t handlerHistogram[OperatingSystemIpcHistogramBuckets]; // Bucket 0 is under 1us, bucket n under 2^n us, the last takes the rest
+} OperatingSystemIpcCommandStats;
+
+typedef struct
+{
+    uint64_t requests;
+    uint64_t waitTimeNs;    // Time service threads spent waiting for a request
+    uint64_t processTimeNs; // Time service threads spent receiving, handling and replying
+} OperatingSystemIpcDispatchStats;
+
 __interface IOperatingSystem
 {
     bool Initialize(void) = 0;
     bool CreateApplicationProcess(uint64_t codeSize, const IProgramMetadata & metaData, uint64_t & baseAddress) = 0;
     void StartApplicationProcess(uint64_t baseAddress, int32_t priority, int64_t stackSize) = 0;
     bool LoadModule(const IModuleInfo & module, uint64_t baseAddress) = 0;
+    bool LoadRomFS(const char * filePath, uint64_t offset, uint64_t size) = 0;
     IDeviceMemory & DeviceMemory(void) = 0;
     void KeyboardKeyPress(int modifier, int keyIndex, int keyCode) = 0;
     void KeyboardKeyRelease(int modifier, int keyIndex, int keyCode) = 0;
+    bool GetAndResetPerfStats(OperatingSystemPerfStats & stats) = 0;
+    uint32_t GetThreadCpuTimes(OperatingSystemThreadTime * times, uint32_t maxCount) = 0;
+    uint32_t GetIpcProfile(OperatingSystemIpcDispatchStats & dispatch, OperatingSystemIpcCommandStats * commands, uint32_t maxCount) = 0;
 };
 
 EXPORT IOperatingSystem * CALL CreateOperatingSystem(ISwitchSystem & System);
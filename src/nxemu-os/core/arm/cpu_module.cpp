@@ -3,6 +3,8 @@
 #include "core/hle/kernel/svc.h"
 #include "core/core_timing.h"
 #include <nxemu-module-spec/cpu.h>
+#include <algorithm>
+#include <cstddef>
 
 namespace Core
 {
@@ -44,6 +46,24 @@ public:
         return m_memory.WriteBlock(addr, buffer, len);
     }
 
+    IMemory & Memory()
+    {
+        return m_memory;
+    }
+
+    void AddTicks(uint64_t ticks)
+    {
+        // Each core adds its own ticks to the shared timer, so divide them across the cores to
+        // approximate the elapsed system time. Always advance by at least one tick.
+        uint64_t amortizedTicks = std::max<uint64_t>(ticks / Core::Hardware::NUM_CPU_CORES, 1);
+        m_system.CoreTiming().AddTicks(amortizedTicks);
+    }
+
+    uint64_t GetTicksRemaining()
+    {
+        return std::max<s64>(m_system.CoreTiming().GetDowncount(), 0);
+    }
+
     IArm64Executor *& m_arm64Executor;
     Kernel::KProcess * m_process{};
     Core::System & m_system;
@@ -59,7 +79,7 @@ ArmCpuModule::ArmCpuModule(Core::System & system, bool is64Bit, bool usesWallClo
 {
     if (is64Bit)
     {
-        m_arm64Executor = system.GetSwitchSystem().Cpu().CreateArm64Executor(process->GetExclusiveMonitor(), *m_cb, coreIndex);    
+        m_arm64Executor = system.GetSwitchSystem().Cpu().CreateArm64Executor(process->GetExclusiveMonitor(), *m_cb, coreIndex, usesWallClock);
     }
 }
 
@@ -85,7 +105,9 @@ HaltReason ArmCpuModule::RunThread(Kernel::KThread * thread)
         IArm64Executor::HaltReason reason = m_arm64Executor->Execute();
         switch (reason)
         {
+        case IArm64Executor::HaltReason::Stopped: return HaltReason{};
         case IArm64Executor::HaltReason::SupervisorCall: return HaltReason::SupervisorCall;
+        case IArm64Executor::HaltReason::BreakLoop: return HaltReason::BreakLoop;
         }
     }
     UNIMPLEMENTED();
@@ -98,28 +120,17 @@ HaltReason ArmCpuModule::StepThread(Kernel::KThread * thread)
     return HaltReason::DataAbort;
 }
 
+static_assert(sizeof(Arm64ThreadContext) == sizeof(Kernel::Svc::ThreadContext));
+static_assert(offsetof(Arm64ThreadContext, sp) == offsetof(Kernel::Svc::ThreadContext, sp));
+static_assert(offsetof(Arm64ThreadContext, v) == offsetof(Kernel::Svc::ThreadContext, v));
+static_assert(offsetof(Arm64ThreadContext, tpidr) == offsetof(Kernel::Svc::ThreadContext, tpidr));
+static_assert(sizeof(Arm64SvcArguments) == sizeof(uint64_t) * 8);
+
 void ArmCpuModule::GetContext(Kernel::Svc::ThreadContext & ctx) const
 {
     if (m_arm64Executor != nullptr)
     {
-        IArm64Reg & reg = m_arm64Executor->Reg();
-        for (size_t i = 0; i < 29; i++)
-        {
-            ctx.r[i] = reg.Get64((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::X0) + i));
-        }
-        ctx.fp = reg.Get64(IArm64Reg::Reg::FP);
-        ctx.lr = reg.Get64(IArm64Reg::Reg::LR);
-
-        ctx.sp = reg.Get64(IArm64Reg::Reg::SP);
-        ctx.pc = reg.Get64(IArm64Reg::Reg::PC);
-        ctx.pstate = reg.Get32(IArm64Reg::Reg::PSTATE);
-        for (size_t i = 0; i < 32; i++)
-        {
-            reg.Get128((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::Q0) + i), ctx.v[i][1], ctx.v[i][0]);
-        }
-        ctx.fpcr = reg.GetFPCR();
-        ctx.fpsr = reg.GetFPSR();
-        ctx.tpidr = reg.Get64(IArm64Reg::Reg::TPIDR_EL0);
+        m_arm64Executor->GetContext(reinterpret_cast<Arm64ThreadContext &>(ctx));
     }
     else
     {
@@ -131,23 +142,7 @@ void ArmCpuModule::SetContext(const Kernel::Svc::ThreadContext & ctx)
 {
     if (m_arm64Executor != nullptr)
     {
-        IArm64Reg & reg = m_arm64Executor->Reg();
-        for (size_t i = 0; i < 29; i++)
-        {
-            reg.Set64((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::X0) + i), ctx.r[i]);
-        }
-        reg.Set64(IArm64Reg::Reg::FP, ctx.fp);
-        reg.Set64(IArm64Reg::Reg::LR, ctx.lr);
-        reg.Set64(IArm64Reg::Reg::SP, ctx.sp);
-        reg.Set64(IArm64Reg::Reg::PC, ctx.pc);
-        reg.Set32(IArm64Reg::Reg::PSTATE, ctx.pstate);
-        for (size_t i = 0; i < 32; i++)
-        {
-            reg.Set128((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::Q0) + i), ctx.v[i][1], ctx.v[i][0]);
-        }
-        reg.SetFPCR(ctx.fpcr);
-        reg.SetFPSR(ctx.fpsr);
-        reg.Set64(IArm64Reg::Reg::TPIDR_EL0, ctx.tpidr);
+        m_arm64Executor->SetContext(reinterpret_cast<const Arm64ThreadContext &>(ctx));
     }
     else
     {
@@ -170,20 +165,12 @@ void ArmCpuModule::SetTpidrroEl0(u64 value)
 
 void ArmCpuModule::GetSvcArguments(std::span<uint64_t, 8> args) const
 {
-    IArm64Reg & reg = m_arm64Executor->Reg();
-    for (size_t i = 0; i < 8; i++)
-    {
-        args[i] = reg.Get64((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::X0) + i));
-    }
+    m_arm64Executor->GetSvcArguments(*reinterpret_cast<Arm64SvcArguments *>(args.data()));
 }
 
 void ArmCpuModule::SetSvcArguments(std::span<const uint64_t, 8> args)
 {
-    IArm64Reg & reg = m_arm64Executor->Reg();
-    for (size_t i = 0; i < 8; i++)
-    {
-        reg.Set64((IArm64Reg::Reg)(((uint32_t)IArm64Reg::Reg::X0) + i), args[i]);
-    }
+    m_arm64Executor->SetSvcArguments(*reinterpret_cast<const Arm64SvcArguments *>(args.data()));
 }
 
 u32 ArmCpuModule::GetSvcNumber() const
@@ -193,7 +180,16 @@ u32 ArmCpuModule::GetSvcNumber() const
 
 void ArmCpuModule::SignalInterrupt(Kernel::KThread * thread)
 {
-    UNIMPLEMENTED();
+    // Called by PhysicalCore::Interrupt from another host thread, the halt is latched by the jit so it
+    // also stops a run that is only just starting
+    if (m_arm64Executor != nullptr)
+    {
+        m_arm64Executor->HaltExecution(IArm64Executor::HaltReason::BreakLoop);
+    }
+    else
+    {
+        UNIMPLEMENTED();
+    }
 }
 
 void ArmCpuModule::ClearInstructionCache()
@@ -10,6 +10,7 @@
 #include "core/cpu_manager.h"
 #include "core/debugger/debugger.h"
 #include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs/vfs_real.h"
 #include "core/gpu_dirty_memory_manager.h"
 #include "core/hle/kernel/k_memory_manager.h"
 #include "core/hle/kernel/k_process.h"
@@ -21,6 +22,7 @@
 #include "core/hle/service/am/frontend/applets.h"
 #include "core/hle/service/apm/apm_controller.h"
 #include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/services.h"
 #include "core/perf_stats.h"
 #include "yuzu_hid_core/hid_core.h"
@@ -52,6 +54,11 @@ struct System::Impl {
             content_provider = std::make_unique<FileSys::ContentProviderUnion>();
         }
 
+        if (virtual_filesystem == nullptr) {
+            virtual_filesystem = std::make_shared<FileSys::RealVfsFilesystem>();
+        }
+        fs_controller.CreateFactories(*virtual_filesystem);
+
         // Create default implementations of applets if one is not provided.
         frontend_applets.SetDefaultAppletsIfMissing();
 
@@ -166,6 +173,7 @@ struct System::Impl {
 
     Timing::CoreTiming core_timing;
     Kernel::KernelCore kernel;
+    FileSys::VirtualFilesystem virtual_filesystem;
     std::unique_ptr<FileSys::ContentProviderUnion> content_provider;
     Service::FileSystem::FileSystemController fs_controller;
     std::unique_ptr<Core::DeviceMemory> device_memory;
@@ -196,6 +204,8 @@ struct System::Impl {
     /// Services
     std::unique_ptr<Service::Services> services;
 
+    Service::IpcProfiler ipc_profiler;
+
     std::unique_ptr<Core::PerfStats> perf_stats;
     Core::SpeedLimiter speed_limiter;
 
@@ -327,6 +337,10 @@ const Timing::CoreTiming& System::CoreTiming() const {
     return impl->core_timing;
 }
 
+PerfStatsResults System::GetAndResetPerfStats() {
+    return impl->GetAndResetPerfStats();
+}
+
 Core::PerfStats& System::GetPerfStats() {
     return *impl->perf_stats;
 }
@@ -388,6 +402,14 @@ const FileSys::ContentProviderUnion& System::GetContentProviderUnion() const {
     return *impl->content_provider;
 }
 
+void System::SetFilesystem(FileSys::VirtualFilesystem vfs) {
+    impl->virtual_filesystem = std::move(vfs);
+}
+
+FileSys::VirtualFilesystem System::GetFilesystem() const {
+    return impl->virtual_filesystem;
+}
+
 Service::FileSystem::FileSystemController& System::GetFileSystemController() {
     return impl->fs_controller;
 }
@@ -436,6 +458,10 @@ const Service::SM::ServiceManager& System::ServiceManager() const {
     return *impl->service_manager;
 }
 
+Service::IpcProfiler& System::IpcProfiler() {
+    return impl->ipc_profiler;
+}
+
 void System::RegisterCoreThread(std::size_t id) {
     impl->kernel.RegisterCoreThread(id);
 }
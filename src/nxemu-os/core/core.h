@@ -75,6 +75,7 @@ namespace Glue {
 class ARPManager;
 }
 
+class IpcProfiler;
 class ServerManager;
 
 namespace SM {
@@ -329,6 +330,9 @@ public:
     [[nodiscard]] Service::SM::ServiceManager& ServiceManager();
     [[nodiscard]] const Service::SM::ServiceManager& ServiceManager() const;
 
+    /// Provides a reference to the HLE IPC request profiler.
+    [[nodiscard]] Service::IpcProfiler& IpcProfiler();
+
     void SetFilesystem(FileSys::VirtualFilesystem vfs);
 
     [[nodiscard]] FileSys::VirtualFilesystem GetFilesystem() const;
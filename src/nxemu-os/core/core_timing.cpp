@@ -31,17 +31,10 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::weak_ptr<EventType> type;
     s64 reschedule_time;
-    heap_t::handle_type handle{};
-
-    // Sort by time, unless the times are the same, in which case sort by
-    // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
-
-    friend bool operator<(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-    }
+    u32 queue_index;
+    // Neighbours in the owning event type's list of scheduled slots
+    u32 prev_scheduled;
+    u32 next_scheduled;
 };
 
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
@@ -73,7 +66,14 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 
 void CoreTiming::ClearPendingEvents() {
     std::scoped_lock lock{advance_lock, basic_lock};
+    for (const u32 slot : event_queue) {
+        if (const auto event_type{event_slots[slot].type.lock()}) {
+            event_type->scheduled_head = InvalidEventSlot;
+        }
+    }
     event_queue.clear();
+    event_slots.clear();
+    free_event_slots.clear();
     event.Set();
 }
 
@@ -121,8 +121,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
 
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
+        PushEvent(next_time.count(), event_type, 0);
     }
 
     event.Set();
@@ -136,9 +135,7 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
 
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
+        PushEvent(next_time.count(), event_type, resched_time.count());
     }
 
     event.Set();
@@ -149,16 +146,8 @@ void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
     {
         std::scoped_lock lk{basic_lock};
 
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
+        while (event_type->scheduled_head != InvalidEventSlot) {
+            RemoveEvent(event_type->scheduled_head, event_type.get());
         }
 
         event_type->sequence_number++;
@@ -201,61 +190,176 @@ std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
+    while (!event_queue.empty() && event_slots[event_queue.front()].time <= global_timer) {
+        const u32 slot = event_queue.front();
+        const auto event_type{event_slots[slot].type.lock()};
 
-        if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
-            const auto evt_sequence_num = event_type->sequence_number;
+        if (!event_type) {
+            // The owner released the event type without unscheduling it
+            RemoveEvent(slot, nullptr);
+            continue;
+        }
 
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
+        const auto evt_time = event_slots[slot].time;
+        const auto evt_reschedule_time = event_slots[slot].reschedule_time;
+        const auto evt_sequence_num = event_type->sequence_number;
 
-                basic_lock.unlock();
+        if (evt_reschedule_time == 0) {
+            RemoveEvent(slot, event_type.get());
 
-                event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
+            basic_lock.unlock();
 
-                basic_lock.lock();
-            } else {
-                basic_lock.unlock();
+            event_type->callback(
+                evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
 
-                const auto new_schedule_time{event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+            basic_lock.lock();
+        } else {
+            basic_lock.unlock();
 
-                basic_lock.lock();
+            const auto new_schedule_time{event_type->callback(
+                evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
 
-                if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
-                    continue;
-                }
+            basic_lock.lock();
 
-                const auto next_schedule_time{new_schedule_time.has_value()
-                                                  ? new_schedule_time.value().count()
-                                                  : evt.reschedule_time};
+            if (evt_sequence_num != event_type->sequence_number) {
+                // The slot was released when the event was unscheduled.
+                continue;
+            }
 
-                // If this event was scheduled into a pause, its time now is going to be way
-                // behind. Re-set this event to continue from the end of the pause.
-                auto next_time{evt.time + next_schedule_time};
-                if (evt.time < pause_end_time) {
-                    next_time = pause_end_time + next_schedule_time;
-                }
+            const auto next_schedule_time{new_schedule_time.has_value()
+                                              ? new_schedule_time.value().count()
+                                              : evt_reschedule_time};
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+            // If this event was scheduled into a pause, its time now is going to be way
+            // behind. Re-set this event to continue from the end of the pause.
+            auto next_time{evt_time + next_schedule_time};
+            if (evt_time < pause_end_time) {
+                next_time = pause_end_time + next_schedule_time;
             }
+
+            // The callback may have scheduled other events, so the slot is looked up again.
+            // Its time only moves forward, so it can only sink in the queue.
+            Event& evt = event_slots[slot];
+            evt.time = next_time;
+            evt.fifo_order = event_fifo_id++;
+            evt.reschedule_time = next_schedule_time;
+            SiftDown(evt.queue_index);
         }
 
         global_timer = GetGlobalTimeNs().count();
     }
 
     if (!event_queue.empty()) {
-        return event_queue.top().time;
+        return event_slots[event_queue.front()].time;
     } else {
         return std::nullopt;
     }
 }
 
+void CoreTiming::PushEvent(s64 time, const std::shared_ptr<EventType>& event_type,
+                           s64 reschedule_time) {
+    u32 slot;
+    if (!free_event_slots.empty()) {
+        slot = free_event_slots.back();
+        free_event_slots.pop_back();
+    } else {
+        slot = static_cast<u32>(event_slots.size());
+        event_slots.emplace_back();
+    }
+
+    Event& evt = event_slots[slot];
+    evt.time = time;
+    evt.fifo_order = event_fifo_id++;
+    evt.type = event_type;
+    evt.reschedule_time = reschedule_time;
+    evt.queue_index = static_cast<u32>(event_queue.size());
+
+    // Link at the front of the event type's list
+    evt.prev_scheduled = InvalidEventSlot;
+    evt.next_scheduled = event_type->scheduled_head;
+    if (evt.next_scheduled != InvalidEventSlot) {
+        event_slots[evt.next_scheduled].prev_scheduled = slot;
+    }
+    event_type->scheduled_head = slot;
+
+    event_queue.push_back(slot);
+    SiftUp(evt.queue_index);
+}
+
+void CoreTiming::RemoveEvent(u32 slot, EventType* event_type) {
+    Event& evt = event_slots[slot];
+
+    const size_t index = evt.queue_index;
+    const u32 last = event_queue.back();
+    event_queue.pop_back();
+    if (index < event_queue.size()) {
+        event_queue[index] = last;
+        event_slots[last].queue_index = static_cast<u32>(index);
+        SiftUp(index);
+        SiftDown(event_slots[last].queue_index);
+    }
+
+    // An expired event type took its list with it, nothing else can reference this slot
+    if (event_type != nullptr) {
+        if (evt.prev_scheduled != InvalidEventSlot) {
+            event_slots[evt.prev_scheduled].next_scheduled = evt.next_scheduled;
+        } else {
+            event_type->scheduled_head = evt.next_scheduled;
+        }
+        if (evt.next_scheduled != InvalidEventSlot) {
+            event_slots[evt.next_scheduled].prev_scheduled = evt.prev_scheduled;
+        }
+    }
+
+    evt.type.reset();
+    free_event_slots.push_back(slot);
+}
+
+bool CoreTiming::EventBefore(u32 left, u32 right) const {
+    // Sort by time, unless the times are the same, in which case sort by
+    // the order added to the queue
+    const Event& l = event_slots[left];
+    const Event& r = event_slots[right];
+    return std::tie(l.time, l.fifo_order) < std::tie(r.time, r.fifo_order);
+}
+
+void CoreTiming::SiftUp(size_t index) {
+    const u32 slot = event_queue[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (!EventBefore(slot, event_queue[parent])) {
+            break;
+        }
+        event_queue[index] = event_queue[parent];
+        event_slots[event_queue[index]].queue_index = static_cast<u32>(index);
+        index = parent;
+    }
+    event_queue[index] = slot;
+    event_slots[slot].queue_index = static_cast<u32>(index);
+}
+
+void CoreTiming::SiftDown(size_t index) {
+    const u32 slot = event_queue[index];
+    const size_t size = event_queue.size();
+    while (true) {
+        size_t child = index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && EventBefore(event_queue[child + 1], event_queue[child])) {
+            child++;
+        }
+        if (!EventBefore(event_queue[child], slot)) {
+            break;
+        }
+        event_queue[index] = event_queue[child];
+        event_slots[event_queue[index]].queue_index = static_cast<u32>(index);
+        index = child;
+    }
+    event_queue[index] = slot;
+    event_slots[slot].queue_index = static_cast<u32>(index);
+}
+
 void CoreTiming::ThreadLoop() {
     has_started = true;
     while (!shutting_down) {
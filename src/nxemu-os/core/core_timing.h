@@ -6,13 +6,13 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
-
-#include <boost/heap/fibonacci_heap.hpp>
+#include <vector>
 
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/thread.h"
@@ -24,6 +24,9 @@ namespace Core::Timing {
 using TimedCallback = std::function<std::optional<std::chrono::nanoseconds>(
     s64 time, std::chrono::nanoseconds ns_late)>;
 
+/// Marks the end of an event type's list of scheduled queue slots.
+constexpr u32 InvalidEventSlot = std::numeric_limits<u32>::max();
+
 /// Contains the characteristics of a particular event.
 struct EventType {
     explicit EventType(TimedCallback&& callback_, std::string&& name_)
@@ -36,6 +39,9 @@ struct EventType {
     /// A monotonic sequence number, incremented when this event is
     /// changed externally.
     size_t sequence_number;
+    /// First of the queue slots this event is currently scheduled in. Owned by CoreTiming and
+    /// only accessed under its lock, it lets the event be unscheduled without searching the queue.
+    u32 scheduled_head{InvalidEventSlot};
 };
 
 enum class UnscheduleEventType {
@@ -146,6 +152,12 @@ private:
 
     void Reset();
 
+    void PushEvent(s64 time, const std::shared_ptr<EventType>& event_type, s64 reschedule_time);
+    void RemoveEvent(u32 slot, EventType* event_type);
+    void SiftUp(size_t index);
+    void SiftDown(size_t index);
+    bool EventBefore(u32 left, u32 right) const;
+
     std::unique_ptr<Common::WallClock> clock;
 
     s64 global_timer = 0;
@@ -154,10 +166,11 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
-
-    heap_t event_queue;
+    /// Scheduled events live in recycled slots, the queue is a binary min heap of slot indices and
+    /// every slot tracks its position in it so any event can be removed without a search.
+    std::vector<Event> event_slots;
+    std::vector<u32> free_event_slots;
+    std::vector<u32> event_queue;
     u64 event_fifo_id = 0;
 
     Common::Event event{};
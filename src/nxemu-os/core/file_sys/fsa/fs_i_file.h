@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "core/file_sys/errors.h"
+#include "core/file_sys/fs_file.h"
+#include "core/file_sys/fs_filesystem.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/hle/result.h"
+
+namespace FileSys::Fsa {
+
+class IFile {
+public:
+    explicit IFile(VirtualFile backend_) : backend(std::move(backend_)) {}
+    virtual ~IFile() {}
+
+    Result Read(size_t* out, s64 offset, void* buffer, size_t size, const ReadOption& option) {
+        // Check that we have an output pointer
+        R_UNLESS(out != nullptr, ResultNullptrArgument);
+
+        // If we have nothing to read, just succeed
+        if (size == 0) {
+            *out = 0;
+            R_SUCCEED();
+        }
+
+        // Check that the read is valid
+        R_UNLESS(buffer != nullptr, ResultNullptrArgument);
+        R_UNLESS(offset >= 0, ResultOutOfRange);
+        const s64 signed_size = static_cast<s64>(size);
+        R_UNLESS(signed_size >= 0, ResultOutOfRange);
+        R_UNLESS((std::numeric_limits<s64>::max() - offset) >= signed_size, ResultOutOfRange);
+
+        // Do the read
+        R_RETURN(this->DoRead(out, offset, buffer, size, option));
+    }
+
+    Result Read(size_t* out, s64 offset, void* buffer, size_t size) {
+        R_RETURN(this->Read(out, offset, buffer, size, ReadOption::None));
+    }
+
+    Result GetSize(s64* out) {
+        R_UNLESS(out != nullptr, ResultNullptrArgument);
+        R_RETURN(this->DoGetSize(out));
+    }
+
+    Result Flush() {
+        R_RETURN(this->DoFlush());
+    }
+
+    Result Write(s64 offset, const void* buffer, size_t size, const WriteOption& option) {
+        // Handle the zero-size case
+        if (size == 0) {
+            if (option.HasFlushFlag()) {
+                R_TRY(this->Flush());
+            }
+            R_SUCCEED();
+        }
+
+        // Check the write is valid
+        R_UNLESS(buffer != nullptr, ResultNullptrArgument);
+        R_UNLESS(offset >= 0, ResultOutOfRange);
+        const s64 signed_size = static_cast<s64>(size);
+        R_UNLESS(signed_size >= 0, ResultOutOfRange);
+        R_UNLESS((std::numeric_limits<s64>::max() - offset) >= signed_size, ResultOutOfRange);
+
+        R_RETURN(this->DoWrite(offset, buffer, size, option));
+    }
+
+    Result SetSize(s64 size) {
+        R_UNLESS(size >= 0, ResultOutOfRange);
+        R_RETURN(this->DoSetSize(size));
+    }
+
+private:
+    Result DoRead(size_t* out, s64 offset, void* buffer, size_t size, const ReadOption& option) {
+        const s64 file_size = static_cast<s64>(backend->GetSize());
+        R_UNLESS(offset <= file_size, ResultOutOfRange);
+
+        *out = backend->Read(static_cast<u8*>(buffer),
+                             std::min(size, static_cast<size_t>(file_size - offset)), offset);
+        R_SUCCEED();
+    }
+
+    Result DoGetSize(s64* out) {
+        *out = backend->GetSize();
+        R_SUCCEED();
+    }
+
+    Result DoFlush() {
+        // Writes go straight to the host file, there is nothing to flush.
+        R_SUCCEED();
+    }
+
+    Result DoWrite(s64 offset, const void* buffer, size_t size, const WriteOption& option) {
+        const std::size_t written = backend->Write(static_cast<const u8*>(buffer), size, offset);
+        R_UNLESS(written == size, ResultWriteNotPermitted);
+        R_SUCCEED();
+    }
+
+    Result DoSetSize(s64 size) {
+        R_UNLESS(backend->Resize(size), ResultWriteNotPermitted);
+        R_SUCCEED();
+    }
+
+    VirtualFile backend;
+};
+
+} // namespace FileSys::Fsa
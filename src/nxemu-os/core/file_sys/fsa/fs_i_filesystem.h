@@ -163,7 +163,7 @@ private:
     }
 
     Result DoCommit() {
-        R_THROW(ResultNotImplemented);
+        R_RETURN(backend.Commit());
     }
 
     Result DoGetFreeSpaceSize(s64* out, const Path& path) {
@@ -0,0 +1,419 @@
+// SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_common/swap.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
+
+namespace FileSys {
+namespace {
+
+constexpr u32 ROMFS_ENTRY_EMPTY = 0xFFFFFFFF;
+
+struct TableLocation {
+    u64_le offset;
+    u64_le size;
+};
+static_assert(sizeof(TableLocation) == 0x10, "TableLocation has incorrect size.");
+
+struct RomFSHeader {
+    u64_le header_size;
+    TableLocation directory_hash;
+    TableLocation directory_meta;
+    TableLocation file_hash;
+    TableLocation file_meta;
+    u64_le data_offset;
+};
+static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
+
+struct DirectoryEntry {
+    u32_le parent;
+    u32_le sibling;
+    u32_le child_dir;
+    u32_le child_file;
+    u32_le hash;
+    u32_le name_length;
+};
+static_assert(sizeof(DirectoryEntry) == 0x18, "DirectoryEntry has incorrect size.");
+
+struct FileEntry {
+    u32_le parent;
+    u32_le sibling;
+    u64_le offset;
+    u64_le size;
+    u32_le hash;
+    u32_le name_length;
+};
+static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
+
+struct PathHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view path) const {
+        return std::hash<std::string_view>{}(path);
+    }
+};
+
+using PathLookup = std::unordered_map<std::string, u32, PathHash, std::equal_to<>>;
+
+// The file and directory tables of a RomFS image, flattened once into arrays with a hash of every
+// full path so lookups don't have to walk the sibling chains of the image.
+struct RomFSIndex {
+    struct Directory {
+        std::string path;
+        std::size_t name_offset;
+        u32 parent;
+        std::vector<u32> subdirectories;
+        std::vector<u32> files;
+    };
+
+    struct File {
+        std::string path;
+        std::size_t name_offset;
+        u32 parent;
+        u64 offset;
+        u64 size;
+    };
+
+    VirtualFile backing;
+    std::shared_ptr<const MappedVfsFile> mapped;
+    u64 data_offset{};
+
+    std::vector<Directory> directories;
+    std::vector<File> files;
+    PathLookup directory_lookup;
+    PathLookup file_lookup;
+};
+
+template <typename T>
+bool ReadEntry(std::span<const u8> table, u64 offset, T& entry, std::string_view& name) {
+    if (offset > table.size() || table.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&entry, table.data() + offset, sizeof(T));
+    const u64 name_offset = offset + sizeof(T);
+    if (entry.name_length > table.size() - name_offset) {
+        return false;
+    }
+    name = std::string_view(reinterpret_cast<const char*>(table.data() + name_offset),
+                            entry.name_length);
+    return true;
+}
+
+std::string JoinPath(std::string_view parent, std::string_view name) {
+    std::string path;
+    path.reserve(parent.size() + name.size() + 1);
+    path.append(parent);
+    if (!parent.empty()) {
+        path.push_back('/');
+    }
+    path.append(name);
+    return path;
+}
+
+// Converts a path relative to base into the form used as a key in the index: no leading, trailing
+// or repeated separators, no "." or ".." components and '/' as the separator. ".." past the root
+// stays at the root.
+std::string NormalizePath(std::string_view base, std::string_view path) {
+    std::string out(base);
+    std::size_t begin = 0;
+    while (begin < path.size()) {
+        std::size_t end = path.find_first_of("/\\", begin);
+        if (end == std::string_view::npos) {
+            end = path.size();
+        }
+        const std::string_view component = path.substr(begin, end - begin);
+        if (component == "..") {
+            const auto pos = out.rfind('/');
+            out.resize(pos == std::string::npos ? 0 : pos);
+        } else if (!component.empty() && component != ".") {
+            if (!out.empty()) {
+                out.push_back('/');
+            }
+            out.append(component);
+        }
+        begin = end + 1;
+    }
+    return out;
+}
+
+std::shared_ptr<RomFSIndex> BuildIndex(VirtualFile file) {
+    auto index = std::make_shared<RomFSIndex>();
+    index->backing = file;
+    index->mapped = std::dynamic_pointer_cast<const MappedVfsFile>(file);
+
+    RomFSHeader header{};
+    if (file->ReadObject(&header) != sizeof(RomFSHeader) ||
+        header.header_size != sizeof(RomFSHeader)) {
+        return nullptr;
+    }
+
+    const auto read_table = [&](const TableLocation& location, std::vector<u8>& storage) {
+        if (location.offset > file->GetSize() || location.size > file->GetSize() - location.offset) {
+            return std::span<const u8>{};
+        }
+        if (index->mapped != nullptr) {
+            return index->mapped->GetData().subspan(location.offset, location.size);
+        }
+        storage = file->ReadBytes(location.size, location.offset);
+        return std::span<const u8>{storage};
+    };
+
+    std::vector<u8> directory_storage;
+    std::vector<u8> file_storage;
+    const auto directory_table = read_table(header.directory_meta, directory_storage);
+    const auto file_table = read_table(header.file_meta, file_storage);
+    if (directory_table.size() < sizeof(DirectoryEntry) || header.data_offset > file->GetSize()) {
+        return nullptr;
+    }
+    index->data_offset = header.data_offset;
+    const u64 data_size = file->GetSize() - header.data_offset;
+
+    // Every entry is at least its header in size, which bounds a walk of a malformed image
+    const std::size_t max_directories = directory_table.size() / sizeof(DirectoryEntry);
+    const std::size_t max_files = file_table.size() / sizeof(FileEntry);
+
+    std::vector<std::pair<u32, u32>> pending{{0, ROMFS_ENTRY_EMPTY}};
+    while (!pending.empty()) {
+        const auto [directory_offset, parent] = pending.back();
+        pending.pop_back();
+
+        DirectoryEntry entry{};
+        std::string_view name;
+        if (index->directories.size() >= max_directories ||
+            !ReadEntry(directory_table, directory_offset, entry, name)) {
+            LOG_ERROR(Service_FS, "Invalid RomFS directory entry at offset {:X}", directory_offset);
+            return nullptr;
+        }
+
+        const u32 directory_index = static_cast<u32>(index->directories.size());
+        std::string path = parent == ROMFS_ENTRY_EMPTY
+                               ? std::string{}
+                               : JoinPath(index->directories[parent].path, name);
+        const std::size_t name_offset = path.size() - std::min(path.size(), name.size());
+        if (parent != ROMFS_ENTRY_EMPTY) {
+            index->directories[parent].subdirectories.push_back(directory_index);
+        }
+        index->directory_lookup.emplace(path, directory_index);
+        index->directories.push_back({std::move(path), name_offset, parent, {}, {}});
+
+        for (u32 file_offset = entry.child_file; file_offset != ROMFS_ENTRY_EMPTY;) {
+            FileEntry file_entry{};
+            std::string_view file_name;
+            if (index->files.size() >= max_files ||
+                !ReadEntry(file_table, file_offset, file_entry, file_name) ||
+                file_entry.offset > data_size || file_entry.size > data_size - file_entry.offset) {
+                LOG_ERROR(Service_FS, "Invalid RomFS file entry at offset {:X}", file_offset);
+                return nullptr;
+            }
+
+            const u32 file_index = static_cast<u32>(index->files.size());
+            std::string file_path = JoinPath(index->directories[directory_index].path, file_name);
+            const std::size_t file_name_offset = file_path.size() - file_name.size();
+            index->directories[directory_index].files.push_back(file_index);
+            index->file_lookup.emplace(file_path, file_index);
+            index->files.push_back({std::move(file_path), file_name_offset, directory_index,
+                                    file_entry.offset, file_entry.size});
+            file_offset = file_entry.sibling;
+        }
+
+        // Siblings are pushed in reverse so the children are visited in table order
+        const std::size_t first_child = pending.size();
+        for (u32 child_offset = entry.child_dir; child_offset != ROMFS_ENTRY_EMPTY;) {
+            DirectoryEntry child{};
+            std::string_view child_name;
+            if (pending.size() - first_child >= max_directories ||
+                !ReadEntry(directory_table, child_offset, child, child_name)) {
+                LOG_ERROR(Service_FS, "Invalid RomFS directory entry at offset {:X}",
+                          child_offset);
+                return nullptr;
+            }
+            pending.emplace_back(child_offset, directory_index);
+            child_offset = child.sibling;
+        }
+        std::reverse(pending.begin() + first_child, pending.end());
+    }
+
+    return index;
+}
+
+class RomFSDirectory;
+
+class RomFSFile final : public VfsFile {
+public:
+    RomFSFile(std::shared_ptr<const RomFSIndex> index_, u32 file_index_)
+        : index(std::move(index_)), file_index(file_index_) {}
+
+    std::string GetName() const override {
+        const auto& file = index->files[file_index];
+        return file.path.substr(file.name_offset);
+    }
+
+    std::size_t GetSize() const override {
+        return index->files[file_index].size;
+    }
+
+    bool Resize(std::size_t new_size) override {
+        return false;
+    }
+
+    VirtualDir GetContainingDirectory() const override;
+
+    bool IsWritable() const override {
+        return false;
+    }
+
+    bool IsReadable() const override {
+        return true;
+    }
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        const auto& file = index->files[file_index];
+        if (offset >= file.size) {
+            return 0;
+        }
+        const auto read_size = static_cast<std::size_t>(std::min<u64>(length, file.size - offset));
+        const u64 image_offset = index->data_offset + file.offset + offset;
+        if (index->mapped != nullptr) {
+            std::memcpy(data, index->mapped->GetData().data() + image_offset, read_size);
+            return read_size;
+        }
+        return index->backing->Read(data, read_size, image_offset);
+    }
+
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override {
+        return 0;
+    }
+
+    bool Rename(std::string_view name) override {
+        return false;
+    }
+
+    std::string GetFullPath() const override {
+        return '/' + index->files[file_index].path;
+    }
+
+private:
+    std::shared_ptr<const RomFSIndex> index;
+    u32 file_index;
+};
+
+class RomFSDirectory final : public ReadOnlyVfsDirectory {
+public:
+    RomFSDirectory(std::shared_ptr<const RomFSIndex> index_, u32 directory_index_)
+        : index(std::move(index_)), directory_index(directory_index_) {}
+
+    std::vector<VirtualFile> GetFiles() const override {
+        const auto& children = index->directories[directory_index].files;
+        std::vector<VirtualFile> out;
+        out.reserve(children.size());
+        for (const u32 child : children) {
+            out.push_back(std::make_shared<RomFSFile>(index, child));
+        }
+        return out;
+    }
+
+    std::vector<VirtualDir> GetSubdirectories() const override {
+        const auto& children = index->directories[directory_index].subdirectories;
+        std::vector<VirtualDir> out;
+        out.reserve(children.size());
+        for (const u32 child : children) {
+            out.push_back(std::make_shared<RomFSDirectory>(index, child));
+        }
+        return out;
+    }
+
+    VirtualFile GetFileRelative(std::string_view path) const override {
+        const auto iter = index->file_lookup.find(
+            NormalizePath(index->directories[directory_index].path, path));
+        if (iter == index->file_lookup.end()) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSFile>(index, iter->second);
+    }
+
+    VirtualDir GetDirectoryRelative(std::string_view path) const override {
+        const auto iter = index->directory_lookup.find(
+            NormalizePath(index->directories[directory_index].path, path));
+        if (iter == index->directory_lookup.end()) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSDirectory>(index, iter->second);
+    }
+
+    VirtualFile GetFile(std::string_view name) const override {
+        return GetFileRelative(name);
+    }
+
+    VirtualDir GetSubdirectory(std::string_view name) const override {
+        return GetDirectoryRelative(name);
+    }
+
+    std::string GetName() const override {
+        const auto& directory = index->directories[directory_index];
+        return directory.path.substr(directory.name_offset);
+    }
+
+    VirtualDir GetParentDirectory() const override {
+        const u32 parent = index->directories[directory_index].parent;
+        if (parent == ROMFS_ENTRY_EMPTY) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSDirectory>(index, parent);
+    }
+
+    std::map<std::string, VfsEntryType, std::less<>> GetEntries() const override {
+        const auto& directory = index->directories[directory_index];
+        std::map<std::string, VfsEntryType, std::less<>> out;
+        for (const u32 child : directory.subdirectories) {
+            const auto& entry = index->directories[child];
+            out.emplace(entry.path.substr(entry.name_offset), VfsEntryType::Directory);
+        }
+        for (const u32 child : directory.files) {
+            const auto& entry = index->files[child];
+            out.emplace(entry.path.substr(entry.name_offset), VfsEntryType::File);
+        }
+        return out;
+    }
+
+    std::string GetFullPath() const override {
+        return '/' + index->directories[directory_index].path;
+    }
+
+private:
+    std::shared_ptr<const RomFSIndex> index;
+    u32 directory_index;
+};
+
+VirtualDir RomFSFile::GetContainingDirectory() const {
+    return std::make_shared<RomFSDirectory>(index, index->files[file_index].parent);
+}
+
+} // Anonymous namespace
+
+VirtualDir ExtractRomFS(VirtualFile file) {
+    if (file == nullptr) {
+        return nullptr;
+    }
+
+    auto index = BuildIndex(std::move(file));
+    if (index == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<RomFSDirectory>(std::move(index), 0);
+}
+
+} // namespace FileSys
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "yuzu_common/common_funcs.h"
 #include "yuzu_common/common_types.h"
@@ -17,6 +19,8 @@ class System;
 
 namespace FileSys {
 
+class WriteBackVfsStore;
+
 constexpr const char* GetSaveDataSizeFileName() {
     return ".yuzu_save_size";
 }
@@ -51,6 +55,11 @@ private:
     ProgramId program_id;
     VirtualDir dir;
     bool auto_create{true};
+
+    // Opened save data is served from an in memory write back store per save directory, so
+    // every open of the same save shares one view and only IFileSystem::Commit reaches the host.
+    mutable std::mutex stores_lock;
+    mutable std::map<std::string, std::shared_ptr<WriteBackVfsStore>, std::less<>> stores;
 };
 
 } // namespace FileSys
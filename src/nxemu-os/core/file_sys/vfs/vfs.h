@@ -284,6 +284,10 @@ public:
 
     // Returns the full path of this directory as a string, recursively
     virtual std::string GetFullPath() const;
+
+    // Writes any changes buffered under this directory through to its backing storage. Returns
+    // whether or not the changes were accepted; directories without buffering have nothing to do.
+    virtual bool Commit();
 };
 
 // A convenience partial-implementation of VfsDirectory that stubs out methods that should only work
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "core/file_sys/vfs/vfs_mapped.h"
+#include "yuzu_common/fs/file_mapping.h"
+#include "yuzu_common/fs/fs_util.h"
+
+namespace FileSys {
+
+MappedVfsFile::MappedVfsFile(std::shared_ptr<const Common::FS::FileMapping> mapping_, u64 offset_,
+                             u64 size_, std::string name_, VirtualDir parent_)
+    : mapping(std::move(mapping_)), offset(offset_), size(size_), name(std::move(name_)),
+      parent(std::move(parent_)) {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+std::shared_ptr<MappedVfsFile> MappedVfsFile::Open(std::string_view path, u64 offset, u64 size,
+                                                   std::string name) {
+    auto mapping = std::make_shared<Common::FS::FileMapping>(Common::FS::ToU8String(path));
+    if (!mapping->IsMapped() || offset > mapping->Size() || size > mapping->Size() - offset) {
+        return nullptr;
+    }
+    return std::make_shared<MappedVfsFile>(std::move(mapping), offset, size, std::move(name));
+}
+
+std::string MappedVfsFile::GetName() const {
+    return name;
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return size;
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir MappedVfsFile::GetContainingDirectory() const {
+    return parent;
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t r_offset) const {
+    if (r_offset >= size) {
+        return 0;
+    }
+    const auto read_size = static_cast<std::size_t>(std::min<u64>(length, size - r_offset));
+    std::memcpy(data, mapping->Data() + offset + r_offset, read_size);
+    return read_size;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t w_offset) {
+    return 0;
+}
+
+bool MappedVfsFile::Rename(std::string_view new_name) {
+    return false;
+}
+
+std::span<const u8> MappedVfsFile::GetData() const {
+    return {mapping->Data() + offset, static_cast<std::size_t>(size)};
+}
+
+std::shared_ptr<MappedVfsFile> MappedVfsFile::Slice(u64 s_offset, u64 s_size, std::string s_name,
+                                                    VirtualDir s_parent) const {
+    if (s_offset > size || s_size > size - s_offset) {
+        return nullptr;
+    }
+    return std::make_shared<MappedVfsFile>(mapping, offset + s_offset, s_size, std::move(s_name),
+                                           std::move(s_parent));
+}
+
+} // namespace FileSys
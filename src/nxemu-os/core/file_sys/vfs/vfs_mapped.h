@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include "core/file_sys/vfs/vfs.h"
+
+namespace Common::FS {
+class FileMapping;
+}
+
+namespace FileSys {
+
+// A read-only VfsFile over a range of a memory mapped host file. Reads are a single copy out of
+// the mapping, and slices of the file share the same mapping.
+class MappedVfsFile : public VfsFile {
+public:
+    MappedVfsFile(std::shared_ptr<const Common::FS::FileMapping> mapping, u64 offset, u64 size,
+                  std::string name = "", VirtualDir parent = nullptr);
+    ~MappedVfsFile() override;
+
+    // Maps the range [offset, offset + size) of the file at path. Returns nullptr if the file
+    // cannot be mapped or is too small.
+    static std::shared_ptr<MappedVfsFile> Open(std::string_view path, u64 offset, u64 size,
+                                               std::string name = "");
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+    // The file contents, valid for as long as this file is alive.
+    std::span<const u8> GetData() const;
+
+    // Returns a file over [offset, offset + size) of this file that shares the same mapping.
+    std::shared_ptr<MappedVfsFile> Slice(u64 offset, u64 size, std::string name = "",
+                                         VirtualDir parent = nullptr) const;
+
+private:
+    std::shared_ptr<const Common::FS::FileMapping> mapping;
+    u64 offset;
+    u64 size;
+    std::string name;
+    VirtualDir parent;
+};
+
+} // namespace FileSys
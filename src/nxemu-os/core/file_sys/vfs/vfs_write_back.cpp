@@ -0,0 +1,762 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/common_funcs.h"
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/fs/fs.h"
+#include "yuzu_common/logging/log.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr u32 JournalMagic = Common::MakeMagic('N', 'X', 'S', 'J');
+constexpr u32 JournalVersion = 1;
+
+struct JournalHeader {
+    u32 magic;
+    u32 version;
+    u64 entry_count;
+    u64 payload_size;
+    u64 payload_hash;
+};
+static_assert(sizeof(JournalHeader) == 0x20, "JournalHeader has incorrect size.");
+
+struct JournalRecord {
+    u32 op;
+    u32 path_size;
+    u64 data_size;
+};
+static_assert(sizeof(JournalRecord) == 0x10, "JournalRecord has incorrect size.");
+
+enum class JournalOp : u32 {
+    DeleteFile,
+    DeleteDirectory,
+    CreateDirectory,
+    WriteFile,
+};
+
+// Paths inside the store are relative to the root and '/' separated, the root itself is "".
+std::string JoinPath(std::string_view parent, std::string_view name) {
+    if (parent.empty()) {
+        return std::string(name);
+    }
+    std::string out;
+    out.reserve(parent.size() + 1 + name.size());
+    out.append(parent);
+    out.push_back('/');
+    out.append(name);
+    return out;
+}
+
+std::string_view GetParent(std::string_view path) {
+    const auto pos = path.rfind('/');
+    return pos == std::string_view::npos ? std::string_view{} : path.substr(0, pos);
+}
+
+std::string_view GetLeafName(std::string_view path) {
+    const auto pos = path.rfind('/');
+    return pos == std::string_view::npos ? path : path.substr(pos + 1);
+}
+
+std::string GetChildPrefix(std::string_view path) {
+    return path.empty() ? std::string{} : JoinPath(path, "");
+}
+
+bool IsValidName(std::string_view name) {
+    return !name.empty() && name != "." && name != ".." &&
+           name.find_first_of("/\\") == std::string_view::npos;
+}
+
+} // Anonymous namespace
+
+struct WriteBackVfsStore::JournalEntry {
+    JournalOp op;
+    std::string path;
+    FileData data;
+};
+
+WriteBackVfsStore::WriteBackVfsStore(VirtualDir host_dir_)
+    : host_dir{std::move(host_dir_)},
+      journal_path{JoinPath(host_dir->GetFullPath(), GetWriteBackJournalFileName())},
+      writer{1, "SaveDataWriter"} {
+    ReplayJournal();
+    Load();
+}
+
+WriteBackVfsStore::~WriteBackVfsStore() {
+    Flush();
+}
+
+VirtualDir WriteBackVfsStore::GetRoot() {
+    return std::make_shared<WriteBackVfsDirectory>(shared_from_this(), "");
+}
+
+bool WriteBackVfsStore::Commit() {
+    FileMap snapshot_files;
+    DirectorySet snapshot_directories;
+    {
+        std::scoped_lock lk{lock};
+        snapshot_files = files;
+        snapshot_directories = directories;
+    }
+
+    // The writer diffs against the last commit that reached the host, so a write back that
+    // fails is folded into the next one instead of being lost
+    writer.QueueWork([this, snapshot_files = std::move(snapshot_files),
+                      snapshot_directories = std::move(snapshot_directories)]() mutable {
+        WriteBack(std::move(snapshot_files), std::move(snapshot_directories));
+    });
+    return true;
+}
+
+void WriteBackVfsStore::Flush() {
+    writer.WaitForRequests();
+}
+
+void WriteBackVfsStore::Load() {
+    std::scoped_lock lk{lock};
+    files.clear();
+    directories.clear();
+    LoadDirectory(host_dir, "");
+    committed_files = files;
+    committed_directories = directories;
+}
+
+void WriteBackVfsStore::LoadDirectory(const VirtualDir& dir, const std::string& path) {
+    for (const auto& file : dir->GetFiles()) {
+        const auto name = file->GetName();
+        if (path.empty() && name == GetWriteBackJournalFileName()) {
+            continue;
+        }
+        files.emplace(JoinPath(path, name), std::make_shared<std::vector<u8>>(file->ReadAllBytes()));
+    }
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        auto subdir_path = JoinPath(path, subdir->GetName());
+        directories.insert(subdir_path);
+        LoadDirectory(subdir, subdir_path);
+    }
+}
+
+void WriteBackVfsStore::ReplayJournal() {
+    std::vector<JournalEntry> entries;
+    bool valid = false;
+    {
+        Common::FS::IOFile journal{journal_path, Common::FS::FileAccessMode::Read,
+                                   Common::FS::FileType::BinaryFile};
+        if (!journal.IsOpen()) {
+            return;
+        }
+
+        JournalHeader header{};
+        if (journal.ReadObject(header) && header.magic == JournalMagic &&
+            header.version == JournalVersion &&
+            journal.GetSize() == sizeof(JournalHeader) + header.payload_size) {
+            std::vector<u8> payload(header.payload_size);
+            if (journal.ReadSpan(std::span<u8>(payload)) == payload.size()) {
+                // The hash is chained over the same pieces the writer wrote
+                u64 hash = 0;
+                size_t offset = 0;
+                const auto take = [&](size_t size) -> const u8* {
+                    if (size > payload.size() - offset) {
+                        return nullptr;
+                    }
+                    const u8* data = payload.data() + offset;
+                    if (size != 0) {
+                        hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(data),
+                                                          size, hash);
+                    }
+                    offset += size;
+                    return data;
+                };
+
+                bool parsed = true;
+                for (u64 i = 0; i < header.entry_count && parsed; i++) {
+                    JournalRecord record;
+                    const u8* record_data = take(sizeof(record));
+                    if (record_data == nullptr) {
+                        parsed = false;
+                        break;
+                    }
+                    std::memcpy(&record, record_data, sizeof(record));
+                    const u8* path_data = take(record.path_size);
+                    const u8* file_data =
+                        path_data == nullptr || record.data_size > payload.size() - offset
+                            ? nullptr
+                            : take(static_cast<size_t>(record.data_size));
+                    if (file_data == nullptr ||
+                        record.op > static_cast<u32>(JournalOp::WriteFile)) {
+                        parsed = false;
+                        break;
+                    }
+
+                    JournalEntry entry{static_cast<JournalOp>(record.op),
+                                       std::string(reinterpret_cast<const char*>(path_data),
+                                                   record.path_size),
+                                       nullptr};
+                    if (entry.op == JournalOp::WriteFile) {
+                        entry.data = std::make_shared<std::vector<u8>>(
+                            file_data, file_data + record.data_size);
+                    }
+                    entries.push_back(std::move(entry));
+                }
+                valid = parsed && offset == payload.size() && hash == header.payload_hash;
+            }
+        }
+    }
+
+    // A journal that is not complete was interrupted before its commit point, the host
+    // directory still holds the previous commit untouched.
+    if (valid) {
+        LOG_WARNING(Service_FS, "Replaying an interrupted save data commit in {}",
+                    host_dir->GetFullPath());
+        if (!ApplyEntries(entries)) {
+            LOG_ERROR(Service_FS, "Failed to replay the save data journal, keeping it at {}",
+                      journal_path);
+            return;
+        }
+    } else {
+        LOG_WARNING(Service_FS, "Discarding an incomplete save data journal in {}",
+                    host_dir->GetFullPath());
+    }
+    Common::FS::RemoveFile(journal_path);
+}
+
+void WriteBackVfsStore::WriteBack(FileMap snapshot_files, DirectorySet snapshot_directories) {
+    // Removals go first, deepest directories before their parents, then directories are created
+    // parents first so that every written file has somewhere to go.
+    std::vector<JournalEntry> entries;
+    for (const auto& [path, data] : committed_files) {
+        if (!snapshot_files.contains(path)) {
+            entries.push_back({JournalOp::DeleteFile, path, nullptr});
+        }
+    }
+    for (auto it = committed_directories.rbegin(); it != committed_directories.rend(); ++it) {
+        if (!snapshot_directories.contains(*it)) {
+            entries.push_back({JournalOp::DeleteDirectory, *it, nullptr});
+        }
+    }
+    for (const auto& path : snapshot_directories) {
+        if (!committed_directories.contains(path)) {
+            entries.push_back({JournalOp::CreateDirectory, path, nullptr});
+        }
+    }
+
+    // Contents are copy on write, so a file is unchanged exactly when it still shares its
+    // buffer with the previous commit.
+    for (const auto& [path, data] : snapshot_files) {
+        const auto it = committed_files.find(path);
+        if (it == committed_files.end() || it->second != data) {
+            entries.push_back({JournalOp::WriteFile, path, data});
+        }
+    }
+
+    if (entries.empty()) {
+        return;
+    }
+    LOG_DEBUG(Service_FS, "Writing back {} save data changes to {}", entries.size(),
+              host_dir->GetFullPath());
+
+    {
+        Common::FS::IOFile journal{journal_path, Common::FS::FileAccessMode::Write,
+                                   Common::FS::FileType::BinaryFile};
+        if (!journal.IsOpen()) {
+            LOG_ERROR(Service_FS, "Failed to create the save data journal at {}", journal_path);
+            return;
+        }
+
+        JournalHeader header{
+            .magic = JournalMagic,
+            .version = JournalVersion,
+            .entry_count = entries.size(),
+            .payload_size = 0,
+            .payload_hash = 0,
+        };
+        const auto write = [&](const void* data, size_t size) {
+            if (size == 0) {
+                return true;
+            }
+            header.payload_hash = Common::CityHash64WithSeed(static_cast<const char*>(data),
+                                                             size, header.payload_hash);
+            header.payload_size += size;
+            return journal.WriteSpan(std::span<const u8>(static_cast<const u8*>(data), size)) ==
+                   size;
+        };
+
+        bool ok = journal.WriteObject(header);
+        for (const auto& entry : entries) {
+            const JournalRecord record{
+                .op = static_cast<u32>(entry.op),
+                .path_size = static_cast<u32>(entry.path.size()),
+                .data_size = entry.data != nullptr ? entry.data->size() : 0,
+            };
+            ok = ok && write(&record, sizeof(record)) &&
+                 write(entry.path.data(), entry.path.size()) &&
+                 (entry.data == nullptr || write(entry.data->data(), entry.data->size()));
+        }
+
+        // The header only becomes valid once everything it covers is written, and the journal
+        // contents are synced before the header can be relied on.
+        ok = ok && journal.Seek(0) && journal.WriteObject(header) && journal.Commit();
+        if (!ok) {
+            LOG_ERROR(Service_FS, "Failed to write the save data journal at {}", journal_path);
+            journal.Close();
+            Common::FS::RemoveFile(journal_path);
+            return;
+        }
+    }
+
+    // Syncing the directory makes the journal's own entry durable. This is the commit point,
+    // save files are only truncated and rewritten after it and are replayed if they do not
+    // finish. ApplyEntries then syncs each rewritten file and each changed directory, since the
+    // journal may only be removed once all of those are on disk. Some hosts and filesystems
+    // cannot sync a directory at all, so that only costs durability of the entries and the save
+    // is still written back.
+    if (!Common::FS::SyncDir(host_dir->GetFullPath())) {
+        LOG_WARNING(Service_FS, "Failed to sync the directory of the save data journal at {}",
+                    journal_path);
+    }
+
+    // Anything left unapplied stays in the journal for the next load to replay, and the
+    // baseline is kept so the next commit writes these changes again
+    if (!ApplyEntries(entries)) {
+        LOG_ERROR(Service_FS, "Failed to write back save data to {}", host_dir->GetFullPath());
+        return;
+    }
+    Common::FS::RemoveFile(journal_path);
+
+    std::scoped_lock lk{lock};
+    committed_files = std::move(snapshot_files);
+    committed_directories = std::move(snapshot_directories);
+}
+
+bool WriteBackVfsStore::ApplyEntries(const std::vector<JournalEntry>& entries) {
+    // Every step is idempotent so a replay can run over a partially applied journal
+    const auto host_path = host_dir->GetFullPath();
+    std::set<std::string, std::less<>> dirty_directories;
+    bool ok = true;
+    for (const auto& entry : entries) {
+        const auto parent_path = GetParent(entry.path);
+        const auto name = GetLeafName(entry.path);
+        const auto parent =
+            parent_path.empty() ? host_dir : host_dir->GetDirectoryRelative(parent_path);
+        dirty_directories.emplace(parent_path);
+
+        switch (entry.op) {
+        case JournalOp::DeleteFile:
+            if (parent != nullptr && parent->GetFile(name) != nullptr &&
+                !parent->DeleteFile(name)) {
+                LOG_ERROR(Service_FS, "Failed to delete save data file {}", entry.path);
+                ok = false;
+            }
+            break;
+        case JournalOp::DeleteDirectory:
+            if (parent != nullptr && parent->GetSubdirectory(name) != nullptr &&
+                !parent->DeleteSubdirectoryRecursive(name)) {
+                LOG_ERROR(Service_FS, "Failed to delete save data directory {}", entry.path);
+                ok = false;
+            }
+            break;
+        case JournalOp::CreateDirectory:
+            if (host_dir->CreateDirectoryRelative(entry.path) == nullptr) {
+                LOG_ERROR(Service_FS, "Failed to create save data directory {}", entry.path);
+                ok = false;
+            }
+            break;
+        case JournalOp::WriteFile: {
+            // Written through the host file directly so its contents can be synced
+            Common::FS::IOFile file{JoinPath(host_path, entry.path),
+                                    Common::FS::FileAccessMode::Write,
+                                    Common::FS::FileType::BinaryFile};
+            const auto& data = *entry.data;
+            if (!file.IsOpen() || file.WriteSpan(std::span<const u8>(data)) != data.size() ||
+                !file.Commit()) {
+                LOG_ERROR(Service_FS, "Failed to write save data file {}", entry.path);
+                ok = false;
+            }
+            break;
+        }
+        }
+    }
+
+    // The journal should only go once the new directory entries are durable too. A directory
+    // that no longer exists was removed, and its removal is synced with its own parent. A host
+    // that cannot sync directories would otherwise keep the journal forever, so a failed sync
+    // is not treated as a failed write.
+    for (const auto& path : dirty_directories) {
+        const auto full_path = path.empty() ? host_path : JoinPath(host_path, path);
+        if (Common::FS::IsDir(full_path) && !Common::FS::SyncDir(full_path)) {
+            LOG_WARNING(Service_FS, "Failed to sync save data directory {}", full_path);
+        }
+    }
+    return ok;
+}
+
+bool WriteBackVfsStore::IsFile(std::string_view path) {
+    std::scoped_lock lk{lock};
+    return files.contains(path);
+}
+
+bool WriteBackVfsStore::IsDirectory(std::string_view path) {
+    std::scoped_lock lk{lock};
+    return path.empty() || directories.contains(path);
+}
+
+std::optional<std::size_t> WriteBackVfsStore::GetFileSize(std::string_view path) {
+    std::scoped_lock lk{lock};
+    const auto it = files.find(path);
+    if (it == files.end()) {
+        return std::nullopt;
+    }
+    return it->second->size();
+}
+
+std::size_t WriteBackVfsStore::ReadFile(std::string_view path, u8* data, std::size_t length,
+                                        std::size_t offset) {
+    std::scoped_lock lk{lock};
+    const auto it = files.find(path);
+    if (it == files.end() || offset >= it->second->size()) {
+        return 0;
+    }
+    const auto read_size = std::min(length, it->second->size() - offset);
+    std::memcpy(data, it->second->data() + offset, read_size);
+    return read_size;
+}
+
+std::size_t WriteBackVfsStore::WriteFile(std::string_view path, const u8* data,
+                                         std::size_t length, std::size_t offset) {
+    std::scoped_lock lk{lock};
+    const auto it = files.find(path);
+    if (it == files.end()) {
+        return 0;
+    }
+    auto& contents = GetWritableData(it->second);
+    if (offset + length > contents.size()) {
+        contents.resize(offset + length);
+    }
+    std::memcpy(contents.data() + offset, data, length);
+    return length;
+}
+
+bool WriteBackVfsStore::ResizeFile(std::string_view path, std::size_t new_size) {
+    std::scoped_lock lk{lock};
+    const auto it = files.find(path);
+    if (it == files.end()) {
+        return false;
+    }
+    if (it->second->size() != new_size) {
+        GetWritableData(it->second).resize(new_size);
+    }
+    return true;
+}
+
+bool WriteBackVfsStore::CreateFile(std::string_view path) {
+    std::scoped_lock lk{lock};
+    if (files.contains(path)) {
+        return true;
+    }
+    const auto parent = GetParent(path);
+    if (directories.contains(path) || (!parent.empty() && !directories.contains(parent))) {
+        return false;
+    }
+    files.emplace(std::string(path), std::make_shared<std::vector<u8>>());
+    return true;
+}
+
+bool WriteBackVfsStore::CreateDirectory(std::string_view path) {
+    std::scoped_lock lk{lock};
+    if (directories.contains(path)) {
+        return true;
+    }
+    const auto parent = GetParent(path);
+    if (files.contains(path) || (!parent.empty() && !directories.contains(parent))) {
+        return false;
+    }
+    directories.emplace(path);
+    return true;
+}
+
+bool WriteBackVfsStore::DeleteFile(std::string_view path) {
+    std::scoped_lock lk{lock};
+    const auto it = files.find(path);
+    if (it == files.end()) {
+        return false;
+    }
+    files.erase(it);
+    return true;
+}
+
+bool WriteBackVfsStore::DeleteDirectory(std::string_view path, bool recursive) {
+    std::scoped_lock lk{lock};
+    const auto dir = directories.find(path);
+    if (dir == directories.end()) {
+        return false;
+    }
+
+    const auto prefix = GetChildPrefix(path);
+    const auto files_begin = files.lower_bound(prefix);
+    auto files_end = files_begin;
+    while (files_end != files.end() && files_end->first.starts_with(prefix)) {
+        ++files_end;
+    }
+    const auto dirs_begin = directories.lower_bound(prefix);
+    auto dirs_end = dirs_begin;
+    while (dirs_end != directories.end() && dirs_end->starts_with(prefix)) {
+        ++dirs_end;
+    }
+
+    if (!recursive && (files_begin != files_end || dirs_begin != dirs_end)) {
+        return false;
+    }
+    files.erase(files_begin, files_end);
+    directories.erase(dirs_begin, dirs_end);
+    directories.erase(dir);
+    return true;
+}
+
+bool WriteBackVfsStore::Rename(std::string_view old_path, std::string_view new_path) {
+    std::scoped_lock lk{lock};
+    const auto new_parent = GetParent(new_path);
+    if (files.contains(new_path) || directories.contains(new_path) ||
+        (!new_parent.empty() && !directories.contains(new_parent))) {
+        return false;
+    }
+
+    if (const auto file = files.find(old_path); file != files.end()) {
+        auto node = files.extract(file);
+        node.key() = std::string(new_path);
+        files.insert(std::move(node));
+        return true;
+    }
+    if (!directories.contains(old_path)) {
+        return false;
+    }
+
+    // Re-key everything below the directory, contents are moved and not copied
+    const auto old_prefix = GetChildPrefix(old_path);
+    const auto new_prefix = GetChildPrefix(new_path);
+    std::vector<std::string> moved_files;
+    for (auto it = files.lower_bound(old_prefix);
+         it != files.end() && it->first.starts_with(old_prefix); ++it) {
+        moved_files.push_back(it->first);
+    }
+    for (const auto& path : moved_files) {
+        auto node = files.extract(path);
+        node.key() = new_prefix + path.substr(old_prefix.size());
+        files.insert(std::move(node));
+    }
+
+    std::vector<std::string> moved_directories;
+    for (auto it = directories.lower_bound(old_prefix);
+         it != directories.end() && it->starts_with(old_prefix); ++it) {
+        moved_directories.push_back(*it);
+    }
+    for (const auto& path : moved_directories) {
+        directories.erase(path);
+        directories.insert(new_prefix + path.substr(old_prefix.size()));
+    }
+    directories.erase(directories.find(old_path));
+    directories.emplace(new_path);
+    return true;
+}
+
+void WriteBackVfsStore::ListDirectory(std::string_view path, std::vector<std::string>* out_files,
+                                      std::vector<std::string>* out_directories) {
+    std::scoped_lock lk{lock};
+    const auto prefix = GetChildPrefix(path);
+    if (out_files != nullptr) {
+        for (auto it = files.lower_bound(prefix);
+             it != files.end() && it->first.starts_with(prefix); ++it) {
+            const auto name = std::string_view(it->first).substr(prefix.size());
+            if (name.find('/') == std::string_view::npos) {
+                out_files->emplace_back(name);
+            }
+        }
+    }
+    if (out_directories != nullptr) {
+        for (auto it = directories.lower_bound(prefix);
+             it != directories.end() && it->starts_with(prefix); ++it) {
+            const auto name = std::string_view(*it).substr(prefix.size());
+            if (name.find('/') == std::string_view::npos) {
+                out_directories->emplace_back(name);
+            }
+        }
+    }
+}
+
+std::vector<u8>& WriteBackVfsStore::GetWritableData(FileData& data) {
+    // Shared with the last commit or a queued write back, take a private copy first
+    if (data.use_count() > 1) {
+        data = std::make_shared<std::vector<u8>>(*data);
+    }
+    return *data;
+}
+
+WriteBackVfsFile::WriteBackVfsFile(std::shared_ptr<WriteBackVfsStore> store_, std::string path_)
+    : store{std::move(store_)}, path{std::move(path_)} {}
+
+WriteBackVfsFile::~WriteBackVfsFile() = default;
+
+std::string WriteBackVfsFile::GetName() const {
+    return std::string(GetLeafName(path));
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    return store->GetFileSize(path).value_or(0);
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    return store->ResizeFile(path, new_size);
+}
+
+VirtualDir WriteBackVfsFile::GetContainingDirectory() const {
+    return std::make_shared<WriteBackVfsDirectory>(store, std::string(GetParent(path)));
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    return true;
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    return store->ReadFile(path, data, length, offset);
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return store->WriteFile(path, data, length, offset);
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    if (!IsValidName(name)) {
+        return false;
+    }
+    auto new_path = JoinPath(GetParent(path), name);
+    if (!store->Rename(path, new_path)) {
+        return false;
+    }
+    path = std::move(new_path);
+    return true;
+}
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(std::shared_ptr<WriteBackVfsStore> store_,
+                                             std::string path_)
+    : store{std::move(store_)}, path{std::move(path_)} {}
+
+WriteBackVfsDirectory::~WriteBackVfsDirectory() = default;
+
+std::vector<VirtualFile> WriteBackVfsDirectory::GetFiles() const {
+    std::vector<std::string> names;
+    store->ListDirectory(path, &names, nullptr);
+
+    std::vector<VirtualFile> out;
+    out.reserve(names.size());
+    for (const auto& name : names) {
+        out.push_back(std::make_shared<WriteBackVfsFile>(store, GetChildPath(name)));
+    }
+    return out;
+}
+
+VirtualFile WriteBackVfsDirectory::GetFile(std::string_view name) const {
+    auto child_path = GetChildPath(name);
+    if (!IsValidName(name) || !store->IsFile(child_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(store, std::move(child_path));
+}
+
+std::vector<VirtualDir> WriteBackVfsDirectory::GetSubdirectories() const {
+    std::vector<std::string> names;
+    store->ListDirectory(path, nullptr, &names);
+
+    std::vector<VirtualDir> out;
+    out.reserve(names.size());
+    for (const auto& name : names) {
+        out.push_back(std::make_shared<WriteBackVfsDirectory>(store, GetChildPath(name)));
+    }
+    return out;
+}
+
+VirtualDir WriteBackVfsDirectory::GetSubdirectory(std::string_view name) const {
+    auto child_path = GetChildPath(name);
+    if (!IsValidName(name) || !store->IsDirectory(child_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(store, std::move(child_path));
+}
+
+bool WriteBackVfsDirectory::IsWritable() const {
+    return true;
+}
+
+bool WriteBackVfsDirectory::IsReadable() const {
+    return true;
+}
+
+std::string WriteBackVfsDirectory::GetName() const {
+    return path.empty() ? store->host_dir->GetName() : std::string(GetLeafName(path));
+}
+
+VirtualDir WriteBackVfsDirectory::GetParentDirectory() const {
+    if (path.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(store, std::string(GetParent(path)));
+}
+
+VirtualDir WriteBackVfsDirectory::CreateSubdirectory(std::string_view name) {
+    auto child_path = GetChildPath(name);
+    if (!IsValidName(name) || !store->CreateDirectory(child_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(store, std::move(child_path));
+}
+
+VirtualFile WriteBackVfsDirectory::CreateFile(std::string_view name) {
+    auto child_path = GetChildPath(name);
+    if (!IsValidName(name) || !store->CreateFile(child_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(store, std::move(child_path));
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectory(std::string_view name) {
+    return IsValidName(name) && store->DeleteDirectory(GetChildPath(name), false);
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectoryRecursive(std::string_view name) {
+    return IsValidName(name) && store->DeleteDirectory(GetChildPath(name), true);
+}
+
+bool WriteBackVfsDirectory::DeleteFile(std::string_view name) {
+    return IsValidName(name) && store->DeleteFile(GetChildPath(name));
+}
+
+bool WriteBackVfsDirectory::Rename(std::string_view name) {
+    if (path.empty() || !IsValidName(name)) {
+        return false;
+    }
+    auto new_path = JoinPath(GetParent(path), name);
+    if (!store->Rename(path, new_path)) {
+        return false;
+    }
+    path = std::move(new_path);
+    return true;
+}
+
+bool WriteBackVfsDirectory::Commit() {
+    return store->Commit();
+}
+
+std::string WriteBackVfsDirectory::GetChildPath(std::string_view name) const {
+    return JoinPath(path, name);
+}
+
+} // namespace FileSys
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "yuzu_common/thread_worker.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+constexpr const char* GetWriteBackJournalFileName() {
+    return ".nxemu_save_journal";
+}
+
+// An in memory copy of a host directory that only writes back on Commit. Guest reads and writes
+// never touch the host, Commit hands a snapshot to a background thread which journals the
+// changes since the last commit that reached the host. The journal is written and synced before
+// any host file is touched and is replayed on the next load if the changes were not fully
+// applied, so an interrupted commit leaves either the previous or the new contents, never a mix.
+class WriteBackVfsStore : public std::enable_shared_from_this<WriteBackVfsStore> {
+public:
+    explicit WriteBackVfsStore(VirtualDir host_dir);
+    ~WriteBackVfsStore();
+
+    VirtualDir GetRoot();
+
+    // Queues every change since the previous commit to be written back to the host directory.
+    bool Commit();
+
+    // Blocks until every queued commit has been written back.
+    void Flush();
+
+private:
+    friend class WriteBackVfsFile;
+    friend class WriteBackVfsDirectory;
+
+    using FileData = std::shared_ptr<std::vector<u8>>;
+    using FileMap = std::map<std::string, FileData, std::less<>>;
+    using DirectorySet = std::set<std::string, std::less<>>;
+
+    struct JournalEntry;
+
+    void Load();
+    void LoadDirectory(const VirtualDir& dir, const std::string& path);
+    void ReplayJournal();
+    void WriteBack(FileMap snapshot_files, DirectorySet snapshot_directories);
+    bool ApplyEntries(const std::vector<JournalEntry>& entries);
+
+    bool IsFile(std::string_view path);
+    bool IsDirectory(std::string_view path);
+    std::optional<std::size_t> GetFileSize(std::string_view path);
+    std::size_t ReadFile(std::string_view path, u8* data, std::size_t length, std::size_t offset);
+    std::size_t WriteFile(std::string_view path, const u8* data, std::size_t length,
+                          std::size_t offset);
+    bool ResizeFile(std::string_view path, std::size_t new_size);
+    bool CreateFile(std::string_view path);
+    bool CreateDirectory(std::string_view path);
+    bool DeleteFile(std::string_view path);
+    bool DeleteDirectory(std::string_view path, bool recursive);
+    bool Rename(std::string_view old_path, std::string_view new_path);
+    void ListDirectory(std::string_view path, std::vector<std::string>* out_files,
+                       std::vector<std::string>* out_directories);
+
+    std::vector<u8>& GetWritableData(FileData& data);
+
+    VirtualDir host_dir;
+    std::string journal_path;
+
+    std::mutex lock;
+    FileMap files;
+    DirectorySet directories;
+
+    // The state as of the last commit that reached the host, file contents are shared with
+    // files until either side writes to them. Only advanced by the writer once a write back
+    // has been applied and synced.
+    FileMap committed_files;
+    DirectorySet committed_directories;
+
+    Common::ThreadWorker writer;
+};
+
+class WriteBackVfsFile : public VfsFile {
+public:
+    WriteBackVfsFile(std::shared_ptr<WriteBackVfsStore> store, std::string path);
+    ~WriteBackVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+private:
+    std::shared_ptr<WriteBackVfsStore> store;
+    std::string path;
+};
+
+class WriteBackVfsDirectory : public VfsDirectory {
+public:
+    WriteBackVfsDirectory(std::shared_ptr<WriteBackVfsStore> store, std::string path);
+    ~WriteBackVfsDirectory() override;
+
+    std::vector<VirtualFile> GetFiles() const override;
+    VirtualFile GetFile(std::string_view name) const override;
+    std::vector<VirtualDir> GetSubdirectories() const override;
+    VirtualDir GetSubdirectory(std::string_view name) const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::string GetName() const override;
+    VirtualDir GetParentDirectory() const override;
+    VirtualDir CreateSubdirectory(std::string_view name) override;
+    VirtualFile CreateFile(std::string_view name) override;
+    bool DeleteSubdirectory(std::string_view name) override;
+    bool DeleteSubdirectoryRecursive(std::string_view name) override;
+    bool DeleteFile(std::string_view name) override;
+    bool Rename(std::string_view name) override;
+    bool Commit() override;
+
+private:
+    std::string GetChildPath(std::string_view name) const;
+
+    std::shared_ptr<WriteBackVfsStore> store;
+    std::string path;
+};
+
+} // namespace FileSys
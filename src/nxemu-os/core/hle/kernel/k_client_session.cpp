@@ -2,11 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "yuzu_common/scope_exit.h"
+#include "core/core.h"
 #include "core/hle/kernel/k_client_session.h"
 #include "core/hle/kernel/k_server_session.h"
 #include "core/hle/kernel/k_session.h"
 #include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/result.h"
+#include "core/hle/service/ipc_profiler.h"
 
 namespace Kernel {
 
@@ -31,6 +34,11 @@ Result KClientSession::SendSyncRequest(uintptr_t address, size_t size) {
     // Initialize the request.
     request->Initialize(nullptr, address, size);
 
+    // Timestamp the request so the HLE server can report how long it was queued.
+    if (m_kernel.System().IpcProfiler().IsEnabled()) {
+        request->SetSendTime(Service::IpcProfiler::Now());
+    }
+
     // Send the request.
     R_RETURN(m_parent->OnRequest(request));
 }
@@ -46,6 +54,10 @@ Result KClientSession::SendAsyncRequest(KEvent* event, uintptr_t address, size_t
     // Initialize the request.
     request->Initialize(event, address, size);
 
+    if (m_kernel.System().IpcProfiler().IsEnabled()) {
+        request->SetSendTime(Service::IpcProfiler::Now());
+    }
+
     // Send the request.
     R_RETURN(m_parent->OnRequest(request));
 }
@@ -1236,12 +1236,17 @@ void KProcess::LoadModule(const IModuleInfo & module, KProcessAddress base_addr)
         m_page_table.SetProcessMemoryPermission(segment.addr + base_addr, segment.size, permission);
     };
 
+    // Only the file backed image is copied, the code region was cleared when it was allocated so the
+    // bss and segment padding past DataSize() are already zero
     this->GetMemory().WriteBlock(base_addr, module.Data(), module.DataSize());
 
     m_page_table.SetProcessMemoryPermission((KProcessAddress)(module.CodeSegmentAddr()) + base_addr, module.CodeSegmentSize(), Svc::MemoryPermission::ReadExecute);
     m_page_table.SetProcessMemoryPermission((KProcessAddress)(module.RODataSegmentAddr()) + base_addr, module.RODataSegmentSize(), Svc::MemoryPermission::Read);
     m_page_table.SetProcessMemoryPermission((KProcessAddress)(module.DataSegmentAddr()) + base_addr, module.DataSegmentSize(), Svc::MemoryPermission::ReadWrite);
 
+    // After the permission changes, whose instruction cache invalidation would discard any persisted translations
+    m_kernel.System().GetSwitchSystem().Cpu().ModuleLoaded(module, GetInteger(base_addr));
+
 #ifdef HAS_NCE
     const auto& patch = code_set.PatchSegment();
     if (this->IsApplication() && Settings::IsNceEnabled() && patch.size != 0) {
@@ -1149,6 +1149,7 @@ Result KServerSession::ReceiveRequest(uintptr_t server_message, uintptr_t server
         *out_context =
             std::make_shared<Service::HLERequestContext>(m_kernel, memory, this, client_thread);
         (*out_context)->SetSessionRequestManager(manager);
+        (*out_context)->SetSendTime(request->GetSendTime());
         (*out_context)->PopulateFromIncomingCommandBuffer(cmd_buf);
         // We succeeded.
         R_SUCCEED();
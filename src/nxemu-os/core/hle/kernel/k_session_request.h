@@ -223,6 +223,13 @@ public:
         m_event = nullptr;
     }
 
+    u64 GetSendTime() const {
+        return m_send_time;
+    }
+    void SetSendTime(u64 send_time) {
+        m_send_time = send_time;
+    }
+
     size_t GetSendCount() const {
         return m_mappings.GetSendCount();
     }
@@ -310,6 +317,7 @@ private:
     KEvent* m_event{};
     uintptr_t m_address{};
     size_t m_size{};
+    u64 m_send_time{};
 };
 
 } // namespace Kernel
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -799,6 +800,7 @@ struct KernelCore::Impl {
 
     std::mutex server_lock;
     std::vector<std::unique_ptr<Service::ServerManager>> server_managers;
+    std::unordered_map<KThread*, Service::ServerManager*> server_hosts;
 
     std::array<std::unique_ptr<Kernel::PhysicalCore>, Core::Hardware::NUM_CPU_CORES> cores;
 
@@ -1000,6 +1002,7 @@ void KernelCore::UnregisterInUseObject(KAutoObject* object) {
 
 void KernelCore::RunServer(std::unique_ptr<Service::ServerManager>&& server_manager) {
     auto* manager = server_manager.get();
+    Service::ServerManager* host{};
 
     {
         std::scoped_lock lk{impl->server_lock};
@@ -1007,12 +1010,32 @@ void KernelCore::RunServer(std::unique_ptr<Service::ServerManager>&& server_mana
             return;
         }
 
-        impl->server_managers.emplace_back(std::move(server_manager));
+        // Keyed on the emulated thread, its fiber may move between host threads.
+        if (const auto it = impl->server_hosts.find(GetCurrentEmuThread());
+            it != impl->server_hosts.end()) {
+            host = it->second;
+        } else {
+            impl->server_managers.emplace_back(std::move(server_manager));
+        }
+    }
+
+    if (host != nullptr) {
+        host->Adopt(std::move(server_manager));
+        return;
     }
 
     manager->LoopProcess();
 }
 
+void KernelCore::SetServerHost(Service::ServerManager* host) {
+    std::scoped_lock lk{impl->server_lock};
+    if (host != nullptr) {
+        impl->server_hosts.insert_or_assign(GetCurrentEmuThread(), host);
+    } else {
+        impl->server_hosts.erase(GetCurrentEmuThread());
+    }
+}
+
 u32 KernelCore::CreateNewObjectID() {
     return impl->next_object_id++;
 }
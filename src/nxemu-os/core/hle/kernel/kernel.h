@@ -188,9 +188,12 @@ public:
     /// destroyed during the current emulation session.
     void UnregisterInUseObject(KAutoObject* object);
 
-    // Runs the given server manager until shutdown.
+    // Runs the given server manager until shutdown, or hands it to the current thread's host.
     void RunServer(std::unique_ptr<Service::ServerManager>&& server_manager);
 
+    // Sets the server manager that adopts every server run from the current thread.
+    void SetServerHost(Service::ServerManager* host);
+
     /// Gets the current host_thread/guest_thread pointer.
     KThread* GetCurrentEmuThread() const;
 
@@ -338,12 +338,26 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
+            // Hand the guest memory straight to the handler when it is host contiguous,
+            // otherwise set up a scratch buffer that is written back after the call.
             auto& buffer = temp[OutBufferIndex];
+            buffer.resize_destructive(0);
             if (ctx.CanWriteBuffer(OutBufferIndex)) {
-                buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
-            } else {
-                buffer.resize_destructive(0);
+                const size_t buffer_size = ctx.GetWriteBufferSize(OutBufferIndex);
+                std::span<const std::span<u8>> spans;
+                if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+                    spans = ctx.WriteBufferSpans(OutBufferIndex);
+                } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+                    spans = ctx.WriteBufferSpansB(OutBufferIndex);
+                } else /* if (ArgType::Attr & BufferAttr_HipcPointer) */ {
+                    spans = ctx.WriteBufferSpansC(OutBufferIndex);
+                }
+
+                if (spans.size() == 1 && spans[0].size() == buffer_size && (reinterpret_cast<uintptr_t>(spans[0].data()) % alignof(ElementType)) == 0) {
+                    std::get<ArgIndex>(args) = std::span((ElementType*) spans[0].data(), buffer_size / sizeof(ElementType));
+                    return ReadInArgument<MethodArguments, CallArguments, PrevAlign, DataOffset, HandleIndex, InBufferIndex, OutBufferIndex + 1, RawDataFinished, ArgIndex + 1>(is_domain, args, raw_data, ctx, temp);
+                }
+                buffer.resize_destructive(buffer_size);
             }
 
             ElementType* ptr = (ElementType*) buffer.data();
@@ -9,12 +9,17 @@
 #include "yuzu_common/settings.h"
 #include "core/core.h"
 #include "core/file_sys/control_metadata.h"
+#include "core/file_sys/errors.h"
 #include "core/file_sys/registered_cache.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/romfs_factory.h"
+#include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp/fsp_ldr.h"
 #include "core/hle/service/filesystem/fsp/fsp_pr.h"
 #include "core/hle/service/filesystem/fsp/fsp_srv.h"
+#include "core/hle/service/filesystem/save_data_controller.h"
 #include "core/hle/service/server_manager.h"
 #include "core/loader/loader.h"
 
@@ -39,69 +44,263 @@ std::string VfsDirectoryServiceWrapper::GetName() const {
 }
 
 Result VfsDirectoryServiceWrapper::CreateFile(const std::string& path_, u64 size) const {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    FileSys::DirectoryEntryType entry_type{};
+    if (GetEntryType(&entry_type, path) == ResultSuccess) {
+        return FileSys::ResultPathAlreadyExists;
+    }
+
+    auto file = dir->CreateFile(Common::FS::GetFilename(path));
+    if (file == nullptr) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
+    if (!file->Resize(size)) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::DeleteFile(const std::string& path_) const {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+    if (path.empty()) {
+        // TODO(DarkLordZach): Why do games call this and what should it do? Works as is but...
+        return ResultSuccess;
+    }
+
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr || dir->GetFile(Common::FS::GetFilename(path)) == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+    if (!dir->DeleteFile(Common::FS::GetFilename(path))) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
+
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::CreateDirectory(const std::string& path_) const {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+
+    // NOTE: This is inaccurate behavior. CreateDirectory is not recursive.
+    // CreateDirectory should return PathNotFound if the parent directory does not exist.
+    // This is here temporarily in order to have UMM "work" in the meantime.
+    // TODO (Morph): Remove this when a hardware test verifies the correct behavior.
+    const auto components = Common::FS::SplitPathComponents(path);
+    std::string relative_path;
+    for (const auto& component : components) {
+        // Skip empty path components
+        if (component.empty()) {
+            continue;
+        }
+        relative_path = Common::FS::SanitizePath(fmt::format("{}/{}", relative_path, component));
+        auto new_dir = backing->CreateSubdirectory(relative_path);
+        if (new_dir == nullptr) {
+            // TODO(DarkLordZach): Find a better error code for this
+            return ResultUnknown;
+        }
+    }
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::DeleteDirectory(const std::string& path_) const {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+    if (!dir->DeleteSubdirectory(Common::FS::GetFilename(path))) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::DeleteDirectoryRecursively(const std::string& path_) const {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+    if (!dir->DeleteSubdirectoryRecursive(Common::FS::GetFilename(path))) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::CleanDirectoryRecursively(const std::string& path) const {
-    UNIMPLEMENTED();
+    const std::string sanitized_path(Common::FS::SanitizePath(path));
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(sanitized_path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    if (!dir->CleanSubdirectoryRecursive(Common::FS::GetFilename(sanitized_path))) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
+
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::RenameFile(const std::string& src_path_,
                                               const std::string& dest_path_) const {
-    UNIMPLEMENTED();
+    std::string src_path(Common::FS::SanitizePath(src_path_));
+    std::string dest_path(Common::FS::SanitizePath(dest_path_));
+    auto src = backing->GetFileRelative(src_path);
+    auto dst = backing->GetFileRelative(dest_path);
+    if (src == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+    if (dst != nullptr) {
+        LOG_ERROR(Service_FS, "File at new_path={} already exists", dest_path);
+        return FileSys::ResultPathAlreadyExists;
+    }
+
+    if (Common::FS::GetParentPath(src_path) == Common::FS::GetParentPath(dest_path)) {
+        // Use more-optimized vfs implementation rename.
+        if (!src->Rename(Common::FS::GetFilename(dest_path))) {
+            // TODO(DarkLordZach): Find a better error code for this
+            return ResultUnknown;
+        }
+        return ResultSuccess;
+    }
+
+    // Move by hand -- TODO(DarkLordZach): Optimize
+    auto c_res = CreateFile(dest_path, src->GetSize());
+    if (c_res != ResultSuccess) {
+        return c_res;
+    }
+
+    auto dest = backing->GetFileRelative(dest_path);
+    ASSERT_MSG(dest != nullptr, "Newly created file with success cannot be found.");
+
+    ASSERT_MSG(dest->WriteBytes(src->ReadAllBytes()) == src->GetSize(),
+               "Could not write all of the bytes but everything else has succeeded.");
+
+    if (!src->GetContainingDirectory()->DeleteFile(Common::FS::GetFilename(src_path))) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
+
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::RenameDirectory(const std::string& src_path_,
                                                    const std::string& dest_path_) const {
-    UNIMPLEMENTED();
+    std::string src_path(Common::FS::SanitizePath(src_path_));
+    std::string dest_path(Common::FS::SanitizePath(dest_path_));
+    auto src = GetDirectoryRelativeWrapped(backing, src_path);
+    if (Common::FS::GetParentPath(src_path) == Common::FS::GetParentPath(dest_path)) {
+        // Use more-optimized vfs implementation rename.
+        if (src == nullptr) {
+            return FileSys::ResultPathNotFound;
+        }
+        if (!src->Rename(Common::FS::GetFilename(dest_path))) {
+            // TODO(DarkLordZach): Find a better error code for this
+            return ResultUnknown;
+        }
+        return ResultSuccess;
+    }
+
+    // TODO(DarkLordZach): Implement renaming across the tree (move).
+    ASSERT_MSG(false,
+               "Could not rename directory with path \"{}\" to new path \"{}\" because parent dirs "
+               "don't match -- UNIMPLEMENTED",
+               src_path, dest_path);
+
+    // TODO(DarkLordZach): Find a better error code for this
     return ResultUnknown;
 }
 
 Result VfsDirectoryServiceWrapper::OpenFile(FileSys::VirtualFile* out_file,
                                             const std::string& path_,
                                             FileSys::OpenMode mode) const {
-    UNIMPLEMENTED();
+    const std::string path(Common::FS::SanitizePath(path_));
+    std::string_view npath = path;
+    while (!npath.empty() && (npath[0] == '/' || npath[0] == '\\')) {
+        npath.remove_prefix(1);
+    }
+
+    auto file = backing->GetFileRelative(npath);
+    if (file == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    *out_file = file;
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::OpenDirectory(FileSys::VirtualDir* out_directory,
                                                  const std::string& path_) {
-    UNIMPLEMENTED();
+    std::string path(Common::FS::SanitizePath(path_));
+    auto dir = GetDirectoryRelativeWrapped(backing, path);
+    if (dir == nullptr) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return FileSys::ResultPathNotFound;
+    }
+    *out_directory = dir;
     return ResultSuccess;
 }
 
 Result VfsDirectoryServiceWrapper::GetEntryType(FileSys::DirectoryEntryType* out_entry_type,
                                                 const std::string& path_) const {
-    UNIMPLEMENTED();
-    return ResultSuccess;
+    std::string path(Common::FS::SanitizePath(path_));
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    auto filename = Common::FS::GetFilename(path);
+    // TODO(Subv): Some games use the '/' path, find out what this means.
+    if (filename.empty()) {
+        *out_entry_type = FileSys::DirectoryEntryType::Directory;
+        return ResultSuccess;
+    }
+
+    if (dir->GetFile(filename) != nullptr) {
+        *out_entry_type = FileSys::DirectoryEntryType::File;
+        return ResultSuccess;
+    }
+
+    if (dir->GetSubdirectory(filename) != nullptr) {
+        *out_entry_type = FileSys::DirectoryEntryType::Directory;
+        return ResultSuccess;
+    }
+
+    return FileSys::ResultPathNotFound;
 }
 
 Result VfsDirectoryServiceWrapper::GetFileTimeStampRaw(
     FileSys::FileTimeStampRaw* out_file_time_stamp_raw, const std::string& path) const {
-    UNIMPLEMENTED();
+    auto dir = GetDirectoryRelativeWrapped(backing, Common::FS::GetParentPath(path));
+    if (dir == nullptr) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    FileSys::DirectoryEntryType entry_type;
+    if (GetEntryType(&entry_type, path) != ResultSuccess) {
+        return FileSys::ResultPathNotFound;
+    }
+
+    *out_file_time_stamp_raw = dir->GetFileTimeStamp(Common::FS::GetFilename(path));
+    return ResultSuccess;
+}
+
+Result VfsDirectoryServiceWrapper::Commit() const {
+    if (!backing->Commit()) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultUnknown;
+    }
+
     return ResultSuccess;
 }
 
@@ -109,14 +308,76 @@ FileSystemController::FileSystemController(Core::System& system_) : system{syste
 
 FileSystemController::~FileSystemController() = default;
 
+void FileSystemController::RegisterRomFS(FileSys::VirtualFile romfs) {
+    romfs_file = std::move(romfs);
+    romfs_dir = romfs_file != nullptr ? FileSys::ExtractRomFS(romfs_file) : nullptr;
+    if (romfs_file != nullptr && romfs_dir == nullptr) {
+        LOG_ERROR(Service_FS, "Failed to index the RomFS of the current process");
+    }
+}
+
+FileSys::VirtualFile FileSystemController::OpenRomFSCurrentProcess() const {
+    return romfs_file;
+}
+
+FileSys::VirtualDir FileSystemController::OpenRomFSDirectoryCurrentProcess() const {
+    return romfs_dir;
+}
+
+Result FileSystemController::OpenSDMC(FileSys::VirtualDir* out_sdmc) const {
+    LOG_TRACE(Service_FS, "Opening SDMC");
+
+    if (sdmc_dir == nullptr) {
+        return FileSys::ResultPortSdCardNoDevice;
+    }
+
+    *out_sdmc = sdmc_dir;
+    return ResultSuccess;
+}
+
+Result FileSystemController::OpenSaveDataController(
+    std::shared_ptr<SaveDataController>* out_save_data_controller, ProgramId program_id) {
+    LOG_TRACE(Service_FS, "Opening save data controller for program_id={:016X}", program_id);
+
+    std::scoped_lock lk{save_data_lock};
+    if (save_data_controller == nullptr || save_data_program_id != program_id) {
+        if (nand_dir == nullptr) {
+            return FileSys::ResultTargetNotFound;
+        }
+
+        save_data_controller = std::make_shared<SaveDataController>(
+            system, std::make_shared<FileSys::SaveDataFactory>(system, program_id, nand_dir));
+        save_data_program_id = program_id;
+    }
+
+    *out_save_data_controller = save_data_controller;
+    return ResultSuccess;
+}
+
 u64 FileSystemController::GetFreeSpaceSize(FileSys::StorageId id) const {
-    UNIMPLEMENTED();
-    return 0;
+    switch (id) {
+    case FileSys::StorageId::SdCard:
+        return Common::FS::GetFreeSpaceSize(Common::FS::GetYuzuPath(Common::FS::YuzuPath::SDMCDir));
+    case FileSys::StorageId::NandUser:
+        return Common::FS::GetFreeSpaceSize(Common::FS::GetYuzuPath(Common::FS::YuzuPath::NANDDir));
+    default:
+        UNIMPLEMENTED();
+        return 0;
+    }
 }
 
 u64 FileSystemController::GetTotalSpaceSize(FileSys::StorageId id) const {
-    UNIMPLEMENTED();
-    return 0;
+    switch (id) {
+    case FileSys::StorageId::SdCard:
+        return Common::FS::GetTotalSpaceSize(
+            Common::FS::GetYuzuPath(Common::FS::YuzuPath::SDMCDir));
+    case FileSys::StorageId::NandUser:
+        return Common::FS::GetTotalSpaceSize(
+            Common::FS::GetYuzuPath(Common::FS::YuzuPath::NANDDir));
+    default:
+        UNIMPLEMENTED();
+        return 0;
+    }
 }
 
 void FileSystemController::SetGameCard(FileSys::VirtualFile file) {
@@ -125,11 +386,45 @@ void FileSystemController::SetGameCard(FileSys::VirtualFile file) {
 
 
 void FileSystemController::CreateFactories(FileSys::VfsFilesystem& vfs, bool overwrite) {
-    UNIMPLEMENTED();
+    if (overwrite) {
+        sdmc_dir.reset();
+        save_data_dir.reset();
+        nand_dir.reset();
+    }
+
+    using YuzuPath = Common::FS::YuzuPath;
+    const auto sdmc_dir_path = Common::FS::GetYuzuPathString(YuzuPath::SDMCDir);
+    const auto nand_dir_path = Common::FS::GetYuzuPathString(YuzuPath::NANDDir);
+    const auto rw_mode = FileSys::OpenMode::ReadWrite;
+
+    if (sdmc_dir == nullptr) {
+        sdmc_dir = vfs.OpenDirectory(sdmc_dir_path, rw_mode);
+        if (sdmc_dir == nullptr) {
+            sdmc_dir = vfs.CreateDirectory(sdmc_dir_path, rw_mode);
+        }
+    }
+
+    if (nand_dir == nullptr) {
+        nand_dir = vfs.OpenDirectory(nand_dir_path, rw_mode);
+        if (nand_dir == nullptr) {
+            nand_dir = vfs.CreateDirectory(nand_dir_path, rw_mode);
+        }
+    }
+
+    if (save_data_dir == nullptr && nand_dir != nullptr) {
+        save_data_dir = FileSys::GetOrCreateDirectoryRelative(nand_dir, "/user/save");
+    }
 }
 
 void FileSystemController::Reset() {
-    UNIMPLEMENTED();
+    romfs_file.reset();
+    romfs_dir.reset();
+    sdmc_dir.reset();
+    save_data_dir.reset();
+    nand_dir.reset();
+
+    std::scoped_lock lk{save_data_lock};
+    save_data_controller.reset();
 }
 
 void LoopProcess(Core::System& system) {
@@ -35,6 +35,7 @@ class ServiceManager;
 namespace FileSystem {
 
 class RomFsController;
+class SaveDataController;
 
 enum class ContentStorageId : u32 {
     System,
@@ -62,6 +63,19 @@ public:
     Result OpenBISPartitionStorage(FileSys::VirtualFile* out_bis_partition_storage,
                                    FileSys::BisPartitionId id) const;
 
+    /// Registers the RomFS image of the running application, indexing its directory tree.
+    void RegisterRomFS(FileSys::VirtualFile romfs);
+
+    FileSys::VirtualFile OpenRomFSCurrentProcess() const;
+    FileSys::VirtualDir OpenRomFSDirectoryCurrentProcess() const;
+
+    Result OpenSDMC(FileSys::VirtualDir* out_sdmc) const;
+
+    /// Opens the save data controller of the given program, sharing it between every session so
+    /// that all of them see the same buffered save data.
+    Result OpenSaveDataController(std::shared_ptr<SaveDataController>* out_save_data_controller,
+                                  ProgramId program_id);
+
     u64 GetFreeSpaceSize(FileSys::StorageId id) const;
     u64 GetTotalSpaceSize(FileSys::StorageId id) const;
 
@@ -90,6 +104,15 @@ public:
     void Reset();
 
 private:
+    FileSys::VirtualFile romfs_file;
+    FileSys::VirtualDir romfs_dir;
+    FileSys::VirtualDir sdmc_dir;
+    FileSys::VirtualDir save_data_dir;
+    FileSys::VirtualDir nand_dir;
+
+    std::mutex save_data_lock;
+    std::shared_ptr<SaveDataController> save_data_controller;
+    ProgramId save_data_program_id{};
 
     Core::System& system;
 };
@@ -202,6 +225,12 @@ public:
     Result GetFileTimeStampRaw(FileSys::FileTimeStampRaw* out_time_stamp_raw,
                                const std::string& path) const;
 
+    /**
+     * Write any changes buffered by the archive through to its backing storage
+     * @return Result of the operation
+     */
+    Result Commit() const;
+
 private:
     FileSys::VirtualDir backing;
 };
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "core/file_sys/errors.h"
+#include "core/hle/service/cmif_serialization.h"
+#include "core/hle/service/filesystem/fsp/fs_i_file.h"
+#include "core/hle/service/ipc_helpers.h"
+
+namespace Service::FileSystem {
+
+IFile::IFile(Core::System& system_, FileSys::VirtualFile file_)
+    : ServiceFramework{system_, "IFile"}, backend{std::make_unique<FileSys::Fsa::IFile>(file_)} {
+    // clang-format off
+    static const FunctionInfo functions[] = {
+        {0, &IFile::Read, "Read"},
+        {1, &IFile::Write, "Write"},
+        {2, D<&IFile::Flush>, "Flush"},
+        {3, D<&IFile::SetSize>, "SetSize"},
+        {4, D<&IFile::GetSize>, "GetSize"},
+        {5, nullptr, "OperateRange"},
+        {6, nullptr, "OperateRangeWithBuffer"},
+    };
+    // clang-format on
+    RegisterHandlers(functions);
+}
+
+// Read and Write work on the guest buffer in place, one host contiguous run at a time, so a
+// buffer that is scattered on the host is not staged through a copy either.
+void IFile::Read(HLERequestContext& ctx) {
+    IPC::RequestParser rp{ctx};
+    const auto option = rp.PopRaw<FileSys::ReadOption>();
+    rp.Skip(1, false);
+    const auto offset = rp.Pop<s64>();
+    const auto size = rp.Pop<s64>();
+    LOG_DEBUG(Service_FS, "called, option={}, offset=0x{:X}, length={}", option.value, offset,
+              size);
+
+    const auto result = [&](size_t* out_size) -> Result {
+        R_UNLESS(size >= 0 && static_cast<u64>(size) <= ctx.GetWriteBufferSize(),
+                 FileSys::ResultInvalidSize);
+
+        const auto spans = ctx.WriteBufferSpansB();
+        if (spans.empty() && size != 0) {
+            // Part of the buffer is not mapped, stage it so the mapped part is still written
+            std::vector<u8> buffer(static_cast<size_t>(size));
+            R_TRY(backend->Read(out_size, offset, buffer.data(), buffer.size(), option));
+            ctx.WriteBuffer(buffer.data(), *out_size);
+            R_SUCCEED();
+        }
+
+        size_t total{};
+        for (const auto& span : spans) {
+            const size_t chunk_size = std::min(span.size(), static_cast<size_t>(size) - total);
+            if (chunk_size == 0) {
+                break;
+            }
+            size_t read_size{};
+            R_TRY(backend->Read(&read_size, offset + static_cast<s64>(total), span.data(),
+                                chunk_size, option));
+            total += read_size;
+            if (read_size != chunk_size) {
+                break;
+            }
+        }
+        *out_size = total;
+        R_SUCCEED();
+    };
+
+    size_t read_size{};
+    const Result rc = result(&read_size);
+    if (rc.IsError()) {
+        IPC::ResponseBuilder rb{ctx, 2};
+        rb.Push(rc);
+        return;
+    }
+
+    IPC::ResponseBuilder rb{ctx, 4};
+    rb.Push(ResultSuccess);
+    rb.Push(static_cast<s64>(read_size));
+}
+
+void IFile::Write(HLERequestContext& ctx) {
+    IPC::RequestParser rp{ctx};
+    const auto option = rp.PopRaw<FileSys::WriteOption>();
+    rp.Skip(1, false);
+    const auto offset = rp.Pop<s64>();
+    const auto size = rp.Pop<s64>();
+    LOG_DEBUG(Service_FS, "called, option={}, offset=0x{:X}, length={}", option.value, offset,
+              size);
+
+    const auto result = [&]() -> Result {
+        R_UNLESS(size >= 0 && static_cast<u64>(size) <= ctx.GetReadBufferSize(),
+                 FileSys::ResultInvalidSize);
+
+        const auto spans = ctx.ReadBufferSpans();
+        if (spans.empty() || size == 0) {
+            const auto buffer = ctx.ReadBuffer();
+            R_RETURN(backend->Write(offset, buffer.data(), static_cast<size_t>(size), option));
+        }
+
+        // Only the last piece carries the flush, the earlier ones are part of the same write
+        size_t total{};
+        for (const auto& span : spans) {
+            const size_t chunk_size = std::min(span.size(), static_cast<size_t>(size) - total);
+            if (chunk_size == 0) {
+                break;
+            }
+            const bool is_last = total + chunk_size == static_cast<size_t>(size);
+            R_TRY(backend->Write(offset + static_cast<s64>(total), span.data(), chunk_size,
+                                 is_last ? option : FileSys::WriteOption::None));
+            total += chunk_size;
+        }
+        R_SUCCEED();
+    };
+
+    IPC::ResponseBuilder rb{ctx, 2};
+    rb.Push(result());
+}
+
+Result IFile::GetSize(Out<s64> out_size) {
+    LOG_DEBUG(Service_FS, "called");
+
+    R_RETURN(backend->GetSize(out_size));
+}
+
+Result IFile::Flush() {
+    LOG_DEBUG(Service_FS, "called");
+
+    R_RETURN(backend->Flush());
+}
+
+Result IFile::SetSize(s64 size) {
+    LOG_DEBUG(Service_FS, "called, size={}", size);
+
+    R_RETURN(backend->SetSize(size));
+}
+
+} // namespace Service::FileSystem
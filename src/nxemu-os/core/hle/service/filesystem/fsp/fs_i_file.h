@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "core/file_sys/fs_file.h"
+#include "core/file_sys/fsa/fs_i_file.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/hle/service/cmif_types.h"
+#include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/service.h"
+
+namespace Service::FileSystem {
+
+class IFile final : public ServiceFramework<IFile> {
+public:
+    explicit IFile(Core::System& system_, FileSys::VirtualFile file_);
+
+private:
+    std::unique_ptr<FileSys::Fsa::IFile> backend;
+
+    void Read(HLERequestContext& ctx);
+    void Write(HLERequestContext& ctx);
+    Result Flush();
+    Result SetSize(s64 size);
+    Result GetSize(Out<s64> out_size);
+};
+
+} // namespace Service::FileSystem
@@ -48,7 +48,7 @@ FSP_SRV::FSP_SRV(Core::System& system_)
     static const FunctionInfo functions[] = {
         {0, nullptr, "OpenFileSystem"},
         {1, D<&FSP_SRV::SetCurrentProcess>, "SetCurrentProcess"},
-        {2, nullptr, "OpenDataFileSystemByCurrentProcess"},
+        {2, D<&FSP_SRV::OpenDataFileSystemByCurrentProcess>, "OpenDataFileSystemByCurrentProcess"},
         {7, D<&FSP_SRV::OpenFileSystemWithPatch>, "OpenFileSystemWithPatch"},
         {8, nullptr, "OpenFileSystemWithId"},
         {9, nullptr, "OpenDataFileSystemByApplicationId"},
@@ -59,8 +59,8 @@ FSP_SRV::FSP_SRV(Core::System& system_)
         {18, D<&FSP_SRV::OpenSdCardFileSystem>, "OpenSdCardFileSystem"},
         {19, nullptr, "FormatSdCardFileSystem"},
         {21, nullptr, "DeleteSaveDataFileSystem"},
-        {22, nullptr, "CreateSaveDataFileSystem"},
-        {23, nullptr, "CreateSaveDataFileSystemBySystemSaveDataId"},
+        {22, D<&FSP_SRV::CreateSaveDataFileSystem>, "CreateSaveDataFileSystem"},
+        {23, D<&FSP_SRV::CreateSaveDataFileSystemBySystemSaveDataId>, "CreateSaveDataFileSystemBySystemSaveDataId"},
         {24, nullptr, "RegisterSaveDataFileSystemAtomicDeletion"},
         {25, nullptr, "DeleteSaveDataFileSystemBySaveDataSpaceId"},
         {26, nullptr, "FormatSdCardDryRun"},
@@ -73,9 +73,9 @@ FSP_SRV::FSP_SRV(Core::System& system_)
         {34, D<&FSP_SRV::GetCacheStorageSize>, "GetCacheStorageSize"},
         {35, nullptr, "CreateSaveDataFileSystemByHashSalt"},
         {36, nullptr, "OpenHostFileSystemWithOption"},
-        {51, nullptr, "OpenSaveDataFileSystem"},
-        {52, nullptr, "OpenSaveDataFileSystemBySystemSaveDataId"},
-        {53, nullptr, "OpenReadOnlySaveDataFileSystem"},
+        {51, D<&FSP_SRV::OpenSaveDataFileSystem>, "OpenSaveDataFileSystem"},
+        {52, D<&FSP_SRV::OpenSaveDataFileSystemBySystemSaveDataId>, "OpenSaveDataFileSystemBySystemSaveDataId"},
+        {53, D<&FSP_SRV::OpenReadOnlySaveDataFileSystem>, "OpenReadOnlySaveDataFileSystem"},
         {57, D<&FSP_SRV::ReadSaveDataFileSystemExtraDataBySaveDataSpaceId>, "ReadSaveDataFileSystemExtraDataBySaveDataSpaceId"},
         {58, D<&FSP_SRV::ReadSaveDataFileSystemExtraData>, "ReadSaveDataFileSystemExtraData"},
         {59, D<&FSP_SRV::WriteSaveDataFileSystemExtraData>, "WriteSaveDataFileSystemExtraData"},
@@ -182,9 +182,12 @@ FSP_SRV::~FSP_SRV() = default;
 
 Result FSP_SRV::SetCurrentProcess(ClientProcessId pid) {
     current_process_id = *pid;
+    program_id = system.GetApplicationProcessProgramID();
 
-    UNIMPLEMENTED();
-    R_SUCCEED();
+    LOG_DEBUG(Service_FS, "called. current_process_id=0x{:016X}, program_id=0x{:016X}",
+              current_process_id, program_id);
+
+    R_RETURN(fsc.OpenSaveDataController(&save_data_controller, program_id));
 }
 
 Result FSP_SRV::OpenFileSystemWithPatch(OutInterface<IFileSystem> out_interface,
@@ -194,10 +197,85 @@ Result FSP_SRV::OpenFileSystemWithPatch(OutInterface<IFileSystem> out_interface,
 }
 
 Result FSP_SRV::OpenSdCardFileSystem(OutInterface<IFileSystem> out_interface) {
-    UNIMPLEMENTED();
+    LOG_DEBUG(Service_FS, "called");
+
+    FileSys::VirtualDir sdmc_dir{};
+    R_TRY(fsc.OpenSDMC(&sdmc_dir));
+
+    *out_interface = std::make_shared<IFileSystem>(
+        system, sdmc_dir, SizeGetter::FromStorageId(fsc, FileSys::StorageId::SdCard));
+
     R_SUCCEED();
 }
 
+Result FSP_SRV::CreateSaveDataFileSystem(FileSys::SaveDataCreationInfo save_create_struct,
+                                         FileSys::SaveDataAttribute save_struct, u128 uid) {
+    LOG_DEBUG(Service_FS, "called save_struct = {}, uid = {:016X}{:016X}", save_struct.DebugInfo(),
+              uid[1], uid[0]);
+    R_UNLESS(save_data_controller != nullptr, FileSys::ResultTargetNotFound);
+
+    FileSys::VirtualDir save_data_dir{};
+    R_RETURN(save_data_controller->CreateSaveData(&save_data_dir, FileSys::SaveDataSpaceId::User,
+                                                  save_struct));
+}
+
+Result FSP_SRV::CreateSaveDataFileSystemBySystemSaveDataId(
+    FileSys::SaveDataAttribute save_struct, FileSys::SaveDataCreationInfo save_create_struct) {
+    LOG_DEBUG(Service_FS, "called save_struct = {}", save_struct.DebugInfo());
+    R_UNLESS(save_data_controller != nullptr, FileSys::ResultTargetNotFound);
+
+    FileSys::VirtualDir save_data_dir{};
+    R_RETURN(save_data_controller->CreateSaveData(&save_data_dir, FileSys::SaveDataSpaceId::System,
+                                                  save_struct));
+}
+
+Result FSP_SRV::OpenSaveDataFileSystem(OutInterface<IFileSystem> out_interface,
+                                       FileSys::SaveDataSpaceId space_id,
+                                       FileSys::SaveDataAttribute attribute) {
+    LOG_INFO(Service_FS, "called, space_id={}, save_struct={}", space_id, attribute.DebugInfo());
+    R_UNLESS(save_data_controller != nullptr, FileSys::ResultTargetNotFound);
+
+    FileSys::VirtualDir dir{};
+    R_TRY(save_data_controller->OpenSaveData(&dir, space_id, attribute));
+
+    FileSys::StorageId id{};
+    switch (space_id) {
+    case FileSys::SaveDataSpaceId::User:
+        id = FileSys::StorageId::NandUser;
+        break;
+    case FileSys::SaveDataSpaceId::SdSystem:
+    case FileSys::SaveDataSpaceId::SdUser:
+        id = FileSys::StorageId::SdCard;
+        break;
+    case FileSys::SaveDataSpaceId::System:
+        id = FileSys::StorageId::NandSystem;
+        break;
+    case FileSys::SaveDataSpaceId::Temporary:
+    case FileSys::SaveDataSpaceId::ProperSystem:
+    case FileSys::SaveDataSpaceId::SafeMode:
+        ASSERT(false);
+    }
+
+    *out_interface =
+        std::make_shared<IFileSystem>(system, std::move(dir), SizeGetter::FromStorageId(fsc, id));
+
+    R_SUCCEED();
+}
+
+Result FSP_SRV::OpenSaveDataFileSystemBySystemSaveDataId(OutInterface<IFileSystem> out_interface,
+                                                         FileSys::SaveDataSpaceId space_id,
+                                                         FileSys::SaveDataAttribute attribute) {
+    LOG_WARNING(Service_FS, "(STUBBED) called, delegating to 51 OpenSaveDataFilesystem");
+    R_RETURN(OpenSaveDataFileSystem(out_interface, space_id, attribute));
+}
+
+Result FSP_SRV::OpenReadOnlySaveDataFileSystem(OutInterface<IFileSystem> out_interface,
+                                               FileSys::SaveDataSpaceId space_id,
+                                               FileSys::SaveDataAttribute attribute) {
+    LOG_WARNING(Service_FS, "(STUBBED) called, delegating to 51 OpenSaveDataFilesystem");
+    R_RETURN(OpenSaveDataFileSystem(out_interface, space_id, attribute));
+}
+
 Result FSP_SRV::FindSaveDataWithFilter(Out<s64> out_count,
                                        OutBuffer<BufferAttr_HipcMapAlias> out_buffer,
                                        FileSys::SaveDataSpaceId space_id,
@@ -276,8 +354,33 @@ Result FSP_SRV::ReadSaveDataFileSystemExtraDataBySaveDataSpaceId(
     R_SUCCEED();
 }
 
+Result FSP_SRV::OpenDataFileSystemByCurrentProcess(OutInterface<IFileSystem> out_interface) {
+    LOG_DEBUG(Service_FS, "called");
+
+    auto romfs_dir = fsc.OpenRomFSDirectoryCurrentProcess();
+    if (romfs_dir == nullptr) {
+        LOG_ERROR(Service_FS, "No RomFS available for the current process");
+        R_THROW(FileSys::ResultTargetNotFound);
+    }
+
+    // The RomFS is read only, so it is always full
+    const auto romfs_size = fsc.OpenRomFSCurrentProcess()->GetSize();
+    *out_interface = std::make_shared<IFileSystem>(
+        system, std::move(romfs_dir),
+        SizeGetter{[] { return u64{0}; }, [romfs_size] { return u64{romfs_size}; }});
+    R_SUCCEED();
+}
+
 Result FSP_SRV::OpenDataStorageByCurrentProcess(OutInterface<IStorage> out_interface) {
-    UNIMPLEMENTED();
+    LOG_DEBUG(Service_FS, "called");
+
+    auto romfs = fsc.OpenRomFSCurrentProcess();
+    if (romfs == nullptr) {
+        LOG_ERROR(Service_FS, "No RomFS available for the current process");
+        R_THROW(FileSys::ResultTargetNotFound);
+    }
+
+    *out_interface = std::make_shared<IStorage>(system, std::move(romfs));
     R_SUCCEED();
 }
 
@@ -271,6 +271,12 @@ Result HLERequestContext::PopulateFromIncomingCommandBuffer(u32_le* src_cmdbuf)
 }
 
 Result HLERequestContext::WriteToOutgoingCommandBuffer() {
+    // The handler is done with any buffer it was given in place, let the GPU see the writes
+    for (const auto& [address, size] : written_buffer_ranges) {
+        memory.InvalidateRegion(address, size);
+    }
+    written_buffer_ranges.clear();
+
     auto current_offset = handles_offset;
     auto& owner_process = *thread->GetOwnerProcess();
     auto& handle_table = owner_process.GetHandleTable();
@@ -383,6 +389,63 @@ std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) cons
     }
 }
 
+std::span<const std::span<u8>> HLERequestContext::ReadBufferSpans(
+    std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+
+    ASSERT_OR_EXECUTE_MSG(
+        read_buffer_spans.size() > buffer_index, { return {}; },
+        "ReadBufferSpans invalid buffer_index {}", buffer_index);
+    auto& spans{read_buffer_spans[buffer_index]};
+    if (is_buffer_a) {
+        memory.GetHostSpans(BufferDescriptorA()[buffer_index].Address(),
+                            BufferDescriptorA()[buffer_index].Size(), false, spans);
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorX().size() > buffer_index, { return {}; },
+            "BufferDescriptorX invalid buffer_index {}", buffer_index);
+        memory.GetHostSpans(BufferDescriptorX()[buffer_index].Address(),
+                            BufferDescriptorX()[buffer_index].Size(), false, spans);
+    }
+    return spans;
+}
+
+std::span<const std::span<u8>> HLERequestContext::WriteBufferSpans(
+    std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    return is_buffer_b ? WriteBufferSpansB(buffer_index) : WriteBufferSpansC(buffer_index);
+}
+
+std::span<const std::span<u8>> HLERequestContext::WriteBufferSpansB(
+    std::size_t buffer_index) const {
+    ASSERT_OR_EXECUTE_MSG(
+        BufferDescriptorB().size() > buffer_index && write_buffer_spans.size() > buffer_index,
+        { return {}; }, "BufferDescriptorB invalid buffer_index {}", buffer_index);
+    auto& spans{write_buffer_spans[buffer_index]};
+    if (memory.GetHostSpans(BufferDescriptorB()[buffer_index].Address(),
+                            BufferDescriptorB()[buffer_index].Size(), true, spans)) {
+        written_buffer_ranges.emplace_back(BufferDescriptorB()[buffer_index].Address(),
+                                           BufferDescriptorB()[buffer_index].Size());
+    }
+    return spans;
+}
+
+std::span<const std::span<u8>> HLERequestContext::WriteBufferSpansC(
+    std::size_t buffer_index) const {
+    ASSERT_OR_EXECUTE_MSG(
+        BufferDescriptorC().size() > buffer_index && write_buffer_spans.size() > buffer_index,
+        { return {}; }, "BufferDescriptorC invalid buffer_index {}", buffer_index);
+    auto& spans{write_buffer_spans[buffer_index]};
+    if (memory.GetHostSpans(BufferDescriptorC()[buffer_index].Address(),
+                            BufferDescriptorC()[buffer_index].Size(), true, spans)) {
+        written_buffer_ranges.emplace_back(BufferDescriptorC()[buffer_index].Address(),
+                                           BufferDescriptorC()[buffer_index].Size());
+    }
+    return spans;
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
@@ -10,6 +10,7 @@
 #include <span>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "yuzu_common/yuzu_assert.h"
@@ -269,6 +270,25 @@ public:
     /// Helper function to read a copy of a buffer using the appropriate buffer descriptor
     [[nodiscard]] std::vector<u8> ReadBufferCopy(std::size_t buffer_index = 0) const;
 
+    /// Helper function to get the host memory backing a buffer using the appropriate buffer
+    /// descriptor, one span per host contiguous run. The spans must not be written to.
+    [[nodiscard]] std::span<const std::span<u8>> ReadBufferSpans(
+        std::size_t buffer_index = 0) const;
+
+    /// Helper function to get the host memory backing a buffer using the appropriate buffer
+    /// descriptor, one span per host contiguous run, so the response can be written in place.
+    /// The GPU is told about the write when the reply is written to the outgoing command buffer.
+    [[nodiscard]] std::span<const std::span<u8>> WriteBufferSpans(
+        std::size_t buffer_index = 0) const;
+
+    /// Helper function to get the host memory backing buffer B, one span per host contiguous run
+    [[nodiscard]] std::span<const std::span<u8>> WriteBufferSpansB(
+        std::size_t buffer_index = 0) const;
+
+    /// Helper function to get the host memory backing buffer C, one span per host contiguous run
+    [[nodiscard]] std::span<const std::span<u8>> WriteBufferSpansC(
+        std::size_t buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
@@ -389,6 +409,15 @@ public:
         is_deferred = is_deferred_;
     }
 
+    /// Host time the client sent the request, zero unless IPC profiling was enabled.
+    u64 GetSendTime() const {
+        return send_time;
+    }
+
+    void SetSendTime(u64 send_time_) {
+        send_time = send_time_;
+    }
+
 private:
     friend class IPC::ResponseBuilder;
 
@@ -425,12 +454,17 @@ private:
 
     std::weak_ptr<SessionRequestManager> manager{};
     bool is_deferred{false};
+    u64 send_time{};
 
     Kernel::KernelCore& kernel;
     Core::Memory::Memory& memory;
 
     mutable std::array<Common::ScratchBuffer<u8>, 3> read_buffer_data_a{};
     mutable std::array<Common::ScratchBuffer<u8>, 3> read_buffer_data_x{};
+    mutable std::array<std::vector<std::span<u8>>, 3> read_buffer_spans{};
+    mutable std::array<std::vector<std::span<u8>>, 3> write_buffer_spans{};
+    /// Guest ranges handed out by WriteBufferSpans, invalidated once the reply is written
+    mutable std::vector<std::pair<VAddr, std::size_t>> written_buffer_ranges;
 };
 
 } // namespace Service
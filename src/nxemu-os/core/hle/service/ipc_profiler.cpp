@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include "core/hle/service/ipc_profiler.h"
+
+namespace Service {
+
+void IpcProfiler::SetEnabled(bool enabled_) {
+    enabled.store(enabled_, std::memory_order_relaxed);
+}
+
+u64 IpcProfiler::Now() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+
+void IpcProfiler::RecordRequest(const std::string& service, const char* name, u32 command,
+                                bool tipc, u64 send_time, u64 start_time, u64 end_time) {
+    const u64 handler_ns = end_time - start_time;
+    // Requests sent before profiling was enabled have no send time
+    const u64 queue_ns = send_time != 0 && send_time < start_time ? start_time - send_time : 0;
+    const std::size_t bucket =
+        std::min<std::size_t>(std::bit_width(handler_ns / 1000), NumHistogramBuckets - 1);
+
+    std::scoped_lock lk{mutex};
+    auto [it, inserted] = commands.try_emplace(CommandKey{service, command, tipc});
+    CommandStats& stats = it->second;
+    if (inserted) {
+        stats.service = service;
+        stats.name = name;
+        stats.command = command;
+        stats.tipc = tipc;
+    }
+    stats.calls++;
+    stats.handler_ns += handler_ns;
+    stats.handler_max_ns = std::max(stats.handler_max_ns, handler_ns);
+    stats.queue_ns += queue_ns;
+    stats.queue_max_ns = std::max(stats.queue_max_ns, queue_ns);
+    stats.handler_histogram[bucket]++;
+}
+
+void IpcProfiler::RecordDispatch(u64 wait_ns, u64 process_ns) {
+    std::scoped_lock lk{mutex};
+    dispatch.requests++;
+    dispatch.wait_ns += wait_ns;
+    dispatch.process_ns += process_ns;
+}
+
+std::vector<IpcProfiler::CommandStats> IpcProfiler::GetCommandStats() const {
+    std::vector<CommandStats> result;
+    {
+        std::scoped_lock lk{mutex};
+        result.reserve(commands.size());
+        for (const auto& [key, stats] : commands) {
+            result.push_back(stats);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const CommandStats& a, const CommandStats& b) {
+        return a.handler_ns > b.handler_ns;
+    });
+    return result;
+}
+
+IpcProfiler::DispatchStats IpcProfiler::GetDispatchStats() const {
+    std::scoped_lock lk{mutex};
+    return dispatch;
+}
+
+void IpcProfiler::Reset() {
+    std::scoped_lock lk{mutex};
+    commands.clear();
+    dispatch = {};
+}
+
+} // namespace Service
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "yuzu_common/common_types.h"
+
+namespace Service {
+
+/**
+ * Collects per service, per command call counts and host timings of HLE IPC requests. All public
+ * functions are thread-safe; recording is skipped entirely while the profiler is disabled.
+ */
+class IpcProfiler {
+public:
+    /// Bucket 0 counts handlers under 1us, bucket n those under 2^n us, the last takes the rest.
+    static constexpr std::size_t NumHistogramBuckets = 16;
+
+    struct CommandStats {
+        std::string service;
+        std::string name;
+        u32 command{};
+        bool tipc{};
+        u64 calls{};
+        u64 handler_ns{};
+        u64 handler_max_ns{};
+        /// Host time from the client sending the request to its handler starting.
+        u64 queue_ns{};
+        u64 queue_max_ns{};
+        std::array<u64, NumHistogramBuckets> handler_histogram{};
+    };
+
+    struct DispatchStats {
+        u64 requests{};
+        /// Time service threads spent waiting for a session or port to be signalled.
+        u64 wait_ns{};
+        /// Time service threads spent receiving, handling and replying to requests.
+        u64 process_ns{};
+    };
+
+    bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled_);
+
+    /// Host timestamp in nanoseconds used for all recorded times.
+    static u64 Now();
+
+    void RecordRequest(const std::string& service, const char* name, u32 command, bool tipc,
+                       u64 send_time, u64 start_time, u64 end_time);
+    void RecordDispatch(u64 wait_ns, u64 process_ns);
+
+    /// Returns the recorded commands, most total handler time first.
+    std::vector<CommandStats> GetCommandStats() const;
+    DispatchStats GetDispatchStats() const;
+    void Reset();
+
+private:
+    using CommandKey = std::tuple<std::string, u32, bool>;
+
+    std::atomic<bool> enabled{};
+    mutable std::mutex mutex;
+    std::map<CommandKey, CommandStats> commands;
+    DispatchStats dispatch{};
+};
+
+} // namespace Service
@@ -16,6 +16,26 @@
 
 namespace Service::Nvidia {
 
+namespace {
+// The output goes straight into guest memory when the buffer is host contiguous. Every device
+// copies its arguments out of the input before it writes any output, so the guest buffer may
+// alias the input the way libnx passes it.
+std::span<u8> GetIoctlOutput(HLERequestContext& ctx, std::size_t buffer_index, bool is_out,
+                             Common::ScratchBuffer<u8>& staging, bool& in_place) {
+    const std::size_t size = ctx.GetWriteBufferSize(buffer_index);
+    in_place = false;
+    if (is_out && size != 0) {
+        const auto spans = ctx.WriteBufferSpans(buffer_index);
+        if (spans.size() == 1 && spans[0].size() == size) {
+            in_place = true;
+            return spans[0];
+        }
+    }
+    staging.resize_destructive(size);
+    return staging;
+}
+} // Anonymous namespace
+
 void NVDRV::Open(HLERequestContext& ctx) {
     LOG_DEBUG(Service_NVDRV, "called");
     IPC::ResponseBuilder rb{ctx, 4};
@@ -65,11 +85,13 @@ void NVDRV::Ioctl1(HLERequestContext& ctx) {
     }
 
     // Check device
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    bool output_in_place{};
+    const auto output =
+        GetIoctlOutput(ctx, 0, command.is_out != 0, output_buffer, output_in_place);
     const auto input_buffer = ctx.ReadBuffer(0);
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
-    if (command.is_out != 0) {
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output);
+    if (command.is_out != 0 && !output_in_place) {
         ctx.WriteBuffer(output_buffer);
     }
 
@@ -92,11 +114,13 @@ void NVDRV::Ioctl2(HLERequestContext& ctx) {
 
     const auto input_buffer = ctx.ReadBuffer(0);
     const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    bool output_in_place{};
+    const auto output =
+        GetIoctlOutput(ctx, 0, command.is_out != 0, output_buffer, output_in_place);
 
     const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
-    if (command.is_out != 0) {
+        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output);
+    if (command.is_out != 0 && !output_in_place) {
         ctx.WriteBuffer(output_buffer);
     }
 
@@ -118,14 +142,21 @@ void NVDRV::Ioctl3(HLERequestContext& ctx) {
     }
 
     const auto input_buffer = ctx.ReadBuffer(0);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
-    inline_output_buffer.resize_destructive(ctx.GetWriteBufferSize(1));
-
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, inline_output_buffer);
+    bool output_in_place{};
+    bool inline_output_in_place{};
+    const auto output =
+        GetIoctlOutput(ctx, 0, command.is_out != 0, output_buffer, output_in_place);
+    const auto inline_output = GetIoctlOutput(ctx, 1, command.is_out != 0, inline_output_buffer,
+                                              inline_output_in_place);
+
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input_buffer, output, inline_output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(inline_output_buffer, 1);
+        if (!output_in_place) {
+            ctx.WriteBuffer(output_buffer, 0);
+        }
+        if (!inline_output_in_place) {
+            ctx.WriteBuffer(inline_output_buffer, 1);
+        }
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -15,6 +15,7 @@
 #include "core/hle/kernel/svc_results.h"
 #include "core/hle/service/hle_ipc.h"
 #include "core/hle/service/ipc_helpers.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/server_manager.h"
 #include "core/hle/service/sm/sm.h"
 
@@ -116,14 +117,65 @@ ServerManager::~ServerManager() {
         m_deferral_event->GetReadableEvent().Close();
         // Write event is owned by ServiceManager
     }
+
+    // Adopted managers go last, sessions served above may still have referenced them.
+    m_adopted.clear();
 }
 
 void ServerManager::RunServer(std::unique_ptr<ServerManager>&& server_manager) {
     server_manager->m_system.RunServer(std::move(server_manager));
 }
 
+void ServerManager::HostServers(const std::function<void()>& func) {
+    auto& kernel = m_system.Kernel();
+    kernel.SetServerHost(this);
+    SCOPE_EXIT {
+        kernel.SetServerHost(nullptr);
+    };
+
+    func();
+}
+
+void ServerManager::Adopt(std::unique_ptr<ServerManager>&& server_manager) {
+    auto& other = *server_manager;
+
+    // Deferrals and extra host threads belong to a single loop, those servers must run alone.
+    ASSERT(other.m_deferral_event == nullptr);
+    ASSERT(other.m_threads.empty());
+
+    {
+        std::scoped_lock lk{m_deferred_list_mutex, other.m_deferred_list_mutex};
+
+        // Take over the ports and sessions along with their pending waits.
+        other.m_wakeup_holder->UnlinkFromMultiWait();
+        m_deferred_list.MoveAll(std::addressof(other.m_deferred_list));
+        while (!other.m_servers.empty()) {
+            auto& port = other.m_servers.front();
+            other.m_servers.pop_front();
+            m_servers.push_back(port);
+        }
+        while (!other.m_sessions.empty()) {
+            auto& session = other.m_sessions.front();
+            other.m_sessions.pop_front();
+            m_sessions.push_back(session);
+        }
+
+        // The adopted manager never loops, nothing has to wait for it when it is destroyed.
+        other.m_host = this;
+        other.m_stopped.Set();
+        m_adopted.emplace_back(std::move(server_manager));
+    }
+
+    m_wakeup_event->Signal();
+}
+
 Result ServerManager::RegisterSession(Kernel::KServerSession* server_session,
                                       std::shared_ptr<SessionRequestManager> manager) {
+    // Sessions opened through an adopted manager are served by its host.
+    if (m_host != nullptr) {
+        R_RETURN(m_host->RegisterSession(server_session, std::move(manager)));
+    }
+
     // We are taking ownership of the server session, so don't open it.
     auto* session = new Session(server_session, std::move(manager));
 
@@ -304,8 +356,16 @@ Result ServerManager::Process(MultiWaitHolder* holder) {
 }
 
 bool ServerManager::WaitAndProcessImpl() {
+    auto& profiler = m_system.IpcProfiler();
+    const bool profiling = profiler.IsEnabled();
+    const u64 wait_start = profiling ? IpcProfiler::Now() : 0;
+
     if (auto* signaled_holder = this->WaitSignaled(); signaled_holder != nullptr) {
+        const u64 process_start = profiling ? IpcProfiler::Now() : 0;
         R_ASSERT(this->Process(signaled_holder));
+        if (profiling) {
+            profiler.RecordDispatch(process_start - wait_start, IpcProfiler::Now() - process_start);
+        }
         return true;
     } else {
         return false;
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -50,6 +52,11 @@ public:
     Result LoopProcess();
     void StartAdditionalHostThreads(const char* name, size_t num_threads);
 
+    // Runs func with every server it starts on the calling thread merged into this one, so their
+    // ports and sessions are all served by this manager's loop instead of a thread each.
+    void HostServers(const std::function<void()>& func);
+    void Adopt(std::unique_ptr<ServerManager>&& server);
+
     static void RunServer(std::unique_ptr<ServerManager>&& server);
 
 private:
@@ -88,6 +95,10 @@ private:
     std::optional<MultiWaitHolder> m_wakeup_holder{};
     std::optional<MultiWaitHolder> m_deferral_holder{};
 
+    // Shared hosting, an adopted manager forwards new sessions to its host
+    ServerManager* m_host{};
+    std::vector<std::unique_ptr<ServerManager>> m_adopted{};
+
     // Host state tracking
     Common::Event m_stopped{};
     std::vector<std::jthread> m_threads{};
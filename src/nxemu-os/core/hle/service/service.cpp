@@ -9,6 +9,7 @@
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/service/ipc_helpers.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sm/sm.h"
 
@@ -88,7 +89,7 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info, false);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
@@ -102,7 +103,21 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, *info, true);
+}
+
+void ServiceFrameworkBase::InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info,
+                                         bool tipc) {
+    auto& profiler = system.IpcProfiler();
+    if (!profiler.IsEnabled()) {
+        handler_invoker(this, info.handler_callback, ctx);
+        return;
+    }
+
+    const u64 start_time = IpcProfiler::Now();
+    handler_invoker(this, info.handler_callback, ctx);
+    profiler.RecordRequest(service_name, info.name, ctx.GetCommand(), tipc, ctx.GetSendTime(),
+                           start_time, IpcProfiler::Now());
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
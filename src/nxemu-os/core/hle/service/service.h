@@ -104,6 +104,7 @@ private:
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(HLERequestContext& ctx, const FunctionInfoBase* info);
+    void InvokeHandler(HLERequestContext& ctx, const FunctionInfoBase& info, bool tipc);
 
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
@@ -3,6 +3,13 @@
 
 #include "core/hle/service/services.h"
 
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yuzu_common/settings.h"
+
 #include "core/hle/service/acc/acc.h"
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/aoc/addon_content_manager.h"
@@ -46,6 +53,7 @@
 #include "core/hle/service/psc/psc.h"
 #include "core/hle/service/ptm/ptm.h"
 #include "core/hle/service/ro/ro.h"
+#include "core/hle/service/server_manager.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/set/settings.h"
 #include "core/hle/service/sm/sm.h"
@@ -65,51 +73,92 @@ Services::Services(std::shared_ptr<SM::ServiceManager>& sm, Core::System& system
     kernel.RunOnHostCoreProcess("Loader",     [&] { LDR::LoopProcess(system); }).detach();
     kernel.RunOnHostCoreProcess("nvservices", [&] { Nvidia::LoopProcess(system); }).detach();
     kernel.RunOnHostCoreProcess("vi",         [&, token] { VI::LoopProcess(system, token); }).detach();
-
-    kernel.RunOnGuestCoreProcess("sm",         [&] { SM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("account",    [&] { Account::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("am",         [&] { AM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("aoc",        [&] { AOC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("apm",        [&] { APM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("bpc",        [&] { BPC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("btdrv",      [&] { BtDrv::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("btm",        [&] { BTM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("capsrv",     [&] { Capture::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("erpt",       [&] { ERPT::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("es",         [&] { ES::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("eupld",      [&] { EUPLD::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("fatal",      [&] { Fatal::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("fgm",        [&] { FGM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("friends",    [&] { Friend::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("settings",   [&] { Set::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("psc",        [&] { PSC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("glue",       [&] { Glue::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("grc",        [&] { GRC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("hid",        [&] { HID::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("lbl",        [&] { LBL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("LogManager.Prod", [&] { LM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mig",        [&] { Migration::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mii",        [&] { Mii::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mm",         [&] { MM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mnpp",       [&] { MNPP::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nvnflinger", [&] { Nvnflinger::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("NCM",        [&] { NCM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ngc",        [&] { NGC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nim",        [&] { NIM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("npns",       [&] { NPNS::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ns",         [&] { NS::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("olsc",       [&] { OLSC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("omm",        [&] { OMM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pcie",       [&] { PCIe::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pctl",       [&] { PCTL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pcv",        [&] { PCV::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("prepo",      [&] { PlayReport::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ProcessManager", [&] { PM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ptm",        [&] { PTM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ro",         [&] { RO::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("spl",        [&] { SPL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("usb",        [&] { USB::LoopProcess(system); });
     // clang-format on
+
+    // Started in the same order as before the shared host existed. The shareable ones rarely see
+    // traffic and can be served from the shared service host, the rest are busy or block in
+    // their handlers.
+    struct GuestService {
+        std::string name;
+        std::function<void()> loop_process;
+        bool shareable;
+    };
+    const std::vector<GuestService> guest_services{
+        // clang-format off
+        {"sm",              [&] { SM::LoopProcess(system); },          false},
+        {"account",         [&] { Account::LoopProcess(system); },     true},
+        {"am",              [&] { AM::LoopProcess(system); },          false},
+        {"aoc",             [&] { AOC::LoopProcess(system); },         true},
+        {"apm",             [&] { APM::LoopProcess(system); },         true},
+        {"bpc",             [&] { BPC::LoopProcess(system); },         true},
+        {"btdrv",           [&] { BtDrv::LoopProcess(system); },       true},
+        {"btm",             [&] { BTM::LoopProcess(system); },         true},
+        {"capsrv",          [&] { Capture::LoopProcess(system); },     true},
+        {"erpt",            [&] { ERPT::LoopProcess(system); },        true},
+        {"es",              [&] { ES::LoopProcess(system); },          true},
+        {"eupld",           [&] { EUPLD::LoopProcess(system); },       true},
+        {"fatal",           [&] { Fatal::LoopProcess(system); },       true},
+        {"fgm",             [&] { FGM::LoopProcess(system); },         true},
+        {"friends",         [&] { Friend::LoopProcess(system); },      true},
+        {"settings",        [&] { Set::LoopProcess(system); },         true},
+        {"psc",             [&] { PSC::LoopProcess(system); },         false},
+        {"glue",            [&] { Glue::LoopProcess(system); },        false},
+        {"grc",             [&] { GRC::LoopProcess(system); },         true},
+        {"hid",             [&] { HID::LoopProcess(system); },         false},
+        {"lbl",             [&] { LBL::LoopProcess(system); },         true},
+        {"LogManager.Prod", [&] { LM::LoopProcess(system); },          true},
+        {"mig",             [&] { Migration::LoopProcess(system); },   true},
+        {"mii",             [&] { Mii::LoopProcess(system); },         true},
+        {"mm",              [&] { MM::LoopProcess(system); },          true},
+        {"mnpp",            [&] { MNPP::LoopProcess(system); },        true},
+        {"nvnflinger",      [&] { Nvnflinger::LoopProcess(system); },  false},
+        {"NCM",             [&] { NCM::LoopProcess(system); },         true},
+        {"ngc",             [&] { NGC::LoopProcess(system); },         true},
+        {"nim",             [&] { NIM::LoopProcess(system); },         true},
+        {"npns",            [&] { NPNS::LoopProcess(system); },        true},
+        {"ns",              [&] { NS::LoopProcess(system); },          true},
+        {"olsc",            [&] { OLSC::LoopProcess(system); },        true},
+        {"omm",             [&] { OMM::LoopProcess(system); },         true},
+        {"pcie",            [&] { PCIe::LoopProcess(system); },        true},
+        {"pctl",            [&] { PCTL::LoopProcess(system); },        true},
+        {"pcv",             [&] { PCV::LoopProcess(system); },         true},
+        {"prepo",           [&] { PlayReport::LoopProcess(system); },  true},
+        {"ProcessManager",  [&] { PM::LoopProcess(system); },          true},
+        {"ptm",             [&] { PTM::LoopProcess(system); },         true},
+        {"ro",              [&] { RO::LoopProcess(system); },          true},
+        {"spl",             [&] { SPL::LoopProcess(system); },         true},
+        {"usb",             [&] { USB::LoopProcess(system); },         true},
+        // clang-format on
+    };
+
+    const bool shared = Settings::values.shared_service_host.GetValue();
+    std::vector<std::function<void()>> shared_services;
+    for (const auto& service : guest_services) {
+        if (!shared || !service.shareable) {
+            kernel.RunOnGuestCoreProcess(std::string{service.name}, service.loop_process);
+        } else if (service.name == "settings") {
+            // The shared services are created one after another on a single thread, and btm
+            // blocks on set:sys while it is created, so settings has to come first there
+            shared_services.insert(shared_services.begin(), service.loop_process);
+        } else {
+            shared_services.push_back(service.loop_process);
+        }
+    }
+    if (!shared) {
+        return;
+    }
+
+    // Shared mode serves all of them from one process and one thread, a handler that blocks
+    // stalls every other service in the group until it returns.
+    kernel.RunOnGuestCoreProcess("services", [&system, shared_services] {
+        auto server_manager = std::make_unique<ServerManager>(system);
+        server_manager->HostServers([&] {
+            for (const auto& loop_process : shared_services) {
+                loop_process();
+            }
+        });
+        ServerManager::RunServer(std::move(server_manager));
+    });
 }
 
 Services::~Services() = default;
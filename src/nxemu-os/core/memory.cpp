@@ -348,6 +348,55 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    bool GetHostSpans(const Common::ProcessAddress addr, const std::size_t size,
+                      const bool is_write, std::vector<std::span<u8>>& spans) {
+        spans.clear();
+        const auto add_span = [&spans](u8* const host_ptr, const std::size_t copy_amount) {
+            // Pages that are adjacent on the host are merged into a single span
+            if (!spans.empty() && spans.back().data() + spans.back().size() == host_ptr) {
+                spans.back() = std::span<u8>(spans.back().data(), spans.back().size() + copy_amount);
+            } else {
+                spans.emplace_back(host_ptr, copy_amount);
+            }
+        };
+        const bool result = WalkBlock(
+            addr, size,
+            [addr, size](const std::size_t copy_amount,
+                         const Common::ProcessAddress current_vaddr) {
+                LOG_ERROR(HW_Memory,
+                          "Unmapped GetHostSpans @ 0x{:016X} (start address = 0x{:016X}, size = {})",
+                          GetInteger(current_vaddr), GetInteger(addr), size);
+            },
+            [&](const std::size_t copy_amount, u8* const host_ptr) {
+                add_span(host_ptr, copy_amount);
+            },
+            [&](const Common::ProcessAddress current_vaddr, const std::size_t copy_amount,
+                u8* const host_ptr) {
+                // Writers invalidate through InvalidateRegion once they are done, doing it here
+                // would let the GPU cache the old contents again before the write lands
+                if (!is_write) {
+                    HandleRasterizerDownload(GetInteger(current_vaddr), copy_amount);
+                }
+                add_span(host_ptr, copy_amount);
+            },
+            [](const std::size_t copy_amount) {});
+        if (!result) {
+            spans.clear();
+        }
+        return result;
+    }
+
+    void InvalidateRegion(const Common::ProcessAddress addr, const std::size_t size) {
+        WalkBlock(
+            addr, size, [](const std::size_t copy_amount, const Common::ProcessAddress) {},
+            [](const std::size_t copy_amount, u8* const host_ptr) {},
+            [&](const Common::ProcessAddress current_vaddr, const std::size_t copy_amount,
+                u8* const host_ptr) {
+                HandleRasterizerWrite(GetInteger(current_vaddr), copy_amount);
+            },
+            [](const std::size_t copy_amount) {});
+    }
+
     template <bool UNSAFE>
     bool WriteBlockImpl(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
@@ -966,6 +1015,19 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+bool Memory::GetHostSpans(Common::ProcessAddress addr, const std::size_t size,
+                          const bool is_write, std::vector<std::span<u8>>& spans) {
+    return impl->GetHostSpans(addr, size, is_write, spans);
+}
+
+void Memory::InvalidateRegion(Common::ProcessAddress addr, const std::size_t size) {
+    impl->InvalidateRegion(addr, size);
+}
+
+void Memory::InvalidateRegion(uint64_t vaddr, uint64_t size) {
+    impl->InvalidateRegion(vaddr, static_cast<std::size_t>(size));
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
@@ -1001,6 +1063,22 @@ void Memory::RasterizerMarkRegionCached(uint64_t vaddr, uint64_t size, bool cach
     impl->RasterizerMarkRegionCached(vaddr, size, cached);
 }
 
+void** Memory::PageTablePointers() {
+    return reinterpret_cast<void**>(impl->current_page_table->pointers.data());
+}
+
+uint32_t Memory::PageTableAddressSpaceBits() const {
+    return static_cast<uint32_t>(impl->current_page_table->GetAddressSpaceBits());
+}
+
+uint32_t Memory::PageTableAttributeBits() const {
+    return Common::PageTable::ATTRIBUTE_BITS;
+}
+
+uint8_t* Memory::FastmemArena() {
+    return impl->current_page_table->fastmem_arena;
+}
+
 void Memory::MarkRegionDebug(Common::ProcessAddress vaddr, u64 size, bool debug) {
     impl->MarkRegionDebug(GetInteger(vaddr), size, debug);
 }
@@ -373,6 +373,33 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Resolves a range of the current process' address space to the host memory backing it,
+     * allowing the range to be read or written in place without an intermediate copy.
+     *
+     * @param addr     The virtual address to begin at.
+     * @param size     The size of the range, in bytes.
+     * @param is_write Whether the caller will write to the returned memory.
+     * @param spans    Receives one host span per run of host-contiguous pages, in address order.
+     *
+     * @returns True if the whole range is mapped, false otherwise.
+     *
+     * @note The spans are only valid until the range is unmapped or reprotected. Writers must
+     *       call InvalidateRegion on the range once they have written to it.
+     */
+    bool GetHostSpans(Common::ProcessAddress addr, std::size_t size, bool is_write,
+                      std::vector<std::span<u8>>& spans);
+
+    /**
+     * Notifies the GPU that a range of the current process' address space was written through
+     * host memory, so any copy it cached of the range is dropped.
+     *
+     * @param addr The virtual address to begin at.
+     * @param size The size of the range, in bytes.
+     */
+    void InvalidateRegion(Common::ProcessAddress addr, std::size_t size);
+    void InvalidateRegion(uint64_t vaddr, uint64_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
@@ -479,6 +506,36 @@ public:
      */
     void RasterizerMarkRegionCached(uint64_t vaddr, u64 size, bool cached);
 
+    /**
+     * Gets the host pointer table of the current page table, suitable for direct use by the
+     * CPU JIT. Each entry packs a host pointer with its page type in the low attribute bits.
+     * Entries of pages that must go through the memory callbacks (unmapped, debug or
+     * rasterizer cached) have a null pointer part.
+     *
+     * @returns The base of the page table pointer array.
+     */
+    void** PageTablePointers();
+
+    /**
+     * Gets the width, in bits, of the address space covered by the current page table.
+     */
+    uint32_t PageTableAddressSpaceBits() const;
+
+    /**
+     * Gets the number of low bits in each page table entry used to tag the page type.
+     */
+    uint32_t PageTableAttributeBits() const;
+
+    /**
+     * Gets the host base of the fastmem arena of the current page table. The arena mirrors the
+     * guest address space, covering PageTableAddressSpaceBits() bits, so that guest memory can be
+     * accessed at arena + vaddr. Pages that need the memory callbacks are protected so accesses
+     * to them fault.
+     *
+     * @returns The arena base, or nullptr if fastmem is not enabled for this process.
+     */
+    uint8_t* FastmemArena();
+
     /**
      * Marks each page within the specified address range as debug or non-debug.
      * Debug addresses are not accessible from fastmem pointers.
@@ -51,6 +51,12 @@ public:
      */
     double GetLastFrameTimeScale() const;
 
+    /**
+     * Returns the number of system frames presented since the title started. This is not cleared by
+     * GetAndResetStats.
+     */
+    u64 GetTotalSystemFrames() const;
+
 private:
     mutable std::mutex object_mutex;
 
@@ -71,6 +77,8 @@ private:
     Clock::duration accumulated_frametime = Clock::duration::zero();
     /// Cumulative number of system frames (LCD VBlanks) presented since last reset
     u32 system_frames = 0;
+    /// Number of system frames presented since construction
+    u64 total_system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     std::atomic<u32> game_frames = 0;
 
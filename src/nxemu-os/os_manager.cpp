@@ -1,7 +1,13 @@
 #include <nxemu-core/settings/identifiers.h>
 #include "core/cpu_manager.h"
+#include "core/file_sys/vfs/vfs_mapped.h"
+#include "core/hardware_properties.h"
 #include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/perf_stats.h"
 #include "core/hle/service/am/applet_manager.h"
+#include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "yuzu_common/logging/backend.h"
 #include "yuzu_common/settings.h"
 #include "yuzu_common/settings_input.h"
@@ -9,6 +15,9 @@
 #include "yuzu_input_common/main.h"
 #include "yuzu_input_common/drivers/keyboard.h"
 #include "os_manager.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
 
 extern IModuleSettings * g_settings;
 
@@ -66,6 +75,8 @@ bool OSManager::Initialize(void)
     buttons[0x00000014] = "engine:keyboard,code:81,toggle:0";
     buttons[0x00000015] = "engine:keyboard,code:69,toggle:0";
 
+    Settings::values.shared_service_host.SetValue(g_settings->GetBool(NXCoreSetting::SharedServiceHost));
+    m_coreSystem.IpcProfiler().SetEnabled(g_settings->GetBool(NXCoreSetting::IpcProfiling));
     m_coreSystem.Initialize();
     m_coreSystem.HIDCore().ReloadInputDevices();
     return true;
@@ -120,6 +131,18 @@ bool OSManager::LoadModule(const IModuleInfo & module, uint64_t baseAddress)
     return true;
 }
 
+bool OSManager::LoadRomFS(const char * filePath, uint64_t offset, uint64_t size)
+{
+    // The image is served straight out of a read only mapping of the file it is embedded in
+    std::shared_ptr<FileSys::MappedVfsFile> romfs = FileSys::MappedVfsFile::Open(filePath, offset, size, "romfs");
+    if (romfs == nullptr)
+    {
+        return false;
+    }
+    m_coreSystem.GetFileSystemController().RegisterRomFS(std::move(romfs));
+    return true;
+}
+
 IDeviceMemory & OSManager::DeviceMemory(void)
 {
     return m_coreSystem.DeviceMemory();
@@ -142,3 +165,69 @@ void OSManager::KeyboardKeyRelease(int modifier, int keyIndex, int keyCode)
     input_subsystem->GetKeyboard()->ReleaseKey(keyCode);
     input_subsystem->PumpEvents();
 }
+
+bool OSManager::GetAndResetPerfStats(OperatingSystemPerfStats & stats)
+{
+    if (m_process == nullptr)
+    {
+        return false;
+    }
+    Core::PerfStatsResults results = m_coreSystem.GetAndResetPerfStats();
+    stats.systemFrames = m_coreSystem.GetPerfStats().GetTotalSystemFrames();
+    stats.systemFps = results.system_fps;
+    stats.averageGameFps = results.average_game_fps;
+    stats.frametime = results.frametime;
+    stats.emulationSpeed = results.emulation_speed;
+    return true;
+}
+
+uint32_t OSManager::GetThreadCpuTimes(OperatingSystemThreadTime * times, uint32_t maxCount)
+{
+    if (m_process == nullptr)
+    {
+        return 0;
+    }
+
+    Kernel::KScopedLightLock lock(m_process->GetListLock());
+    uint32_t count = 0;
+    for (Kernel::KThread & thread : m_process->GetThreadList())
+    {
+        if (count < maxCount)
+        {
+            times[count].threadId = thread.GetThreadId();
+            times[count].core = thread.GetActiveCore();
+            times[count].padding = 0;
+            times[count].cpuTimeNs = (uint64_t)thread.GetCpuTime() * 1000000000ull / Core::Hardware::CNTFREQ;
+        }
+        count += 1;
+    }
+    return count;
+}
+
+uint32_t OSManager::GetIpcProfile(OperatingSystemIpcDispatchStats & dispatch, OperatingSystemIpcCommandStats * commands, uint32_t maxCount)
+{
+    Service::IpcProfiler & profiler = m_coreSystem.IpcProfiler();
+    Service::IpcProfiler::DispatchStats dispatchStats = profiler.GetDispatchStats();
+    dispatch.requests = dispatchStats.requests;
+    dispatch.waitTimeNs = dispatchStats.wait_ns;
+    dispatch.processTimeNs = dispatchStats.process_ns;
+
+    std::vector<Service::IpcProfiler::CommandStats> commandStats = profiler.GetCommandStats();
+    for (uint32_t i = 0, n = (uint32_t)std::min<size_t>(commandStats.size(), maxCount); i < n; i++)
+    {
+        const Service::IpcProfiler::CommandStats & stats = commandStats[i];
+        OperatingSystemIpcCommandStats & command = commands[i];
+        snprintf(command.service, sizeof(command.service), "%s", stats.service.c_str());
+        snprintf(command.command, sizeof(command.command), "%s", stats.name.c_str());
+        command.commandId = stats.command;
+        command.tipc = stats.tipc ? 1 : 0;
+        command.calls = stats.calls;
+        command.handlerTimeNs = stats.handler_ns;
+        command.handlerMaxNs = stats.handler_max_ns;
+        command.queueTimeNs = stats.queue_ns;
+        command.queueMaxNs = stats.queue_max_ns;
+        static_assert(sizeof(command.handlerHistogram) == sizeof(stats.handler_histogram));
+        memcpy(command.handlerHistogram, stats.handler_histogram.data(), sizeof(command.handlerHistogram));
+    }
+    return (uint32_t)commandStats.size();
+}
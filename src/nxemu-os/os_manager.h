@@ -16,9 +16,13 @@ public:
     bool CreateApplicationProcess(uint64_t codeSize, const IProgramMetadata & metaData, uint64_t & baseAddress);
     void StartApplicationProcess(uint64_t baseAddress, int32_t priority, int64_t stackSize);
     bool LoadModule(const IModuleInfo & module, uint64_t baseAddress);
+    bool LoadRomFS(const char * filePath, uint64_t offset, uint64_t size);
     IDeviceMemory & DeviceMemory(void);
     void KeyboardKeyPress(int modifier, int keyIndex, int keyCode);
     void KeyboardKeyRelease(int modifier, int keyIndex, int keyCode);
+    bool GetAndResetPerfStats(OperatingSystemPerfStats & stats);
+    uint32_t GetThreadCpuTimes(OperatingSystemThreadTime * times, uint32_t maxCount);
+    uint32_t GetIpcProfile(OperatingSystemIpcDispatchStats & dispatch, OperatingSystemIpcCommandStats * commands, uint32_t maxCount);
 
 private:
     OSManager() = delete;
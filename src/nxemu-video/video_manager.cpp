@@ -1,8 +1,13 @@
+#include <nxemu-core/settings/identifiers.h>
 #include "video_manager.h"
 #include "render_window.h"
+#include "yuzu_common/settings.h"
 #include "yuzu_video_core/host1x/host1x.h"
 #include "yuzu_video_core/video_core.h"
 #include "yuzu_video_core/gpu.h"
+#include <stdlib.h>
+
+extern IModuleSettings * g_settings;
 
 struct VideoManager::Impl 
 {
@@ -14,6 +19,11 @@ struct VideoManager::Impl
 
     bool Initialize(void)
     {
+        if (g_settings->GetBool(NXCoreSetting::NullRenderer))
+        {
+            Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+        }
+        Settings::values.use_disk_texture_cache.SetValue(g_settings->GetBool(NXCoreSetting::DiskTextureCache));
         m_host1x = std::make_unique<Tegra::Host1x::Host1x>(m_system.OperatingSystem().DeviceMemory());
         m_emuWindow = std::make_unique<RenderWindow>(m_window);
         m_gpuCore = VideoCore::CreateGPU(*(m_emuWindow.get()), *m_host1x);
@@ -38,6 +48,8 @@ VideoManager::~VideoManager()
 
 void VideoManager::EmulationStarting(void)
 {
+    // The game is loaded after Initialize, so its title is only known by now
+    Settings::values.disk_texture_cache_title_id.SetValue(strtoull(g_settings->GetString(NXCoreSetting::GameTitleId).c_str(), nullptr, 16));
     impl->m_gpuCore->Start();
 }
 
@@ -52,7 +52,7 @@ bool MainWindow::RegisterWinClass(void)
 std::string MainWindow::ChooseFileToOpen(HWND hParent)
 {
     Path fileToOpen;
-    const char * filter = "Switch Files (*.nro)\0*.nro\0All files (*.*)\0*.*\0";
+    const char * filter = "Switch Files (*.nro, main.npdm)\0*.nro;main.npdm\0All files (*.*)\0*.*\0";
     if (fileToOpen.FileSelect(hParent, Path(Path::MODULE_DIRECTORY), filter, true))
     {
         return fileToOpen;
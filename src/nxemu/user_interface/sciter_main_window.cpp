@@ -87,7 +87,7 @@ bool SciterMainWindow::Show(void)
 void SciterMainWindow::OnOpenGame(void)
 {
     Path fileToOpen;
-    const char * filter = "Switch Files (*.nro)\0*.nro\0All files (*.*)\0*.*\0";
+    const char * filter = "Switch Files (*.nro, main.npdm)\0*.nro;main.npdm\0All files (*.*)\0*.*\0";
     if (fileToOpen.FileSelect((void *)m_window->GetHandle(), Path(Path::MODULE_DIRECTORY), filter, true))
     {
         LaunchSwitchRom(*this, fileToOpen);
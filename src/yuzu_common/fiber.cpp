@@ -2,10 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <mutex>
+#include <utility>
 
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/fiber.h"
-#include "yuzu_common/virtual_buffer.h"
+#include "yuzu_common/fiber_stack.h"
 
 #include <boost/context/detail/fcontext.hpp>
 
@@ -14,10 +15,10 @@ namespace Common {
 constexpr std::size_t default_stack_size = 512 * 1024;
 
 struct Fiber::FiberImpl {
-    FiberImpl() : stack{default_stack_size}, rewind_stack{default_stack_size} {}
-
-    VirtualBuffer<u8> stack;
-    VirtualBuffer<u8> rewind_stack;
+    // Thread fibers run on their host thread's stack and never own one. The rewind stack is only
+    // taken from the pool once a rewind is requested.
+    FiberStack stack;
+    FiberStack rewind_stack;
 
     std::mutex guard;
     std::function<void()> entry_point;
@@ -26,8 +27,6 @@ struct Fiber::FiberImpl {
     bool is_thread_fiber{};
     bool released{};
 
-    u8* stack_limit{};
-    u8* rewind_stack_limit{};
     boost::context::detail::fcontext_t context{};
     boost::context::detail::fcontext_t rewind_context{};
 };
@@ -49,9 +48,7 @@ void Fiber::OnRewind([[maybe_unused]] boost::context::detail::transfer_t& transf
     ASSERT(impl->context != nullptr);
     impl->context = impl->rewind_context;
     impl->rewind_context = nullptr;
-    u8* tmp = impl->stack_limit;
-    impl->stack_limit = impl->rewind_stack_limit;
-    impl->rewind_stack_limit = tmp;
+    std::swap(impl->stack, impl->rewind_stack);
     impl->rewind_point();
     UNREACHABLE();
 }
@@ -68,11 +65,9 @@ void Fiber::RewindStartFunc(boost::context::detail::transfer_t transfer) {
 
 Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<FiberImpl>()} {
     impl->entry_point = std::move(entry_point_func);
-    impl->stack_limit = impl->stack.data();
-    impl->rewind_stack_limit = impl->rewind_stack.data();
-    u8* stack_base = impl->stack_limit + default_stack_size;
-    impl->context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), FiberStartFunc);
+    impl->stack = FiberStack{default_stack_size};
+    impl->context = boost::context::detail::make_fcontext(impl->stack.Base(), impl->stack.Size(),
+                                                          FiberStartFunc);
 }
 
 Fiber::Fiber() : impl{std::make_unique<FiberImpl>()} {}
@@ -101,9 +96,11 @@ void Fiber::Exit() {
 void Fiber::Rewind() {
     ASSERT(impl->rewind_point);
     ASSERT(impl->rewind_context == nullptr);
-    u8* stack_base = impl->rewind_stack_limit + default_stack_size;
-    impl->rewind_context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), RewindStartFunc);
+    if (!impl->rewind_stack.IsValid()) {
+        impl->rewind_stack = FiberStack{default_stack_size};
+    }
+    impl->rewind_context = boost::context::detail::make_fcontext(
+        impl->rewind_stack.Base(), impl->rewind_stack.Size(), RewindStartFunc);
     boost::context::detail::jump_fcontext(impl->rewind_context, this);
 }
 
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "yuzu_common/alignment.h"
+#include "yuzu_common/fiber_stack.h"
+#include "yuzu_common/yuzu_assert.h"
+
+namespace Common {
+
+namespace {
+
+// Released stacks kept mapped for reuse, anything past this is unmapped straight away
+constexpr std::size_t MaxPooledStacks = 64;
+
+// The top of a recycled stack is kept resident, every fiber touches it on its first switch
+constexpr std::size_t ResidentStackSize = 16 * 1024;
+
+std::size_t GetPageSize() {
+    static const std::size_t page_size = [] {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+#else
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return page_size;
+}
+
+u8* MapStack(std::size_t size) {
+    const std::size_t guard_size = GetPageSize();
+#ifdef _WIN32
+    u8* base =
+        static_cast<u8*>(VirtualAlloc(nullptr, guard_size + size, MEM_RESERVE, PAGE_NOACCESS));
+    if (base == nullptr) {
+        return nullptr;
+    }
+    // fcontext does not maintain the stack bounds in the TEB that Windows relies on to grow a
+    // stack through a guard page, so the usable range is committed here. Committed pages still
+    // only join the working set once they are touched.
+    if (VirtualAlloc(base + guard_size, size, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        return nullptr;
+    }
+#else
+    void* mapping = mmap(nullptr, guard_size + size, PROT_NONE,
+                         MAP_PRIVATE | MAP_ANON | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    u8* base = static_cast<u8*>(mapping);
+    if (mprotect(base + guard_size, size, PROT_READ | PROT_WRITE) != 0) {
+        munmap(base, guard_size + size);
+        return nullptr;
+    }
+#endif
+    return base + guard_size;
+}
+
+void UnmapStack(u8* limit, [[maybe_unused]] std::size_t size) {
+    const std::size_t guard_size = GetPageSize();
+#ifdef _WIN32
+    ASSERT(VirtualFree(limit - guard_size, 0, MEM_RELEASE));
+#else
+    ASSERT(munmap(limit - guard_size, guard_size + size) == 0);
+#endif
+}
+
+void DiscardStack(u8* limit, std::size_t size) {
+    // The previous fiber's frames are dead, let the host drop the pages below the top so a pooled
+    // stack only costs address space until it is used again.
+    if (size <= ResidentStackSize) {
+        return;
+    }
+    const std::size_t discard_size = size - ResidentStackSize;
+#ifdef _WIN32
+    VirtualAlloc(limit, discard_size, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_FREE)
+    madvise(limit, discard_size, MADV_FREE);
+#else
+    madvise(limit, discard_size, MADV_DONTNEED);
+#endif
+}
+
+struct StackPool {
+    std::mutex lock;
+    std::vector<std::pair<std::size_t, u8*>> stacks;
+};
+
+StackPool& GetStackPool() {
+    // Never destroyed, fibers owned by other statics may still release their stacks on exit
+    static StackPool* const pool = new StackPool;
+    return *pool;
+}
+
+} // Anonymous namespace
+
+FiberStack::FiberStack(std::size_t size_) : size{AlignUp(size_, GetPageSize())} {
+    auto& pool = GetStackPool();
+    {
+        std::scoped_lock lk{pool.lock};
+        // Most recently released first, its top pages are the most likely to still be resident
+        const auto it = std::find_if(pool.stacks.rbegin(), pool.stacks.rend(),
+                                     [this](const auto& entry) { return entry.first == size; });
+        if (it != pool.stacks.rend()) {
+            limit = it->second;
+            pool.stacks.erase(std::next(it).base());
+            return;
+        }
+    }
+
+    limit = MapStack(size);
+    ASSERT_MSG(limit != nullptr, "Failed to map a fiber stack of {:#x} bytes", size);
+}
+
+FiberStack::~FiberStack() {
+    Release();
+}
+
+FiberStack::FiberStack(FiberStack&& other) noexcept
+    : limit{std::exchange(other.limit, nullptr)}, size{std::exchange(other.size, 0)} {}
+
+FiberStack& FiberStack::operator=(FiberStack&& other) noexcept {
+    if (this != &other) {
+        Release();
+        limit = std::exchange(other.limit, nullptr);
+        size = std::exchange(other.size, 0);
+    }
+    return *this;
+}
+
+void FiberStack::Release() {
+    if (limit == nullptr) {
+        return;
+    }
+
+    // Discarded before it is published, another thread may pick it up as soon as it is pooled
+    DiscardStack(limit, size);
+
+    auto& pool = GetStackPool();
+    bool pooled = false;
+    {
+        std::scoped_lock lk{pool.lock};
+        if (pool.stacks.size() < MaxPooledStacks) {
+            pool.stacks.emplace_back(size, limit);
+            pooled = true;
+        }
+    }
+
+    if (!pooled) {
+        UnmapStack(limit, size);
+    }
+    limit = nullptr;
+    size = 0;
+}
+
+} // namespace Common
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "yuzu_common/common_types.h"
+
+namespace Common {
+
+/**
+ * A fiber stack reserved with a guard page below its usable range. Pages are only backed once the
+ * fiber touches them, and released stacks go back to a process wide pool so that creating and
+ * destroying threads does not map and unmap address space every time.
+ */
+class FiberStack {
+public:
+    constexpr FiberStack() = default;
+    explicit FiberStack(std::size_t size);
+    ~FiberStack();
+
+    FiberStack(const FiberStack&) = delete;
+    FiberStack& operator=(const FiberStack&) = delete;
+
+    FiberStack(FiberStack&& other) noexcept;
+    FiberStack& operator=(FiberStack&& other) noexcept;
+
+    /// Lowest usable address of the stack
+    [[nodiscard]] u8* Limit() const {
+        return limit;
+    }
+
+    /// One past the highest usable address, stacks grow down from here
+    [[nodiscard]] u8* Base() const {
+        return limit + size;
+    }
+
+    [[nodiscard]] std::size_t Size() const {
+        return size;
+    }
+
+    [[nodiscard]] bool IsValid() const {
+        return limit != nullptr;
+    }
+
+private:
+    void Release();
+
+    u8* limit{};
+    std::size_t size{};
+};
+
+} // namespace Common
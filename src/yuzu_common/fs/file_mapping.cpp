@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "yuzu_common/fs/file_mapping.h"
+#include "yuzu_common/fs/fs_util.h"
+#include "yuzu_common/logging/log.h"
+
+namespace Common::FS {
+
+FileMapping::FileMapping() = default;
+
+FileMapping::FileMapping(const std::filesystem::path& path) {
+#ifdef _WIN32
+    const HANDLE file =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}", PathToUTF8String(path));
+        return;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            // The view keeps the mapping and file alive once it is created
+            data = static_cast<const u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        if (data != nullptr) {
+            size = static_cast<u64>(file_size.QuadPart);
+        } else {
+            LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, error={}",
+                      PathToUTF8String(path), GetLastError());
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}", PathToUTF8String(path));
+        return;
+    }
+
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* const view =
+            mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (view != MAP_FAILED) {
+            data = static_cast<const u8*>(view);
+            size = static_cast<u64>(file_stat.st_size);
+        } else {
+            LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}",
+                      PathToUTF8String(path));
+        }
+    }
+    close(fd);
+#endif
+}
+
+FileMapping::~FileMapping() {
+    Unmap();
+}
+
+FileMapping::FileMapping(FileMapping&& other) noexcept
+    : data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)} {}
+
+FileMapping& FileMapping::operator=(FileMapping&& other) noexcept {
+    Unmap();
+    data = std::exchange(other.data, nullptr);
+    size = std::exchange(other.size, 0);
+    return *this;
+}
+
+void FileMapping::Unmap() {
+    if (data == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<u8*>(data), static_cast<size_t>(size));
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
+void FileMapping::Prefetch(u64 offset, u64 length) const {
+    if (offset >= size) {
+        return;
+    }
+    length = std::min(length, size - offset);
+
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<u8*>(data + offset), static_cast<SIZE_T>(length)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    const u64 page_mask = static_cast<u64>(sysconf(_SC_PAGESIZE)) - 1;
+    const u64 aligned_offset = offset & ~page_mask;
+    madvise(const_cast<u8*>(data + aligned_offset),
+            static_cast<size_t>(offset + length - aligned_offset), MADV_WILLNEED);
+#endif
+}
+
+} // namespace Common::FS
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+
+#include "yuzu_common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * A read only view of an entire host file. Pages are brought in by the operating system on first
+ * access, or ahead of time through Prefetch.
+ */
+class FileMapping final {
+public:
+    FileMapping();
+
+    /**
+     * Maps the file at path. Empty files and files that cannot be opened are left unmapped, check
+     * IsMapped before use.
+     *
+     * @param path Filesystem path
+     */
+    explicit FileMapping(const std::filesystem::path& path);
+
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    FileMapping(FileMapping&& other) noexcept;
+    FileMapping& operator=(FileMapping&& other) noexcept;
+
+    /// Unmaps the file if it is mapped.
+    void Unmap();
+
+    /// Whether the file is mapped.
+    [[nodiscard]] bool IsMapped() const {
+        return data != nullptr;
+    }
+
+    /// Start of the mapped file contents.
+    [[nodiscard]] const u8* Data() const {
+        return data;
+    }
+
+    /// Size of the file at the time it was mapped.
+    [[nodiscard]] u64 Size() const {
+        return size;
+    }
+
+    /**
+     * Asks the operating system to start reading a range of the file into memory. This does not
+     * wait for the reads to complete.
+     *
+     * @param offset Offset of the range in the file
+     * @param length Length of the range in bytes
+     */
+    void Prefetch(u64 offset, u64 length) const;
+
+private:
+    const u8* data = nullptr;
+    u64 size = 0;
+};
+
+} // namespace Common::FS
@@ -9,6 +9,13 @@
 #include "yuzu_common/fs/path_util.h"
 #include "yuzu_common/logging/log.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace Common::FS {
 
 namespace fs = std::filesystem;
@@ -406,6 +413,51 @@ bool RenameDir(const fs::path& old_path, const fs::path& new_path) {
     return true;
 }
 
+bool SyncDir(const fs::path& path) {
+    if (!ValidatePath(path)) {
+        LOG_ERROR(Common_Filesystem, "Input path is not valid, path={}", PathToUTF8String(path));
+        return false;
+    }
+
+    if (!IsDir(path)) {
+        LOG_ERROR(Common_Filesystem, "Filesystem object at path={} is not a directory",
+                  PathToUTF8String(path));
+        return false;
+    }
+
+#ifdef _WIN32
+    // Directories can only be opened as a handle with backup semantics, and flushing one needs
+    // write access
+    const HANDLE handle =
+        CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                    FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the directory at path={}",
+                  PathToUTF8String(path));
+        return false;
+    }
+    const auto sync_result = FlushFileBuffers(handle) != FALSE;
+    CloseHandle(handle);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the directory at path={}",
+                  PathToUTF8String(path));
+        return false;
+    }
+    const auto sync_result = fsync(fd) == 0;
+    close(fd);
+#endif
+
+    if (!sync_result) {
+        LOG_ERROR(Common_Filesystem, "Failed to sync the directory at path={}",
+                  PathToUTF8String(path));
+    }
+
+    return sync_result;
+}
+
 void IterateDirEntries(const std::filesystem::path& path, const DirEntryCallable& callback,
                        DirEntryFilter filter) {
     if (!ValidatePath(path)) {
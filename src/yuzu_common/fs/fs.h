@@ -348,6 +348,32 @@ template <typename Path1, typename Path2>
 }
 #endif
 
+/**
+ * Makes the entries of a directory durable, so files created, renamed or removed in it survive
+ * a power loss once this returns.
+ *
+ * Failures occur when:
+ * - Input path is not valid
+ * - Filesystem object at path is not a directory
+ * - The directory could not be opened or synced
+ *
+ * @param path Filesystem path
+ *
+ * @returns True if the directory was synced, false otherwise.
+ */
+[[nodiscard]] bool SyncDir(const std::filesystem::path& path);
+
+#ifdef _WIN32
+template <typename Path>
+[[nodiscard]] bool SyncDir(const Path& path) {
+    if constexpr (IsChar<typename Path::value_type>) {
+        return SyncDir(ToU8String(path));
+    } else {
+        return SyncDir(std::filesystem::path{path});
+    }
+}
+#endif
+
 /**
  * Iterates over the directory entries of a given directory.
  * This does not iterate over the sub-directories of the given directory.
@@ -192,6 +192,7 @@ struct Values {
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
+    Setting<bool> shared_service_host{linkage, false, "shared_service_host", Category::Core};
     SwitchableSetting<MemoryLayout, true> memory_layout_mode{linkage,
                                                              MemoryLayout::Memory_4Gb,
                                                              MemoryLayout::Memory_4Gb,
@@ -384,6 +385,19 @@ struct Values {
                                                                   AstcRecompression::Bc3,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    Setting<bool> use_disk_texture_cache{linkage, false, "use_disk_texture_cache",
+                                         Category::RendererAdvanced};
+    // Size limit of the decoded texture pack of a title, in MiB
+    Setting<u32> disk_texture_cache_size{linkage, 2048, "disk_texture_cache_size",
+                                         Category::RendererAdvanced};
+    // Title of the running program, picks its decoded texture pack. Set by the frontend on boot
+    Setting<u64> disk_texture_cache_title_id{linkage,
+                                             0,
+                                             "disk_texture_cache_title_id",
+                                             Category::RendererAdvanced,
+                                             Specialization::Default,
+                                             false,
+                                             true};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
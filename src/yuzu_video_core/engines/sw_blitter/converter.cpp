@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <span>
 #include <unordered_map>
 
@@ -11,6 +12,12 @@
 #include "yuzu_video_core/engines/sw_blitter/converter.h"
 #include "yuzu_video_core/surface.h"
 #include "yuzu_video_core/textures/decoders.h"
+#include "yuzu_video_core/textures/host_simd.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define BLITTER_SSE2
+#endif
 
 #ifdef _MSC_VER
 #define FORCE_INLINE __forceinline
@@ -137,6 +144,59 @@ constexpr std::array<f32, 256> RGB_TO_SRGB_LUT = {
     9.843225e-01f, 9.860808e-01f, 9.878350e-01f, 9.895850e-01f, 9.913309e-01f, 9.930727e-01f,
     9.948106e-01f, 9.965444e-01f, 9.982741e-01f, 1.000000e+00f};
 
+constexpr u32 FLOAT_EXPONENT_REBIAS = (127 - 15) << 23;
+
+/// Converts an unsigned float with a 5 bit exponent (half, 11 and 10 bit floats) to float bits.
+/// Denormals are flushed to zero, infinity and NaN are kept.
+template <u32 mantissa_bits>
+u32 SmallFloatToFloatBits(u32 value) {
+    const u32 exponent = value >> mantissa_bits;
+    if (exponent == 0) {
+        return 0;
+    }
+    const u32 bits = (value << (23 - mantissa_bits)) + FLOAT_EXPONENT_REBIAS;
+    return exponent == 0x1f ? bits + FLOAT_EXPONENT_REBIAS : bits;
+}
+
+/// Converts the magnitude of float bits to an unsigned float with a 5 bit exponent, truncating
+/// the mantissa. Values past the range become infinity and values below it become zero.
+template <u32 mantissa_bits>
+u32 FloatBitsToSmallFloat(u32 bits) {
+    const u32 magnitude = bits & 0x7fffffff;
+    if (magnitude > 0x7f800000) {
+        return (0x1fU << mantissa_bits) | (1U << (mantissa_bits - 1));
+    }
+    if (magnitude >= 0x47800000) {
+        return 0x1fU << mantissa_bits;
+    }
+    if (magnitude < 0x38800000) {
+        return 0;
+    }
+    return (magnitude >> (23 - mantissa_bits)) - (112U << mantissa_bits);
+}
+
+f32 HalfToFloat(u32 value) {
+    return Common::BitCast<f32>(((value & 0x8000) << 16) |
+                                SmallFloatToFloatBits<10>(value & 0x7fff));
+}
+
+u32 FloatToHalf(f32 value) {
+    const u32 bits = Common::BitCast<u32>(value);
+    return ((bits >> 16) & 0x8000) | FloatBitsToSmallFloat<10>(bits);
+}
+
+/// 11 and 10 bit floats have no sign, negative values clamp to zero
+template <u32 mantissa_bits>
+f32 UnsignedFloatToFloat(u32 value) {
+    return Common::BitCast<f32>(SmallFloatToFloatBits<mantissa_bits>(value));
+}
+
+template <u32 mantissa_bits>
+u32 FloatToUnsignedFloat(f32 value) {
+    const u32 bits = Common::BitCast<u32>(value);
+    return (bits & 0x80000000) != 0 ? 0 : FloatBitsToSmallFloat<mantissa_bits>(bits);
+}
+
 } // namespace
 
 struct R32G32B32A32_FLOATTraits {
@@ -702,13 +762,6 @@ private:
             // TODO: force the exponent within the range of half float. Not needed in UNORM / SNORM
             return Common::BitCast<f32>(tmp);
         };
-        const auto from_fp_n = [&sign_extend](u32 base_value, size_t bits, size_t mantissa) {
-            constexpr size_t fp32_mantissa_bits = 23;
-            size_t shift_towards = fp32_mantissa_bits - mantissa;
-            const u32 new_value =
-                static_cast<u32>(sign_extend(base_value, bits) << shift_towards) & (~(1U << 31));
-            return Common::BitCast<f32>(new_value);
-        };
         const auto calculate_snorm = [&]() {
             return static_cast<f32>(
                 static_cast<f32>(sign_extend(value, component_sizes[which_component])) /
@@ -739,14 +792,10 @@ private:
             if constexpr (component_sizes[which_component] == 32) {
                 out_component = Common::BitCast<f32>(value);
             } else if constexpr (component_sizes[which_component] == 16) {
-                static constexpr u32 sign_mask = 0x8000;
-                static constexpr u32 mantissa_mask = 0x8000;
-                out_component = Common::BitCast<f32>(((value & sign_mask) << 16) |
-                                                     (((value & 0x7c00) + 0x1C000) << 13) |
-                                                     ((value & mantissa_mask) << 13));
+                out_component = HalfToFloat(value);
             } else {
-                out_component = from_fp_n(value, component_sizes[which_component],
-                                          component_sizes[which_component] - 5);
+                out_component =
+                    UnsignedFloatToFloat<component_sizes[which_component] - 5>(value);
             }
         } else if constexpr (component_types[which_component] == ComponentType::SRGB) {
             if constexpr (component_swizzle[which_component] == Swizzle::A) {
@@ -769,12 +818,6 @@ private:
             which_word |= (static_cast<u32>(new_word) << bound_offsets[which_component]) &
                           component_mask[which_component];
         };
-        const auto to_fp_n = [](f32 base_value, size_t bits, size_t mantissa) {
-            constexpr size_t fp32_mantissa_bits = 23;
-            u32 tmp_value = Common::BitCast<u32>(std::max(base_value, 0.0f));
-            size_t shift_towards = fp32_mantissa_bits - mantissa;
-            return tmp_value >> shift_towards;
-        };
         const auto calculate_unorm = [&]() {
             return static_cast<u32>(
                 static_cast<f32>(in_component) *
@@ -802,17 +845,10 @@ private:
                 u32 tmp_word = Common::BitCast<u32>(in_component);
                 insert_to_word(tmp_word);
             } else if constexpr (component_sizes[which_component] == 16) {
-                static constexpr u32 sign_mask = 0x8000;
-                static constexpr u32 mantissa_mask = 0x03ff;
-                static constexpr u32 exponent_mask = 0x7c00;
-                const u32 tmp_word = Common::BitCast<u32>(in_component);
-                const u32 half = ((tmp_word >> 16) & sign_mask) |
-                                 ((((tmp_word & 0x7f800000) - 0x38000000) >> 13) & exponent_mask) |
-                                 ((tmp_word >> 13) & mantissa_mask);
-                insert_to_word(half);
+                insert_to_word(FloatToHalf(in_component));
             } else {
-                insert_to_word(to_fp_n(in_component, component_sizes[which_component],
-                                       component_sizes[which_component] - 5));
+                insert_to_word(
+                    FloatToUnsignedFloat<component_sizes[which_component] - 5>(in_component));
             }
         } else if constexpr (component_types[which_component] == ComponentType::SRGB) {
             if constexpr (component_swizzle[which_component] != Swizzle::A) {
@@ -920,6 +956,313 @@ public:
     ~ConverterImpl() override = default;
 };
 
+#ifdef BLITTER_SSE2
+namespace {
+
+/// Pixels the SSE2 loops may cover, none when the host or a benchmark limit rules SSE2 out
+size_t Sse2Pixels(size_t num_pixels) {
+    return Texture::GetHostSimd() >= Texture::HostSimd::SSE2 ? num_pixels : 0;
+}
+
+__m128i Select(__m128i mask, __m128i if_true, __m128i if_false) {
+    return _mm_or_si128(_mm_and_si128(mask, if_true), _mm_andnot_si128(mask, if_false));
+}
+
+template <u32 mantissa_bits>
+__m128i SmallFloatToFloatBits(__m128i value) {
+    const __m128i rebias = _mm_set1_epi32(FLOAT_EXPONENT_REBIAS);
+    const __m128i exponent = _mm_srli_epi32(value, mantissa_bits);
+    const __m128i bits = _mm_add_epi32(_mm_slli_epi32(value, 23 - mantissa_bits), rebias);
+    const __m128i is_special = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x1f));
+    const __m128i is_zero = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    return _mm_andnot_si128(is_zero, _mm_add_epi32(bits, _mm_and_si128(is_special, rebias)));
+}
+
+template <u32 mantissa_bits>
+__m128i FloatBitsToSmallFloat(__m128i bits) {
+    const __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7fffffff));
+    const __m128i normal = _mm_sub_epi32(_mm_srli_epi32(magnitude, 23 - mantissa_bits),
+                                         _mm_set1_epi32(112 << mantissa_bits));
+    const __m128i infinity = _mm_set1_epi32(0x1f << mantissa_bits);
+    const __m128i nan = _mm_set1_epi32((0x1f << mantissa_bits) | (1 << (mantissa_bits - 1)));
+    const __m128i is_nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7f800000));
+    const __m128i is_overflow = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x477fffff));
+    const __m128i is_underflow = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x38800000));
+    const __m128i result = Select(is_nan, nan, Select(is_overflow, infinity, normal));
+    return _mm_andnot_si128(is_underflow, result);
+}
+
+__m128 HalfToFloat(__m128i value) {
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x8000)), 16);
+    const __m128i magnitude = _mm_and_si128(value, _mm_set1_epi32(0x7fff));
+    return _mm_castsi128_ps(_mm_or_si128(sign, SmallFloatToFloatBits<10>(magnitude)));
+}
+
+__m128i FloatToHalf(__m128 value) {
+    const __m128i bits = _mm_castps_si128(value);
+    const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    return _mm_or_si128(sign, FloatBitsToSmallFloat<10>(bits));
+}
+
+/// Narrows four words that fit in 16 bits, packs saturate so they are sign extended first
+__m128i PackWords16(__m128i low, __m128i high) {
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16),
+                           _mm_srai_epi32(_mm_slli_epi32(high, 16), 16));
+}
+
+} // Anonymous namespace
+#endif
+
+/**
+ * Converter for formats where every component is UNORM or an unsigned small float packed into a
+ * single 16 or 32 bit word. The SSE2 path converts four pixels at a time, one component of each
+ * pixel per lane, and is bit exact with the scalar path used for the remainder.
+ */
+template <class ConverterTraits>
+class PackedConverter : public Converter {
+private:
+    static constexpr size_t num_components = ConverterTraits::num_components;
+    static constexpr size_t components_per_ir_rep = 4;
+
+    struct Channel {
+        u32 offset;
+        u32 size;
+        bool is_float;
+    };
+
+    static constexpr std::array<Channel, components_per_ir_rep> GetChannels() {
+        std::array<Channel, components_per_ir_rep> result{};
+        u32 offset = 0;
+        for (size_t i = 0; i < num_components; i++) {
+            const u32 size = static_cast<u32>(ConverterTraits::component_sizes[i]);
+            const size_t channel = static_cast<size_t>(ConverterTraits::component_swizzle[i]);
+            result[channel] = {offset, size,
+                               ConverterTraits::component_types[i] == ComponentType::FLOAT};
+            offset += size;
+        }
+        return result;
+    }
+
+    static constexpr size_t CalculateByteSize() {
+        size_t size = 0;
+        for (const size_t component_size : ConverterTraits::component_sizes) {
+            size += component_size;
+        }
+        return size / 8;
+    }
+
+    static constexpr std::array<Channel, components_per_ir_rep> channels = GetChannels();
+    static constexpr size_t bytes_per_pixel = CalculateByteSize();
+    static_assert(bytes_per_pixel == 2 || bytes_per_pixel == 4);
+
+    template <size_t which>
+    static f32 UnpackChannel(u32 word) {
+        constexpr Channel channel = channels[which];
+        if constexpr (channel.size == 0) {
+            return 0.0f;
+        } else {
+            constexpr u32 max_value = (1U << channel.size) - 1;
+            const u32 value = (word >> channel.offset) & max_value;
+            if constexpr (channel.is_float) {
+                return UnsignedFloatToFloat<channel.size - 5>(value);
+            } else {
+                return static_cast<f32>(value) / static_cast<f32>(max_value);
+            }
+        }
+    }
+
+    template <size_t which>
+    static u32 PackChannel(f32 value) {
+        constexpr Channel channel = channels[which];
+        if constexpr (channel.size == 0) {
+            return 0;
+        } else {
+            constexpr u32 max_value = (1U << channel.size) - 1;
+            u32 bits;
+            if constexpr (channel.is_float) {
+                bits = FloatToUnsignedFloat<channel.size - 5>(value);
+            } else {
+                bits = static_cast<u32>(static_cast<s32>(value * static_cast<f32>(max_value)));
+            }
+            return (bits & max_value) << channel.offset;
+        }
+    }
+
+#ifdef BLITTER_SSE2
+    template <size_t which>
+    static __m128 UnpackChannel(__m128i words) {
+        constexpr Channel channel = channels[which];
+        if constexpr (channel.size == 0) {
+            return _mm_setzero_ps();
+        } else {
+            constexpr s32 max_value = (1 << channel.size) - 1;
+            const __m128i value =
+                _mm_and_si128(_mm_srli_epi32(words, channel.offset), _mm_set1_epi32(max_value));
+            if constexpr (channel.is_float) {
+                return _mm_castsi128_ps(SmallFloatToFloatBits<channel.size - 5>(value));
+            } else {
+                return _mm_div_ps(_mm_cvtepi32_ps(value),
+                                  _mm_set1_ps(static_cast<f32>(max_value)));
+            }
+        }
+    }
+
+    template <size_t which>
+    static __m128i PackChannel(__m128 value) {
+        constexpr Channel channel = channels[which];
+        if constexpr (channel.size == 0) {
+            return _mm_setzero_si128();
+        } else {
+            constexpr s32 max_value = (1 << channel.size) - 1;
+            __m128i bits;
+            if constexpr (channel.is_float) {
+                const __m128i float_bits = _mm_castps_si128(value);
+                bits = _mm_andnot_si128(_mm_srai_epi32(float_bits, 31),
+                                        FloatBitsToSmallFloat<channel.size - 5>(float_bits));
+            } else {
+                const __m128 scale = _mm_set1_ps(static_cast<f32>(max_value));
+                bits = _mm_cvttps_epi32(_mm_mul_ps(value, scale));
+            }
+            return _mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(max_value)), channel.offset);
+        }
+    }
+
+    static __m128i LoadWords(const u8* input) {
+        if constexpr (bytes_per_pixel == 2) {
+            const __m128i halves = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input));
+            return _mm_unpacklo_epi16(halves, _mm_setzero_si128());
+        } else {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        }
+    }
+
+    static void StoreWords(u8* output, __m128i words) {
+        if constexpr (bytes_per_pixel == 2) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output), PackWords16(words, words));
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), words);
+        }
+    }
+#endif
+
+public:
+    void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
+        const size_t num_pixels = output.size() / components_per_ir_rep;
+        const u8* src = input.data();
+        f32* dst = output.data();
+        size_t pixel = 0;
+#ifdef BLITTER_SSE2
+        const size_t sse2_pixels = Sse2Pixels(num_pixels);
+        for (; pixel + 4 <= sse2_pixels; pixel += 4) {
+            const __m128i words = LoadWords(src + pixel * bytes_per_pixel);
+            __m128 r = UnpackChannel<0>(words);
+            __m128 g = UnpackChannel<1>(words);
+            __m128 b = UnpackChannel<2>(words);
+            __m128 a = UnpackChannel<3>(words);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            f32* const out = dst + pixel * components_per_ir_rep;
+            _mm_storeu_ps(out, r);
+            _mm_storeu_ps(out + 4, g);
+            _mm_storeu_ps(out + 8, b);
+            _mm_storeu_ps(out + 12, a);
+        }
+#endif
+        for (; pixel < num_pixels; pixel++) {
+            u32 word = 0;
+            std::memcpy(&word, src + pixel * bytes_per_pixel, bytes_per_pixel);
+            f32* const out = dst + pixel * components_per_ir_rep;
+            out[0] = UnpackChannel<0>(word);
+            out[1] = UnpackChannel<1>(word);
+            out[2] = UnpackChannel<2>(word);
+            out[3] = UnpackChannel<3>(word);
+        }
+    }
+
+    void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
+        const size_t num_pixels = output.size() / bytes_per_pixel;
+        const f32* src = input.data();
+        u8* dst = output.data();
+        size_t pixel = 0;
+#ifdef BLITTER_SSE2
+        const size_t sse2_pixels = Sse2Pixels(num_pixels);
+        for (; pixel + 4 <= sse2_pixels; pixel += 4) {
+            const f32* const in = src + pixel * components_per_ir_rep;
+            __m128 r = _mm_loadu_ps(in);
+            __m128 g = _mm_loadu_ps(in + 4);
+            __m128 b = _mm_loadu_ps(in + 8);
+            __m128 a = _mm_loadu_ps(in + 12);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            const __m128i words =
+                _mm_or_si128(_mm_or_si128(PackChannel<0>(r), PackChannel<1>(g)),
+                             _mm_or_si128(PackChannel<2>(b), PackChannel<3>(a)));
+            StoreWords(dst + pixel * bytes_per_pixel, words);
+        }
+#endif
+        for (; pixel < num_pixels; pixel++) {
+            const f32* const in = src + pixel * components_per_ir_rep;
+            const u32 word = PackChannel<0>(in[0]) | PackChannel<1>(in[1]) |
+                             PackChannel<2>(in[2]) | PackChannel<3>(in[3]);
+            std::memcpy(dst + pixel * bytes_per_pixel, &word, bytes_per_pixel);
+        }
+    }
+
+    PackedConverter() = default;
+    ~PackedConverter() override = default;
+};
+
+/// R16G16B16A16_FLOAT maps one pixel to one IR rep, the SSE2 path converts two pixels at a time
+class Rgba16FloatConverter : public Converter {
+public:
+    void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
+        const size_t num_pixels = output.size() / 4;
+        const u8* src = input.data();
+        f32* dst = output.data();
+        size_t pixel = 0;
+#ifdef BLITTER_SSE2
+        const size_t sse2_pixels = Sse2Pixels(num_pixels);
+        for (; pixel + 2 <= sse2_pixels; pixel += 2) {
+            const __m128i halves =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pixel * 8));
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_ps(dst + pixel * 4, HalfToFloat(_mm_unpacklo_epi16(halves, zero)));
+            _mm_storeu_ps(dst + pixel * 4 + 4, HalfToFloat(_mm_unpackhi_epi16(halves, zero)));
+        }
+#endif
+        for (; pixel < num_pixels; pixel++) {
+            std::array<u16, 4> halves;
+            std::memcpy(halves.data(), src + pixel * 8, sizeof(halves));
+            for (size_t i = 0; i < halves.size(); i++) {
+                dst[pixel * 4 + i] = HalfToFloat(halves[i]);
+            }
+        }
+    }
+
+    void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
+        const size_t num_pixels = output.size() / 8;
+        const f32* src = input.data();
+        u8* dst = output.data();
+        size_t pixel = 0;
+#ifdef BLITTER_SSE2
+        const size_t sse2_pixels = Sse2Pixels(num_pixels);
+        for (; pixel + 2 <= sse2_pixels; pixel += 2) {
+            const __m128i low = FloatToHalf(_mm_loadu_ps(src + pixel * 4));
+            const __m128i high = FloatToHalf(_mm_loadu_ps(src + pixel * 4 + 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pixel * 8), PackWords16(low, high));
+        }
+#endif
+        for (; pixel < num_pixels; pixel++) {
+            std::array<u16, 4> halves;
+            for (size_t i = 0; i < halves.size(); i++) {
+                halves[i] = static_cast<u16>(FloatToHalf(src[pixel * 4 + i]));
+            }
+            std::memcpy(dst + pixel * 8, halves.data(), sizeof(halves));
+        }
+    }
+
+    Rgba16FloatConverter() = default;
+    ~Rgba16FloatConverter() override = default;
+};
+
 struct ConverterFactory::ConverterFactoryImpl {
     std::unordered_map<RenderTargetFormat, std::unique_ptr<Converter>> converters_cache;
 };
@@ -952,6 +1295,32 @@ public:
 };
 
 Converter* ConverterFactory::BuildConverter(RenderTargetFormat format) {
+    // Formats common in UI and video blits get vectorized converters, the rest are generated
+    std::unique_ptr<Converter> fast_converter;
+    switch (format) {
+    case RenderTargetFormat::A8B8G8R8_UNORM:
+        fast_converter = std::make_unique<PackedConverter<A8B8G8R8_UNORMTraits>>();
+        break;
+    case RenderTargetFormat::A8R8G8B8_UNORM:
+        fast_converter = std::make_unique<PackedConverter<A8R8G8B8_UNORMTraits>>();
+        break;
+    case RenderTargetFormat::R5G6B5_UNORM:
+        fast_converter = std::make_unique<PackedConverter<R5G6B5_UNORMTraits>>();
+        break;
+    case RenderTargetFormat::B10G11R11_FLOAT:
+        fast_converter = std::make_unique<PackedConverter<B10G11R11_FLOATTraits>>();
+        break;
+    case RenderTargetFormat::R16G16B16A16_FLOAT:
+        fast_converter = std::make_unique<Rgba16FloatConverter>();
+        break;
+    default:
+        break;
+    }
+    if (fast_converter) {
+        return impl->converters_cache.emplace(format, std::move(fast_converter))
+            .first->second.get();
+    }
+
     switch (format) {
     case RenderTargetFormat::R32G32B32A32_FLOAT:
         return impl->converters_cache
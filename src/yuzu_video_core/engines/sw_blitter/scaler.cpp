@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define BLITTER_SSE2
+#endif
+
+#include "yuzu_common/scratch_buffer.h"
+#include "yuzu_video_core/engines/sw_blitter/converter.h"
+#include "yuzu_video_core/engines/sw_blitter/scaler.h"
+#include "yuzu_video_core/surface.h"
+#include "yuzu_video_core/textures/host_simd.h"
+#include "yuzu_video_core/textures/workers.h"
+
+using VideoCore::Surface::BytesPerBlock;
+using VideoCore::Surface::PixelFormatFromRenderTargetFormat;
+
+namespace Tegra::Engines::Blitter {
+
+using namespace Texture;
+
+namespace {
+
+constexpr size_t ir_components = 4;
+
+// Rows are split so a task covers about this many texels, smaller blits stay on this thread
+constexpr u32 TEXELS_PER_TASK = 16384;
+
+template <typename Func>
+void ForEachRows(u32 rows, u32 width, const Func& func) {
+    const u32 rows_per_task = std::max(TEXELS_PER_TASK / std::max(width, 1U), 1U);
+    ForEachChunk(rows, rows_per_task, func);
+}
+
+/// Source texel of every destination texel along one axis, stepping in 32.32 fixed point
+void MakeNearestIndices(Common::ScratchBuffer<u32>& indices, u32 src_size, u32 dst_size) {
+    indices.resize_destructive(dst_size);
+    if (dst_size == 0) {
+        return;
+    }
+    const u64 step = std::llround((static_cast<f64>(src_size) / dst_size) * (1ULL << 32));
+    u64 position = 0;
+    for (u32 i = 0; i < dst_size; i++) {
+        indices[i] = std::min(static_cast<u32>(position >> 32), src_size - 1);
+        position += step;
+    }
+}
+
+struct BilinearTap {
+    u32 index;
+    u32 next;
+    f32 weight;
+};
+
+/// Source texels and weight of every destination texel along one axis, the edges are aligned
+void MakeBilinearTaps(Common::ScratchBuffer<BilinearTap>& taps, u32 src_size, u32 dst_size) {
+    taps.resize_destructive(dst_size);
+    const f32 step =
+        dst_size > 1 ? static_cast<f32>(src_size - 1) / static_cast<f32>(dst_size - 1) : 0.f;
+    for (u32 i = 0; i < dst_size; i++) {
+        const f32 position = static_cast<f32>(i) * step;
+        const f32 low = std::floor(position);
+        taps[i] = {
+            .index = std::min(static_cast<u32>(low), src_size - 1),
+            .next = std::min(static_cast<u32>(std::ceil(position)), src_size - 1),
+            .weight = position - low,
+        };
+    }
+}
+
+template <size_t bpp>
+void NearestNeighborRows(const u8* input, u8* output, u32 src_width, u32 dst_width,
+                         std::span<const u32> x_indices, std::span<const u32> y_indices,
+                         size_t dynamic_bpp, u32 begin, u32 end) {
+    // Constant sizes turn the copies into single moves
+    const size_t texel_size = bpp != 0 ? bpp : dynamic_bpp;
+    for (u32 y = begin; y < end; y++) {
+        const u8* const src_row =
+            input + static_cast<size_t>(y_indices[y]) * src_width * texel_size;
+        u8* const dst_row = output + static_cast<size_t>(y) * dst_width * texel_size;
+        if (src_width == dst_width) {
+            std::memcpy(dst_row, src_row, dst_width * texel_size);
+            continue;
+        }
+        for (u32 x = 0; x < dst_width; x++) {
+            std::memcpy(dst_row + x * texel_size, src_row + x_indices[x] * texel_size, texel_size);
+        }
+    }
+}
+
+void NearestNeighbor(const u8* input, u8* output, u32 src_width, u32 dst_width,
+                     std::span<const u32> x_indices, std::span<const u32> y_indices, size_t bpp,
+                     u32 begin, u32 end) {
+    const auto rows = [&]<size_t fixed_bpp>() {
+        NearestNeighborRows<fixed_bpp>(input, output, src_width, dst_width, x_indices, y_indices,
+                                       bpp, begin, end);
+    };
+    switch (bpp) {
+    case 1:
+        return rows.template operator()<1>();
+    case 2:
+        return rows.template operator()<2>();
+    case 4:
+        return rows.template operator()<4>();
+    case 8:
+        return rows.template operator()<8>();
+    case 16:
+        return rows.template operator()<16>();
+    default:
+        return rows.template operator()<0>();
+    }
+}
+
+void NearestNeighborRow(const f32* input, f32* output, std::span<const u32> x_indices) {
+    for (size_t x = 0; x < x_indices.size(); x++) {
+        std::memcpy(output + x * ir_components, input + x_indices[x] * ir_components,
+                    sizeof(f32) * ir_components);
+    }
+}
+
+void BilinearRow(const f32* top, const f32* bottom, f32* output,
+                 std::span<const BilinearTap> x_taps, f32 weight_y) {
+    const auto lerp = [](f32 a, f32 b, f32 t) { return a + (b - a) * t; };
+    for (size_t x = 0; x < x_taps.size(); x++) {
+        const BilinearTap& x_tap = x_taps[x];
+        const size_t left = x_tap.index * ir_components;
+        const size_t right = x_tap.next * ir_components;
+        for (size_t i = 0; i < ir_components; i++) {
+            const f32 upper = lerp(top[left + i], top[right + i], x_tap.weight);
+            const f32 lower = lerp(bottom[left + i], bottom[right + i], x_tap.weight);
+            output[x * ir_components + i] = lerp(upper, lower, weight_y);
+        }
+    }
+}
+
+#ifdef BLITTER_SSE2
+void NearestNeighborRowSse2(const f32* input, f32* output, std::span<const u32> x_indices) {
+    for (size_t x = 0; x < x_indices.size(); x++) {
+        _mm_storeu_ps(output + x * ir_components,
+                      _mm_loadu_ps(input + x_indices[x] * ir_components));
+    }
+}
+
+void BilinearRowSse2(const f32* top, const f32* bottom, f32* output,
+                     std::span<const BilinearTap> x_taps, f32 weight_y) {
+    // One IR texel fills a vector, so each lane interpolates one component
+    const auto lerp = [](__m128 a, __m128 b, __m128 t) {
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+    };
+    const __m128 weight_y_vector = _mm_set1_ps(weight_y);
+    for (size_t x = 0; x < x_taps.size(); x++) {
+        const BilinearTap& x_tap = x_taps[x];
+        const size_t left = x_tap.index * ir_components;
+        const size_t right = x_tap.next * ir_components;
+        const __m128 weight_x = _mm_set1_ps(x_tap.weight);
+        const __m128 upper = lerp(_mm_loadu_ps(top + left), _mm_loadu_ps(top + right), weight_x);
+        const __m128 lower =
+            lerp(_mm_loadu_ps(bottom + left), _mm_loadu_ps(bottom + right), weight_x);
+        _mm_storeu_ps(output + x * ir_components, lerp(upper, lower, weight_y_vector));
+    }
+}
+#endif
+
+using NearestNeighborRowFn = void (*)(const f32*, f32*, std::span<const u32>);
+using BilinearRowFn = void (*)(const f32*, const f32*, f32*, std::span<const BilinearTap>, f32);
+
+/// Converts source rows to the IR as they are sampled, keeping the two most recent ones so
+/// neighbouring destination rows do not convert them again
+class SourceRows {
+public:
+    explicit SourceRows(Converter& converter_, std::span<const u8> input_, u32 width_,
+                        size_t bytes_per_pixel_)
+        : converter{converter_}, input{input_}, width{width_}, bytes_per_pixel{bytes_per_pixel_} {
+        for (std::vector<f32>& buffer : buffers) {
+            buffer.resize(static_cast<size_t>(width) * ir_components);
+        }
+    }
+
+    const f32* Get(u32 row) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i] == row) {
+                last_used = i;
+                return buffers[i].data();
+            }
+        }
+        last_used ^= 1;
+        const size_t row_size = static_cast<size_t>(width) * bytes_per_pixel;
+        converter.ConvertTo(input.subspan(row * row_size, row_size), buffers[last_used]);
+        rows[last_used] = row;
+        return buffers[last_used].data();
+    }
+
+private:
+    Converter& converter;
+    std::span<const u8> input;
+    u32 width;
+    size_t bytes_per_pixel;
+    std::array<u32, 2> rows{~0U, ~0U};
+    std::array<std::vector<f32>, 2> buffers;
+    size_t last_used{};
+};
+
+} // Anonymous namespace
+
+struct BlitScaler::BlitScalerImpl {
+    Common::ScratchBuffer<u32> x_indices;
+    Common::ScratchBuffer<u32> y_indices;
+    Common::ScratchBuffer<BilinearTap> x_taps;
+    Common::ScratchBuffer<BilinearTap> y_taps;
+    ConverterFactory converter_factory;
+};
+
+BlitScaler::BlitScaler() {
+    impl = std::make_unique<BlitScalerImpl>();
+}
+
+BlitScaler::~BlitScaler() = default;
+
+void BlitScaler::Scale(std::span<const u8> input, RenderTargetFormat src_format, u32 src_width,
+                       u32 src_height, std::span<u8> output, RenderTargetFormat dst_format,
+                       u32 dst_width, u32 dst_height, bool bilinear) {
+    const size_t src_bytes_per_pixel = BytesPerBlock(PixelFormatFromRenderTargetFormat(src_format));
+    const size_t dst_bytes_per_pixel = BytesPerBlock(PixelFormatFromRenderTargetFormat(dst_format));
+
+    if (src_format == dst_format && !bilinear) {
+        MakeNearestIndices(impl->x_indices, src_width, dst_width);
+        MakeNearestIndices(impl->y_indices, src_height, dst_height);
+        ForEachRows(dst_height, dst_width, [&](u32 begin, u32 end) {
+            NearestNeighbor(input.data(), output.data(), src_width, dst_width, impl->x_indices,
+                            impl->y_indices, dst_bytes_per_pixel, begin, end);
+        });
+        return;
+    }
+
+    NearestNeighborRowFn nearest_row = NearestNeighborRow;
+    BilinearRowFn bilinear_row = BilinearRow;
+#ifdef BLITTER_SSE2
+    if (GetHostSimd() >= HostSimd::SSE2) {
+        nearest_row = NearestNeighborRowSse2;
+        bilinear_row = BilinearRowSse2;
+    }
+#endif
+
+    auto* input_converter = impl->converter_factory.GetFormatConverter(src_format);
+    auto* output_converter = impl->converter_factory.GetFormatConverter(dst_format);
+    if (bilinear) {
+        MakeBilinearTaps(impl->x_taps, src_width, dst_width);
+        MakeBilinearTaps(impl->y_taps, src_height, dst_height);
+    } else {
+        MakeNearestIndices(impl->x_indices, src_width, dst_width);
+        MakeNearestIndices(impl->y_indices, src_height, dst_height);
+    }
+
+    // Each row goes through the IR on its own, so the intermediate data stays in cache
+    const size_t dst_row_size = static_cast<size_t>(dst_width) * dst_bytes_per_pixel;
+    ForEachRows(dst_height, dst_width, [&](u32 begin, u32 end) {
+        SourceRows source(*input_converter, input, src_width, src_bytes_per_pixel);
+        std::vector<f32> dst_row(static_cast<size_t>(dst_width) * ir_components);
+        for (u32 y = begin; y < end; y++) {
+            const f32* ir_row = dst_row.data();
+            if (bilinear) {
+                const BilinearTap& y_tap = impl->y_taps[y];
+                const f32* const top = source.Get(y_tap.index);
+                const f32* const bottom = source.Get(y_tap.next);
+                bilinear_row(top, bottom, dst_row.data(), impl->x_taps, y_tap.weight);
+            } else if (src_width == dst_width) {
+                ir_row = source.Get(impl->y_indices[y]);
+            } else {
+                nearest_row(source.Get(impl->y_indices[y]), dst_row.data(), impl->x_indices);
+            }
+            output_converter->ConvertFrom(std::span<const f32>(ir_row, dst_row.size()),
+                                          output.subspan(y * dst_row_size, dst_row_size));
+        }
+    });
+}
+
+} // namespace Tegra::Engines::Blitter
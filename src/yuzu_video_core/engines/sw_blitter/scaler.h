@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "yuzu_common/common_types.h"
+
+#include "yuzu_video_core/gpu.h"
+
+namespace Tegra::Engines::Blitter {
+
+/// Scales and converts pitch linear texels between render target formats, the part of a software
+/// blit that runs once the source rectangle has been read out of guest memory
+class BlitScaler {
+public:
+    BlitScaler();
+    ~BlitScaler();
+
+    void Scale(std::span<const u8> input, RenderTargetFormat src_format, u32 src_width,
+               u32 src_height, std::span<u8> output, RenderTargetFormat dst_format, u32 dst_width,
+               u32 dst_height, bool bilinear);
+
+private:
+    struct BlitScalerImpl;
+    std::unique_ptr<BlitScalerImpl> impl;
+};
+
+} // namespace Tegra::Engines::Blitter
@@ -1,28 +1,39 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
 
-extern "C" {
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define VIC_X64
+#ifdef _MSC_VER
+#define VIC_TARGET_SSE41
+#define VIC_TARGET_AVX2
+#else
+#define VIC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VIC_TARGET_AVX2 __attribute__((target("avx2")))
 #endif
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
 #endif
-}
 
+#include "yuzu_common/alignment.h"
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/bit_field.h"
+#include "yuzu_common/common_funcs.h"
+#include "yuzu_common/div_ceil.h"
 #include "yuzu_common/logging/log.h"
 
-#include "yuzu_video_core/engines/maxwell_3d.h"
 #include "yuzu_video_core/host1x/host1x.h"
 #include "yuzu_video_core/host1x/nvdec.h"
 #include "yuzu_video_core/host1x/vic.h"
 #include "yuzu_video_core/memory_manager.h"
 #include "yuzu_video_core/textures/decoders.h"
+#include "yuzu_video_core/textures/host_simd.h"
+#include "yuzu_video_core/textures/workers.h"
 
 namespace Tegra {
 
@@ -34,6 +45,7 @@ enum class VideoPixelFormat : u64_le {
     BGRA8 = 0x20,
     RGBX8 = 0x23,
     YUV420 = 0x44,
+    YUV420Planar = 0x46,
 };
 } // Anonymous namespace
 
@@ -48,6 +60,356 @@ union VicConfig {
     BitField<46, 14, u64_le> surface_height_minus1;
 };
 
+struct SlotConfig {
+    union {
+        u64_le raw0;
+        BitField<0, 1, u64_le> slot_enable;
+    };
+    INSERT_PADDING_BYTES_NOINIT(0x18);
+    // Source rect is in 16.16 fixed point, both rects are inclusive
+    union {
+        u64_le raw4;
+        BitField<0, 30, u64_le> source_rect_left;
+        BitField<32, 30, u64_le> source_rect_right;
+    };
+    union {
+        u64_le raw5;
+        BitField<0, 30, u64_le> source_rect_top;
+        BitField<32, 30, u64_le> source_rect_bottom;
+    };
+    union {
+        u64_le raw6;
+        BitField<0, 14, u64_le> dest_rect_left;
+        BitField<16, 14, u64_le> dest_rect_right;
+        BitField<32, 14, u64_le> dest_rect_top;
+        BitField<48, 14, u64_le> dest_rect_bottom;
+    };
+    INSERT_PADDING_BYTES_NOINIT(0x8);
+};
+static_assert(sizeof(SlotConfig) == 0x40, "SlotConfig is an invalid size");
+
+struct SlotStruct {
+    SlotConfig config;
+    VicConfig surface_config;
+    INSERT_PADDING_BYTES_NOINIT(0x18); ///< Luma and chroma plane sizes
+    INSERT_PADDING_BYTES_NOINIT(0x80); ///< Luma key, colour and gamut matrices, blending
+};
+static_assert(sizeof(SlotStruct) == 0xe0, "SlotStruct is an invalid size");
+
+union OutputConfig {
+    u64_le raw;
+    BitField<6, 10, u64_le> background_a;
+    BitField<16, 10, u64_le> background_r;
+    BitField<26, 10, u64_le> background_g;
+    BitField<36, 10, u64_le> background_b;
+};
+
+struct ConfigStruct {
+    INSERT_PADDING_BYTES_NOINIT(0x10); ///< Pipe config
+    OutputConfig output_config;
+    INSERT_PADDING_BYTES_NOINIT(0x8); ///< Target rect
+    VicConfig output_surface_config;
+    INSERT_PADDING_BYTES_NOINIT(0x8); ///< Output luma and chroma sizes
+    INSERT_PADDING_BYTES_NOINIT(0x20); ///< Output colour matrix
+    INSERT_PADDING_BYTES_NOINIT(0x40); ///< Clear rects
+    std::array<SlotStruct, Vic::NUM_SLOTS> slots;
+};
+static_assert(offsetof(ConfigStruct, output_surface_config) == 0x20,
+              "output_surface_config is in the wrong place");
+static_assert(offsetof(ConfigStruct, slots) == 0x90, "slots is in the wrong place");
+
+namespace {
+
+// Rows are handed to the worker pool in chunks this tall
+constexpr u32 ROWS_PER_TASK = 16;
+
+template <typename Func>
+void ForEachRows(u32 rows, const Func& func) {
+    Texture::ForEachChunk(rows, ROWS_PER_TASK, func);
+}
+
+// BT.601 limited range with 8 fractional bits, every kernel below produces the same results
+constexpr s32 COEFF_Y = 298;
+constexpr s32 COEFF_RV = 409;
+constexpr s32 COEFF_GU = -100;
+constexpr s32 COEFF_GV = -208;
+constexpr s32 COEFF_BU = 516;
+
+u32 YuvToRgba(u8 y, u8 u, u8 v) {
+    const s32 luma = (static_cast<s32>(y) - 16) * COEFF_Y + 128;
+    const s32 cb = static_cast<s32>(u) - 128;
+    const s32 cr = static_cast<s32>(v) - 128;
+    const u32 r = static_cast<u32>(std::clamp((luma + COEFF_RV * cr) >> 8, 0, 255));
+    const u32 g = static_cast<u32>(std::clamp((luma + COEFF_GU * cb + COEFF_GV * cr) >> 8, 0, 255));
+    const u32 b = static_cast<u32>(std::clamp((luma + COEFF_BU * cb) >> 8, 0, 255));
+    return r | (g << 8) | (b << 16) | 0xff000000U;
+}
+
+/// Converts pixels [begin, end) of a 4:2:0 row, interleaved chroma is read in U, V pairs
+template <bool INTERLEAVED>
+void ConvertPixels(u32* dst, const u8* luma, const u8* chroma_u, const u8* chroma_v, u32 begin,
+                   u32 end) {
+    for (u32 x = begin; x < end; ++x) {
+        const u32 chroma = INTERLEAVED ? x & ~1U : x / 2;
+        dst[x] = YuvToRgba(luma[x], chroma_u[chroma], chroma_v[chroma]);
+    }
+}
+
+template <bool INTERLEAVED>
+void ConvertRowScalar(u32* dst, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                      u32 width) {
+    ConvertPixels<INTERLEAVED>(dst, luma, chroma_u, chroma_v, 0, width);
+}
+
+#ifdef VIC_X64
+constexpr s32 PackCoeffs(s32 low, s32 high) {
+    return static_cast<s32>((static_cast<u32>(high) << 16) | static_cast<u16>(low));
+}
+
+template <bool INTERLEAVED>
+VIC_TARGET_SSE41 void ConvertRowSse41(u32* dst, const u8* luma, const u8* chroma_u,
+                                      const u8* chroma_v, u32 width) {
+    const __m128i luma_offset = _mm_set1_epi16(16);
+    const __m128i chroma_offset = _mm_set1_epi16(128);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i round = _mm_set1_epi32(128);
+    const __m128i coeff_r = _mm_set1_epi32(PackCoeffs(COEFF_Y, COEFF_RV));
+    const __m128i coeff_gu = _mm_set1_epi32(PackCoeffs(COEFF_Y, COEFF_GU));
+    const __m128i coeff_gv = _mm_set1_epi32(PackCoeffs(COEFF_GV, 128));
+    const __m128i coeff_b = _mm_set1_epi32(PackCoeffs(COEFF_Y, COEFF_BU));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i alpha = _mm_set1_epi16(static_cast<s16>(0xff00));
+    // Only the low eight bytes are widened, the rest of each shuffle is ignored
+    const __m128i spread_u =
+        INTERLEAVED ? _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, 0, 0, 0, 0, 0, 0, 0, 0)
+                    : _mm_setr_epi8(0, 0, 1, 1, 2, 2, 3, 3, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i spread_v =
+        INTERLEAVED ? _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, 0, 0, 0, 0, 0, 0, 0, 0) : spread_u;
+
+    u32 x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128i u;
+        __m128i v;
+        if constexpr (INTERLEAVED) {
+            const __m128i uv = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_u + x));
+            u = _mm_shuffle_epi8(uv, spread_u);
+            v = _mm_shuffle_epi8(uv, spread_v);
+        } else {
+            u32 u_bytes;
+            u32 v_bytes;
+            std::memcpy(&u_bytes, chroma_u + x / 2, sizeof(u32));
+            std::memcpy(&v_bytes, chroma_v + x / 2, sizeof(u32));
+            u = _mm_shuffle_epi8(_mm_cvtsi32_si128(static_cast<int>(u_bytes)), spread_u);
+            v = _mm_shuffle_epi8(_mm_cvtsi32_si128(static_cast<int>(v_bytes)), spread_v);
+        }
+        const __m128i y = _mm_sub_epi16(
+            _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(luma + x))),
+            luma_offset);
+        u = _mm_sub_epi16(_mm_cvtepu8_epi16(u), chroma_offset);
+        v = _mm_sub_epi16(_mm_cvtepu8_epi16(v), chroma_offset);
+
+        const __m128i yu_lo = _mm_unpacklo_epi16(y, u);
+        const __m128i yu_hi = _mm_unpackhi_epi16(y, u);
+        const __m128i yv_lo = _mm_unpacklo_epi16(y, v);
+        const __m128i yv_hi = _mm_unpackhi_epi16(y, v);
+        const __m128i v1_lo = _mm_unpacklo_epi16(v, one);
+        const __m128i v1_hi = _mm_unpackhi_epi16(v, one);
+
+        const __m128i r = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yv_lo, coeff_r), round), 8),
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yv_hi, coeff_r), round), 8));
+        const __m128i g = _mm_packs_epi32(
+            _mm_srai_epi32(
+                _mm_add_epi32(_mm_madd_epi16(yu_lo, coeff_gu), _mm_madd_epi16(v1_lo, coeff_gv)),
+                8),
+            _mm_srai_epi32(
+                _mm_add_epi32(_mm_madd_epi16(yu_hi, coeff_gu), _mm_madd_epi16(v1_hi, coeff_gv)),
+                8));
+        const __m128i b = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_lo, coeff_b), round), 8),
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_hi, coeff_b), round), 8));
+
+        const __m128i rg =
+            _mm_or_si128(_mm_min_epi16(_mm_max_epi16(r, zero), max),
+                         _mm_slli_epi16(_mm_min_epi16(_mm_max_epi16(g, zero), max), 8));
+        const __m128i ba = _mm_or_si128(_mm_min_epi16(_mm_max_epi16(b, zero), max), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 4), _mm_unpackhi_epi16(rg, ba));
+    }
+    ConvertPixels<INTERLEAVED>(dst, luma, chroma_u, chroma_v, x, width);
+}
+
+template <bool INTERLEAVED>
+VIC_TARGET_AVX2 void ConvertRowAvx2(u32* dst, const u8* luma, const u8* chroma_u,
+                                    const u8* chroma_v, u32 width) {
+    const __m256i luma_offset = _mm256_set1_epi16(16);
+    const __m256i chroma_offset = _mm256_set1_epi16(128);
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i round = _mm256_set1_epi32(128);
+    const __m256i coeff_r = _mm256_set1_epi32(PackCoeffs(COEFF_Y, COEFF_RV));
+    const __m256i coeff_gu = _mm256_set1_epi32(PackCoeffs(COEFF_Y, COEFF_GU));
+    const __m256i coeff_gv = _mm256_set1_epi32(PackCoeffs(COEFF_GV, 128));
+    const __m256i coeff_b = _mm256_set1_epi32(PackCoeffs(COEFF_Y, COEFF_BU));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi16(255);
+    const __m256i alpha = _mm256_set1_epi16(static_cast<s16>(0xff00));
+    const __m128i spread_u =
+        INTERLEAVED ? _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14)
+                    : _mm_setr_epi8(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m128i spread_v =
+        INTERLEAVED ? _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15)
+                    : spread_u;
+
+    u32 x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i u8x16;
+        __m128i v8x16;
+        if constexpr (INTERLEAVED) {
+            const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_u + x));
+            u8x16 = _mm_shuffle_epi8(uv, spread_u);
+            v8x16 = _mm_shuffle_epi8(uv, spread_v);
+        } else {
+            u8x16 = _mm_shuffle_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_u + x / 2)), spread_u);
+            v8x16 = _mm_shuffle_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_v + x / 2)), spread_v);
+        }
+        const __m256i y = _mm256_sub_epi16(
+            _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + x))),
+            luma_offset);
+        const __m256i u = _mm256_sub_epi16(_mm256_cvtepu8_epi16(u8x16), chroma_offset);
+        const __m256i v = _mm256_sub_epi16(_mm256_cvtepu8_epi16(v8x16), chroma_offset);
+
+        // Unpacks and packs both stay within 128-bit lanes, so pixel order survives until the
+        // final interleave
+        const __m256i yu_lo = _mm256_unpacklo_epi16(y, u);
+        const __m256i yu_hi = _mm256_unpackhi_epi16(y, u);
+        const __m256i yv_lo = _mm256_unpacklo_epi16(y, v);
+        const __m256i yv_hi = _mm256_unpackhi_epi16(y, v);
+        const __m256i v1_lo = _mm256_unpacklo_epi16(v, one);
+        const __m256i v1_hi = _mm256_unpackhi_epi16(v, one);
+
+        const __m256i r = _mm256_packs_epi32(
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yv_lo, coeff_r), round), 8),
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yv_hi, coeff_r), round), 8));
+        const __m256i g = _mm256_packs_epi32(
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_lo, coeff_gu),
+                                               _mm256_madd_epi16(v1_lo, coeff_gv)),
+                              8),
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_hi, coeff_gu),
+                                               _mm256_madd_epi16(v1_hi, coeff_gv)),
+                              8));
+        const __m256i b = _mm256_packs_epi32(
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_lo, coeff_b), round), 8),
+            _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_hi, coeff_b), round), 8));
+
+        const __m256i rg = _mm256_or_si256(
+            _mm256_min_epi16(_mm256_max_epi16(r, zero), max),
+            _mm256_slli_epi16(_mm256_min_epi16(_mm256_max_epi16(g, zero), max), 8));
+        const __m256i ba = _mm256_or_si256(_mm256_min_epi16(_mm256_max_epi16(b, zero), max), alpha);
+        const __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+        const __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    ConvertPixels<INTERLEAVED>(dst, luma, chroma_u, chroma_v, x, width);
+}
+#endif
+
+using ConvertRowFunc = void (*)(u32* dst, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                                u32 width);
+
+template <bool INTERLEAVED>
+ConvertRowFunc GetConvertRow() {
+#ifdef VIC_X64
+    using Texture::HostSimd;
+    const HostSimd simd = Texture::GetHostSimd();
+    if (simd >= HostSimd::AVX2) {
+        return ConvertRowAvx2<INTERLEAVED>;
+    }
+    if (simd >= HostSimd::SSE41) {
+        return ConvertRowSse41<INTERLEAVED>;
+    }
+#endif
+    return ConvertRowScalar<INTERLEAVED>;
+}
+
+struct Rect {
+    u32 left;
+    u32 top;
+    u32 width;
+    u32 height;
+};
+
+/// Clips an inclusive rect to a surface, one that was left unset covers the whole surface
+Rect MakeRect(u32 left, u32 top, u32 right, u32 bottom, u32 surface_width, u32 surface_height) {
+    if (left == 0 && top == 0 && right == 0 && bottom == 0) {
+        return Rect{0, 0, surface_width, surface_height};
+    }
+    if (right < left || bottom < top || left >= surface_width || top >= surface_height) {
+        return Rect{0, 0, 0, 0};
+    }
+    return Rect{
+        .left = left,
+        .top = top,
+        .width = std::min(right + 1, surface_width) - left,
+        .height = std::min(bottom + 1, surface_height) - top,
+    };
+}
+
+struct ScaleTap {
+    u32 index;
+    u32 next;
+    u32 weight; ///< Weight of next, out of 256
+};
+
+/// Bilinear taps mapping every destination texel centre back onto the source
+std::vector<ScaleTap> MakeScaleTaps(u32 src_size, u32 dst_size) {
+    std::vector<ScaleTap> taps(dst_size);
+    for (u32 i = 0; i < dst_size; ++i) {
+        const s64 position =
+            static_cast<s64>((2 * static_cast<u64>(i) + 1) * src_size * 256 / (2 * dst_size)) -
+            128;
+        const u32 clamped = static_cast<u32>(std::max<s64>(position, 0));
+        const u32 index = std::min(clamped >> 8, src_size - 1);
+        taps[i] = ScaleTap{
+            .index = index,
+            .next = std::min(index + 1, src_size - 1),
+            .weight = clamped & 0xff,
+        };
+    }
+    return taps;
+}
+
+u32 Lerp(u32 a, u32 b, u32 weight) {
+    const u32 inverse = 256 - weight;
+    const u32 rb = (((a & 0xff00ff) * inverse + (b & 0xff00ff) * weight) >> 8) & 0xff00ff;
+    const u32 ga = (((a >> 8) & 0xff00ff) * inverse + ((b >> 8) & 0xff00ff) * weight) & 0xff00ff00;
+    return rb | ga;
+}
+
+u8 RgbToLuma(u32 r, u32 g, u32 b) {
+    return static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+u8 RgbToCb(s32 r, s32 g, s32 b) {
+    return static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+u8 RgbToCr(s32 r, s32 g, s32 b) {
+    return static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+} // Anonymous namespace
+
+void ConvertYuv420Row(u32* dst, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                      u32 width, bool interleaved) {
+    const ConvertRowFunc convert_row = interleaved ? GetConvertRow<true>() : GetConvertRow<false>();
+    convert_row(dst, luma, chroma_u, chroma_v, width);
+}
+
 Vic::Vic(Host1x& host1x_, std::shared_ptr<Nvdec> nvdec_processor_)
     : host1x(host1x_),
       nvdec_processor(std::move(nvdec_processor_)) {}
@@ -71,12 +433,291 @@ void Vic::ProcessMethod(Method method, u32 argument) {
         output_surface_chroma_address = arg;
         break;
     default:
+        if (method >= Method::SetSurface0Slot0LumaOffset &&
+            method <= Method::SetSurface7Slot7ChromaVOffset) {
+            const u32 index = static_cast<u32>(method) -
+                              static_cast<u32>(Method::SetSurface0Slot0LumaOffset);
+            SurfaceAddresses& surface =
+                slot_surfaces[index / (NUM_SLOT_SURFACES * 3)][(index / 3) % NUM_SLOT_SURFACES];
+            std::array<GPUVAddr*, 3> planes{&surface.luma, &surface.chroma_u, &surface.chroma_v};
+            *planes[index % 3] = arg;
+        }
         break;
     }
 }
 
 void Vic::Execute() {
-    UNIMPLEMENTED();
+    if (output_surface_luma_address == 0) {
+        LOG_ERROR(Service_NVDRV, "VIC Luma address not set.");
+        return;
+    }
+    ConfigStruct config;
+    host1x.GMMU().ReadBlock(config_struct_address, &config, sizeof(ConfigStruct));
+
+    const VicConfig& output_config = config.output_surface_config;
+    const u32 width = static_cast<u32>(output_config.surface_width_minus1) + 1;
+    const u32 height = static_cast<u32>(output_config.surface_height_minus1) + 1;
+
+    // Slots are composed in order over the background colour, whose channels are 10 bit
+    const OutputConfig& background = config.output_config;
+    const u32 background_colour = static_cast<u32>(background.background_r >> 2) |
+                                  static_cast<u32>(background.background_g >> 2) << 8 |
+                                  static_cast<u32>(background.background_b >> 2) << 16 |
+                                  static_cast<u32>(background.background_a >> 2) << 24;
+    output_pixels.resize_destructive(static_cast<size_t>(width) * height);
+    std::fill_n(output_pixels.data(), output_pixels.size(), background_colour);
+
+    for (size_t slot = 0; slot < NUM_SLOTS; ++slot) {
+        if (config.slots[slot].config.slot_enable) {
+            ComposeSlot(config.slots[slot], slot_surfaces[slot][0], width, height);
+        }
+    }
+
+    switch (output_config.pixel_format) {
+    case VideoPixelFormat::RGBA8:
+    case VideoPixelFormat::BGRA8:
+    case VideoPixelFormat::RGBX8:
+        WriteRGBFrame(output_config, width, height);
+        break;
+    case VideoPixelFormat::YUV420:
+        WriteYUVFrame(output_config, width, height);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unknown video pixel format {:X}",
+                          static_cast<u64>(output_config.pixel_format.Value()));
+        break;
+    }
+}
+
+void Vic::ComposeSlot(const SlotStruct& slot, const SurfaceAddresses& surface, u32 output_width,
+                      u32 output_height) {
+    const VicConfig& surface_config = slot.surface_config;
+    const VideoPixelFormat format = surface_config.pixel_format;
+    if (format != VideoPixelFormat::YUV420 && format != VideoPixelFormat::YUV420Planar) {
+        UNIMPLEMENTED_MSG("Unsupported VIC slot pixel format {:X}", static_cast<u64>(format));
+        return;
+    }
+    const bool planar = format == VideoPixelFormat::YUV420Planar;
+    if (surface.luma == 0 || surface.chroma_u == 0 || (planar && surface.chroma_v == 0)) {
+        LOG_ERROR(Service_NVDRV, "VIC slot surface address not set.");
+        return;
+    }
+
+    const u32 surface_width = static_cast<u32>(surface_config.surface_width_minus1) + 1;
+    const u32 surface_height = static_cast<u32>(surface_config.surface_height_minus1) + 1;
+    const u32 chroma_width = Common::DivCeil(surface_width, 2U);
+    const u32 chroma_height = Common::DivCeil(surface_height, 2U);
+    const u32 luma_pitch =
+        ReadPlane(luma_buffer, surface.luma, surface_config, 1, surface_width, surface_height);
+    const u32 chroma_pitch = ReadPlane(chroma_buffer, surface.chroma_u, surface_config,
+                                       planar ? 1 : 2, chroma_width, chroma_height);
+    if (planar) {
+        ReadPlane(chroma_v_buffer, surface.chroma_v, surface_config, 1, chroma_width,
+                  chroma_height);
+    }
+
+    const SlotConfig& slot_config = slot.config;
+    const Rect src = MakeRect(static_cast<u32>(slot_config.source_rect_left >> 16),
+                              static_cast<u32>(slot_config.source_rect_top >> 16),
+                              static_cast<u32>(slot_config.source_rect_right >> 16),
+                              static_cast<u32>(slot_config.source_rect_bottom >> 16),
+                              surface_width, surface_height);
+    const Rect dst = MakeRect(static_cast<u32>(slot_config.dest_rect_left),
+                              static_cast<u32>(slot_config.dest_rect_top),
+                              static_cast<u32>(slot_config.dest_rect_right),
+                              static_cast<u32>(slot_config.dest_rect_bottom), output_width,
+                              output_height);
+
+    if (src.width == 0 || src.height == 0 || dst.width == 0 || dst.height == 0) {
+        return;
+    }
+
+    // Chroma is shared by pairs of columns. An odd crop is converted from the column before it,
+    // so every pixel keeps its own chroma sample, and that extra pixel is dropped afterwards.
+    const u32 phase = src.left & 1;
+    const u32 aligned_left = src.left - phase;
+    const ConvertRowFunc convert_row = planar ? GetConvertRow<false>() : GetConvertRow<true>();
+    const auto convert = [&](u32 row, u32* dst_row, std::vector<u32>& scratch) {
+        const u32 y = src.top + row;
+        u32* const out = phase != 0 ? scratch.data() : dst_row;
+        const u8* const luma =
+            luma_buffer.data() + static_cast<size_t>(y) * luma_pitch + aligned_left;
+        const size_t chroma_offset = static_cast<size_t>(y / 2) * chroma_pitch;
+        if (planar) {
+            convert_row(out, luma, chroma_buffer.data() + chroma_offset + aligned_left / 2,
+                        chroma_v_buffer.data() + chroma_offset + aligned_left / 2,
+                        src.width + phase);
+        } else {
+            const u8* const chroma = chroma_buffer.data() + chroma_offset + aligned_left;
+            convert_row(out, luma, chroma, chroma + 1, src.width + phase);
+        }
+        if (phase != 0) {
+            std::memcpy(dst_row, scratch.data() + 1, src.width * sizeof(u32));
+        }
+    };
+
+    if (src.width == dst.width && src.height == dst.height) {
+        ForEachRows(dst.height, [&](u32 begin, u32 end) {
+            std::vector<u32> scratch(phase != 0 ? src.width + 1 : 0);
+            for (u32 row = begin; row < end; ++row) {
+                convert(row,
+                        output_pixels.data() +
+                            static_cast<size_t>(dst.top + row) * output_width + dst.left,
+                        scratch);
+            }
+        });
+        return;
+    }
+
+    slot_pixels.resize_destructive(static_cast<size_t>(src.width) * src.height);
+    ForEachRows(src.height, [&](u32 begin, u32 end) {
+        std::vector<u32> scratch(phase != 0 ? src.width + 1 : 0);
+        for (u32 row = begin; row < end; ++row) {
+            convert(row, slot_pixels.data() + static_cast<size_t>(row) * src.width, scratch);
+        }
+    });
+
+    const std::vector<ScaleTap> x_taps = MakeScaleTaps(src.width, dst.width);
+    const std::vector<ScaleTap> y_taps = MakeScaleTaps(src.height, dst.height);
+    ForEachRows(dst.height, [&](u32 begin, u32 end) {
+        for (u32 row = begin; row < end; ++row) {
+            const ScaleTap& y_tap = y_taps[row];
+            const u32* const top =
+                slot_pixels.data() + static_cast<size_t>(y_tap.index) * src.width;
+            const u32* const bottom =
+                slot_pixels.data() + static_cast<size_t>(y_tap.next) * src.width;
+            u32* const dst_row =
+                output_pixels.data() + static_cast<size_t>(dst.top + row) * output_width + dst.left;
+            for (u32 x = 0; x < dst.width; ++x) {
+                const ScaleTap& x_tap = x_taps[x];
+                dst_row[x] = Lerp(Lerp(top[x_tap.index], top[x_tap.next], x_tap.weight),
+                                  Lerp(bottom[x_tap.index], bottom[x_tap.next], x_tap.weight),
+                                  y_tap.weight);
+            }
+        }
+    });
+}
+
+u32 Vic::ReadPlane(Common::ScratchBuffer<u8>& plane, GPUVAddr address, const VicConfig& config,
+                   u32 bytes_per_pixel, u32 width, u32 height) {
+    if (config.block_linear_kind != 0) {
+        const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+        const size_t size =
+            Texture::CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+        swizzle_buffer.resize_destructive(size);
+        host1x.GMMU().ReadBlock(address, swizzle_buffer.data(), size);
+        plane.resize_destructive(static_cast<size_t>(width) * height * bytes_per_pixel);
+        Texture::UnswizzleTexture(plane, swizzle_buffer, bytes_per_pixel, width, height, 1,
+                                  block_height, 0);
+        return width * bytes_per_pixel;
+    }
+    // Pitch linear rows are aligned to 256 bytes
+    const u32 pitch = Common::AlignUp(width * bytes_per_pixel, 256U);
+    plane.resize_destructive(static_cast<size_t>(pitch) * height);
+    host1x.GMMU().ReadBlock(address, plane.data(), plane.size());
+    return pitch;
+}
+
+void Vic::WriteRGBFrame(const VicConfig& config, u32 width, u32 height) {
+    LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
+
+    if (config.pixel_format == VideoPixelFormat::BGRA8) {
+        ForEachRows(height, [&](u32 begin, u32 end) {
+            u32* const pixels = output_pixels.data();
+            const size_t last = static_cast<size_t>(end) * width;
+            for (size_t i = static_cast<size_t>(begin) * width; i < last; ++i) {
+                const u32 pixel = pixels[i];
+                pixels[i] = (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+            }
+        });
+    }
+
+    const std::span<const u8> frame{reinterpret_cast<const u8*>(output_pixels.data()),
+                                    static_cast<size_t>(width) * height * 4};
+    const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+    if (blk_kind != 0) {
+        // swizzle pitch linear to block linear
+        const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+        const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+        luma_buffer.resize_destructive(size);
+        Texture::SwizzleTexture(luma_buffer, frame, 4, width, height, 1, block_height, 0);
+
+        host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
+    } else {
+        // send pitch linear frame
+        host1x.GMMU().WriteBlock(output_surface_luma_address, frame.data(), frame.size());
+    }
+}
+
+void Vic::WriteYUVFrame(const VicConfig& config, u32 width, u32 height) {
+    LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
+
+    const bool block_linear = config.block_linear_kind != 0;
+    const u32 chroma_width = Common::DivCeil(width, 2U);
+    const u32 chroma_height = Common::DivCeil(height, 2U);
+    const u32 luma_pitch = block_linear ? width : Common::AlignUp(width, 256U);
+    const u32 chroma_pitch = block_linear ? chroma_width * 2 : Common::AlignUp(width, 256U);
+    luma_buffer.resize_destructive(static_cast<size_t>(luma_pitch) * height);
+    chroma_buffer.resize_destructive(static_cast<size_t>(chroma_pitch) * chroma_height);
+
+    // Each chroma row covers two luma rows, chroma is the average of the 2x2 texels it covers
+    ForEachRows(chroma_height, [&](u32 begin, u32 end) {
+        for (u32 chroma_y = begin; chroma_y < end; ++chroma_y) {
+            const u32 y0 = chroma_y * 2;
+            const u32 y1 = std::min(y0 + 1, height - 1);
+            const u32* const row0 = output_pixels.data() + static_cast<size_t>(y0) * width;
+            const u32* const row1 = output_pixels.data() + static_cast<size_t>(y1) * width;
+            u8* const luma0 = luma_buffer.data() + static_cast<size_t>(y0) * luma_pitch;
+            u8* const luma1 = luma_buffer.data() + static_cast<size_t>(y1) * luma_pitch;
+            u8* const chroma = chroma_buffer.data() + static_cast<size_t>(chroma_y) * chroma_pitch;
+            for (u32 x = 0; x < width; x += 2) {
+                const u32 x1 = std::min(x + 1, width - 1);
+                const std::array<u32, 4> pixels{row0[x], row0[x1], row1[x], row1[x1]};
+                s32 r = 0;
+                s32 g = 0;
+                s32 b = 0;
+                for (const u32 pixel : pixels) {
+                    r += pixel & 0xff;
+                    g += (pixel >> 8) & 0xff;
+                    b += (pixel >> 16) & 0xff;
+                }
+                r = (r + 2) / 4;
+                g = (g + 2) / 4;
+                b = (b + 2) / 4;
+                luma0[x] = RgbToLuma(pixels[0] & 0xff, (pixels[0] >> 8) & 0xff,
+                                     (pixels[0] >> 16) & 0xff);
+                luma0[x1] = RgbToLuma(pixels[1] & 0xff, (pixels[1] >> 8) & 0xff,
+                                      (pixels[1] >> 16) & 0xff);
+                luma1[x] = RgbToLuma(pixels[2] & 0xff, (pixels[2] >> 8) & 0xff,
+                                     (pixels[2] >> 16) & 0xff);
+                luma1[x1] = RgbToLuma(pixels[3] & 0xff, (pixels[3] >> 8) & 0xff,
+                                      (pixels[3] >> 16) & 0xff);
+                chroma[x] = RgbToCb(r, g, b);
+                chroma[x + 1] = RgbToCr(r, g, b);
+            }
+        }
+    });
+
+    if (block_linear) {
+        const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+        const auto luma_size = Texture::CalculateSize(true, 1, width, height, 1, block_height, 0);
+        swizzle_buffer.resize_destructive(luma_size);
+        Texture::SwizzleTexture(swizzle_buffer, luma_buffer, 1, width, height, 1, block_height, 0);
+        host1x.GMMU().WriteBlock(output_surface_luma_address, swizzle_buffer.data(), luma_size);
+
+        const auto chroma_size =
+            Texture::CalculateSize(true, 2, chroma_width, chroma_height, 1, block_height, 0);
+        swizzle_buffer.resize_destructive(chroma_size);
+        Texture::SwizzleTexture(swizzle_buffer, chroma_buffer, 2, chroma_width, chroma_height, 1,
+                                block_height, 0);
+        host1x.GMMU().WriteBlock(output_surface_chroma_address, swizzle_buffer.data(),
+                                 chroma_size);
+    } else {
+        host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(),
+                                 luma_buffer.size());
+        host1x.GMMU().WriteBlock(output_surface_chroma_address, chroma_buffer.data(),
+                                 chroma_buffer.size());
+    }
 }
 
 } // namespace Host1x
@@ -3,13 +3,12 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/scratch_buffer.h"
 
-struct SwsContext;
-
 namespace Tegra {
 
 namespace Host1x {
@@ -17,11 +16,21 @@ namespace Host1x {
 class Host1x;
 class Nvdec;
 union VicConfig;
+struct SlotStruct;
+
+/**
+ * Converts a row of a 4:2:0 surface to RGBA8 with the best kernel GetHostSimd allows.
+ * Interleaved chroma is read as U, V pairs starting at chroma_u, and chroma_v is ignored.
+ */
+void ConvertYuv420Row(u32* dst, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                      u32 width, bool interleaved);
 
 class Vic {
 public:
     enum class Method : u32 {
         Execute = 0xc0,
+        SetSurface0Slot0LumaOffset = 0x100,
+        SetSurface7Slot7ChromaVOffset = 0x1bf,
         SetControlParams = 0x1c1,
         SetConfigStructOffset = 0x1c2,
         SetOutputSurfaceLumaOffset = 0x1c8,
@@ -29,6 +38,9 @@ public:
         SetOutputSurfaceChromaUnusedOffset = 0x1ca
     };
 
+    static constexpr size_t NUM_SLOTS = 8;
+    static constexpr size_t NUM_SLOT_SURFACES = 8;
+
     explicit Vic(Host1x& host1x, std::shared_ptr<Nvdec> nvdec_processor);
 
     ~Vic();
@@ -37,8 +49,26 @@ public:
     void ProcessMethod(Method method, u32 argument);
 
 private:
+    /// Planes of one input surface, slot surface 0 is the current field
+    struct SurfaceAddresses {
+        GPUVAddr luma{};
+        GPUVAddr chroma_u{};
+        GPUVAddr chroma_v{};
+    };
+
     void Execute();
 
+    /// Converts the current surface of a slot to RGBA and scales it into its destination rect.
+    void ComposeSlot(const SlotStruct& slot, const SurfaceAddresses& surface, u32 output_width,
+                     u32 output_height);
+
+    /// Reads a plane of an input surface into linear memory, returns its pitch in bytes.
+    u32 ReadPlane(Common::ScratchBuffer<u8>& plane, GPUVAddr address, const VicConfig& config,
+                  u32 bytes_per_pixel, u32 width, u32 height);
+
+    void WriteRGBFrame(const VicConfig& config, u32 width, u32 height);
+    void WriteYUVFrame(const VicConfig& config, u32 width, u32 height);
+
     Host1x& host1x;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
 
@@ -46,14 +76,16 @@ private:
     /// size does not change during a stream
     Common::ScratchBuffer<u8> luma_buffer;
     Common::ScratchBuffer<u8> chroma_buffer;
+    Common::ScratchBuffer<u8> chroma_v_buffer;
+    Common::ScratchBuffer<u8> swizzle_buffer;
+    Common::ScratchBuffer<u32> slot_pixels;
+    Common::ScratchBuffer<u32> output_pixels;
+
+    std::array<std::array<SurfaceAddresses, NUM_SLOT_SURFACES>, NUM_SLOTS> slot_surfaces{};
 
     GPUVAddr config_struct_address{};
     GPUVAddr output_surface_luma_address{};
     GPUVAddr output_surface_chroma_address{};
-
-    SwsContext* scaler_ctx{};
-    s32 scaler_width{};
-    s32 scaler_height{};
 };
 
 } // namespace Host1x
@@ -0,0 +1,505 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "yuzu_common/cityhash.h"
+#include "yuzu_common/fs/fs.h"
+#include "yuzu_common/fs/path_util.h"
+#include "yuzu_common/literals.h"
+#include "yuzu_common/logging/log.h"
+#include "yuzu_common/settings.h"
+#include "yuzu_video_core/texture_cache/decoded_texture_cache.h"
+
+namespace VideoCommon {
+
+namespace {
+
+using namespace Common::Literals;
+
+// Bump whenever the decoders or the layout of their output change, older packs are discarded.
+constexpr u32 PACK_VERSION = 1;
+constexpr u32 PACK_MAGIC = Common::MakeMagic('N', 'X', 'D', 'T');
+constexpr u32 RECORD_MAGIC = Common::MakeMagic('D', 'T', 'E', 'X');
+constexpr u32 LRU_MAGIC = Common::MakeMagic('N', 'X', 'D', 'L');
+
+struct PackHeader {
+    u32 magic;
+    u32 version;
+};
+static_assert(sizeof(PackHeader) == 8);
+
+struct RecordHeader {
+    u32 magic;
+    u32 size;
+    u128 content;
+    u64 descriptor;
+    u64 data_hash;
+};
+static_assert(sizeof(RecordHeader) == 40);
+
+struct LruHeader {
+    u32 magic;
+    u32 version;
+    u64 session;
+};
+static_assert(sizeof(LruHeader) == 16);
+
+struct LruRecord {
+    u128 content;
+    u64 descriptor;
+    u64 last_used;
+};
+static_assert(sizeof(LruRecord) == 32);
+
+// Trimming stops below the limit so that a full pack is not rewritten on every launch
+constexpr u64 TRIM_TARGET_NUMERATOR = 3;
+constexpr u64 TRIM_TARGET_DENOMINATOR = 4;
+
+u64 GetSizeLimit() {
+    return static_cast<u64>(Settings::values.disk_texture_cache_size.GetValue()) * 1_MiB;
+}
+
+u64 HashData(std::span<const u8> data) {
+    return Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+bool CreatePack(const std::filesystem::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write};
+    const PackHeader header{PACK_MAGIC, PACK_VERSION};
+    return file.IsOpen() && file.WriteObject(header);
+}
+
+} // Anonymous namespace
+
+DecodedTextureCache::DecodedTextureCache() = default;
+
+DecodedTextureCache::~DecodedTextureCache() {
+    if (writer) {
+        writer->WaitForRequests();
+    }
+
+    std::scoped_lock lk{lock};
+    Close();
+}
+
+void DecodedTextureCache::Open(u64 program_id_) {
+    if (program_id_ == 0) {
+        program_id_ = Settings::values.disk_texture_cache_title_id.GetValue();
+    }
+    if (!Settings::values.use_disk_texture_cache.GetValue() || program_id_ == 0) {
+        return;
+    }
+    {
+        std::scoped_lock lk{lock};
+        if (is_open && program_id == program_id_) {
+            return;
+        }
+    }
+
+    // Pending writes belong to the pack that is about to be closed. The writer is created before
+    // the pack is marked open, which Store checks under the lock before queueing.
+    if (writer) {
+        writer->WaitForRequests();
+    } else {
+        writer.emplace(1, "TextureCacheWriter");
+    }
+
+    std::scoped_lock lk{lock};
+    Close();
+
+    program_id = program_id_;
+    base_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "texture" /
+               fmt::format("{:016x}", program_id);
+    if (!Common::FS::CreateDirs(base_dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create the decoded texture cache directory");
+        return;
+    }
+
+    const auto pack_path = base_dir / "decoded.bin";
+    const auto lru_path = base_dir / "decoded.lru";
+    LoadIndex(pack_path, lru_path);
+
+    const u64 size_limit = GetSizeLimit();
+    if (pack_size > size_limit) {
+        Trim(pack_path, size_limit);
+    }
+    if (!OpenPack(pack_path)) {
+        return;
+    }
+
+    LOG_INFO(HW_GPU, "Loaded {} decoded textures ({} MiB) for title {:016x}", entries.size(),
+             pack_size / 1_MiB, program_id);
+}
+
+bool DecodedTextureCache::IsOpen() {
+    std::scoped_lock lk{lock};
+    return is_open;
+}
+
+DecodedTextureKey DecodedTextureCache::MakeKey(std::span<const u8> input, u64 descriptor) {
+    return DecodedTextureKey{
+        .content = Common::CityHash128(reinterpret_cast<const char*>(input.data()), input.size()),
+        .descriptor = descriptor,
+    };
+}
+
+bool DecodedTextureCache::Load(const DecodedTextureKey& key, std::span<u8> output) {
+    u64 data_hash{};
+    {
+        std::scoped_lock lk{lock};
+        if (!is_open) {
+            return false;
+        }
+        const auto it = entries.find(key);
+        if (it == entries.end() || it->second.size != output.size()) {
+            return false;
+        }
+
+        Entry& entry = it->second;
+        if (entry.offset + entry.size <= mapping.Size()) {
+            std::memcpy(output.data(), mapping.Data() + entry.offset, entry.size);
+        } else if (!reader.Seek(static_cast<s64>(entry.offset)) ||
+                   reader.ReadSpan(output) != output.size()) {
+            entries.erase(it);
+            return false;
+        }
+        if (entry.last_used != session) {
+            entry.last_used = session;
+            lru_changed = true;
+        }
+        data_hash = entry.data_hash;
+    }
+
+    // A torn or corrupted record is dropped and decoded again
+    if (HashData(output) != data_hash) {
+        LOG_WARNING(HW_GPU, "Decoded texture cache entry failed verification, decoding again");
+        std::scoped_lock lk{lock};
+        entries.erase(key);
+        return false;
+    }
+    return true;
+}
+
+void DecodedTextureCache::Store(const DecodedTextureKey& key, std::span<const u8> data) {
+    {
+        std::scoped_lock lk{lock};
+        if (!is_open || entries.contains(key)) {
+            return;
+        }
+    }
+    writer->QueueWork([this, key, data = std::vector<u8>(data.begin(), data.end())]() mutable {
+        Append(key, std::move(data));
+    });
+}
+
+void DecodedTextureCache::Close() {
+    if (!is_open) {
+        return;
+    }
+    if (lru_changed) {
+        SaveLru();
+    }
+    pack.Close();
+    reader.Close();
+    mapping.Unmap();
+    entries.clear();
+    pack_size = 0;
+    lru_changed = false;
+    is_open = false;
+}
+
+bool DecodedTextureCache::OpenPack(const std::filesystem::path& pack_path) {
+    pack.Open(pack_path, Common::FS::FileAccessMode::Append, Common::FS::FileType::BinaryFile,
+              Common::FS::FileShareFlag::ShareReadWrite);
+    reader.Open(pack_path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile,
+                Common::FS::FileShareFlag::ShareReadWrite);
+    if (!pack.IsOpen() || !reader.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open the decoded texture pack");
+        pack.Close();
+        reader.Close();
+        mapping.Unmap();
+        entries.clear();
+        pack_size = 0;
+        is_open = false;
+        return false;
+    }
+    is_open = true;
+    return true;
+}
+
+void DecodedTextureCache::TrimOpenPack(u64 size_limit) {
+    // Runs on the writer thread. The kept entries are copied out of a mapping of its own, which
+    // covers what was appended since the pack was opened, and only the swap takes the lock so
+    // Load keeps serving the old pack while the new one is written.
+    const auto pack_path = base_dir / "decoded.bin";
+    const auto temp_path = base_dir / "decoded.bin.tmp";
+    pack.Close();
+
+    EntryMap current;
+    {
+        std::scoped_lock lk{lock};
+        current = entries;
+    }
+    std::optional<TrimmedPack> trimmed;
+    {
+        const Common::FS::FileMapping source{pack_path};
+        trimmed = WriteTrimmedPack(temp_path, std::span(source.Data(), source.Size()), current,
+                                   size_limit);
+    }
+
+    std::scoped_lock lk{lock};
+    if (trimmed) {
+        ReplacePack(pack_path, temp_path, std::move(*trimmed));
+    }
+    OpenPack(pack_path);
+}
+
+void DecodedTextureCache::LoadIndex(const std::filesystem::path& pack_path,
+                                    const std::filesystem::path& lru_path) {
+    entries.clear();
+    pack_size = 0;
+    session = 1;
+
+    // Last use of every entry, by the number of the session that last read it
+    std::unordered_map<DecodedTextureKey, u64, DecodedTextureKeyHash> last_used;
+    {
+        Common::FS::IOFile lru_file{lru_path, Common::FS::FileAccessMode::Read};
+        LruHeader header{};
+        if (lru_file.IsOpen() && lru_file.ReadObject(header) && header.magic == LRU_MAGIC &&
+            header.version == PACK_VERSION) {
+            session = header.session + 1;
+            std::vector<LruRecord> records((lru_file.GetSize() - sizeof(LruHeader)) /
+                                           sizeof(LruRecord));
+            if (lru_file.ReadSpan(std::span(records)) == records.size()) {
+                for (const LruRecord& record : records) {
+                    last_used.emplace(DecodedTextureKey{record.content, record.descriptor},
+                                      record.last_used);
+                }
+            }
+        }
+    }
+
+    mapping = Common::FS::FileMapping{pack_path};
+    PackHeader header{};
+    if (mapping.Size() >= sizeof(PackHeader)) {
+        std::memcpy(&header, mapping.Data(), sizeof(PackHeader));
+    }
+    if (header.magic != PACK_MAGIC || header.version != PACK_VERSION) {
+        mapping.Unmap();
+        if (!CreatePack(pack_path)) {
+            LOG_ERROR(HW_GPU, "Failed to create the decoded texture pack");
+        }
+        pack_size = sizeof(PackHeader);
+        return;
+    }
+
+    u64 offset = sizeof(PackHeader);
+    while (offset + sizeof(RecordHeader) <= mapping.Size()) {
+        RecordHeader record{};
+        std::memcpy(&record, mapping.Data() + offset, sizeof(RecordHeader));
+        const u64 data_offset = offset + sizeof(RecordHeader);
+        if (record.magic != RECORD_MAGIC || data_offset + record.size > mapping.Size()) {
+            break;
+        }
+
+        const DecodedTextureKey key{record.content, record.descriptor};
+        const auto used_it = last_used.find(key);
+        const u64 used = used_it != last_used.end() ? used_it->second : 0;
+        entries.insert_or_assign(key, Entry{data_offset, record.size, record.data_hash, used});
+        offset = data_offset + record.size;
+    }
+    pack_size = offset;
+
+    // A write that was cut short leaves a partial record at the end, drop it before appending
+    if (pack_size != mapping.Size()) {
+        LOG_WARNING(HW_GPU, "Discarding {} trailing bytes of the decoded texture pack",
+                    mapping.Size() - pack_size);
+        mapping.Unmap();
+        Common::FS::IOFile file{pack_path, Common::FS::FileAccessMode::ReadWrite};
+        if (!file.IsOpen() || !file.SetSize(pack_size)) {
+            LOG_ERROR(HW_GPU, "Failed to truncate the decoded texture pack");
+        }
+        file.Close();
+        mapping = Common::FS::FileMapping{pack_path};
+    }
+}
+
+void DecodedTextureCache::Trim(const std::filesystem::path& pack_path, u64 size_limit) {
+    const auto temp_path = base_dir / "decoded.bin.tmp";
+    auto trimmed =
+        WriteTrimmedPack(temp_path, std::span(mapping.Data(), mapping.Size()), entries, size_limit);
+    if (trimmed) {
+        ReplacePack(pack_path, temp_path, std::move(*trimmed));
+    }
+}
+
+auto DecodedTextureCache::WriteTrimmedPack(const std::filesystem::path& temp_path,
+                                           std::span<const u8> pack_data, const EntryMap& current,
+                                           u64 size_limit) -> std::optional<TrimmedPack> {
+    std::vector<std::pair<DecodedTextureKey, Entry>> sorted(current.begin(), current.end());
+    std::ranges::sort(sorted, [](const auto& lhs, const auto& rhs) {
+        return lhs.second.last_used > rhs.second.last_used;
+    });
+
+    Common::FS::IOFile temp{temp_path, Common::FS::FileAccessMode::Write};
+    const PackHeader header{PACK_MAGIC, PACK_VERSION};
+    if (!temp.IsOpen() || !temp.WriteObject(header)) {
+        LOG_ERROR(HW_GPU, "Failed to create the trimmed decoded texture pack");
+        return std::nullopt;
+    }
+
+    const u64 target = size_limit / TRIM_TARGET_DENOMINATOR * TRIM_TARGET_NUMERATOR;
+    TrimmedPack trimmed{{}, sizeof(PackHeader)};
+    for (const auto& [key, entry] : sorted) {
+        const u64 record_size = sizeof(RecordHeader) + entry.size;
+        if (trimmed.size + record_size > target) {
+            break;
+        }
+        if (entry.offset + entry.size > pack_data.size()) {
+            continue;
+        }
+        const RecordHeader record{
+            .magic = RECORD_MAGIC,
+            .size = entry.size,
+            .content = key.content,
+            .descriptor = key.descriptor,
+            .data_hash = entry.data_hash,
+        };
+        if (!temp.WriteObject(record) ||
+            temp.WriteSpan(pack_data.subspan(entry.offset, entry.size)) != entry.size) {
+            LOG_ERROR(HW_GPU, "Failed to write the trimmed decoded texture pack");
+            temp.Close();
+            static_cast<void>(Common::FS::RemoveFile(temp_path));
+            return std::nullopt;
+        }
+        trimmed.entries.emplace(key, Entry{trimmed.size + sizeof(RecordHeader), entry.size,
+                                           entry.data_hash, entry.last_used});
+        trimmed.size += record_size;
+    }
+    return trimmed;
+}
+
+void DecodedTextureCache::ReplacePack(const std::filesystem::path& pack_path,
+                                      const std::filesystem::path& temp_path, TrimmedPack trimmed) {
+    reader.Close();
+    mapping.Unmap();
+    if (!Common::FS::RemoveFile(pack_path) || !Common::FS::RenameFile(temp_path, pack_path)) {
+        LOG_ERROR(HW_GPU, "Failed to replace the decoded texture pack");
+        entries.clear();
+        static_cast<void>(CreatePack(pack_path));
+        pack_size = sizeof(PackHeader);
+        lru_changed = true;
+        return;
+    }
+
+    // Uses recorded by Load while the pack was rewritten are kept, and entries it dropped for
+    // failing verification stay dropped
+    for (auto it = trimmed.entries.begin(); it != trimmed.entries.end();) {
+        const auto current = entries.find(it->first);
+        if (current == entries.end()) {
+            it = trimmed.entries.erase(it);
+            continue;
+        }
+        it->second.last_used = current->second.last_used;
+        ++it;
+    }
+
+    LOG_INFO(HW_GPU, "Trimmed the decoded texture pack from {} to {} MiB", pack_size / 1_MiB,
+             trimmed.size / 1_MiB);
+    entries = std::move(trimmed.entries);
+    pack_size = trimmed.size;
+    lru_changed = true;
+    mapping = Common::FS::FileMapping{pack_path};
+}
+
+void DecodedTextureCache::SaveLru() {
+    Common::FS::IOFile lru_file{base_dir / "decoded.lru", Common::FS::FileAccessMode::Write};
+    if (!lru_file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to save the decoded texture usage");
+        return;
+    }
+
+    std::vector<LruRecord> records;
+    records.reserve(entries.size());
+    for (const auto& [key, entry] : entries) {
+        records.push_back(LruRecord{key.content, key.descriptor, entry.last_used});
+    }
+    const LruHeader header{LRU_MAGIC, PACK_VERSION, session};
+    if (!lru_file.WriteObject(header) ||
+        lru_file.WriteSpan(std::span<const LruRecord>(records)) != records.size()) {
+        LOG_ERROR(HW_GPU, "Failed to save the decoded texture usage");
+    }
+}
+
+void DecodedTextureCache::Append(const DecodedTextureKey& key, std::vector<u8> data) {
+    const u64 data_hash = HashData(data);
+
+    // The limit holds while the title runs too, a record that would cross it trims the pack
+    // first and one that cannot fit even then is not stored
+    const u64 size_limit = GetSizeLimit();
+    const u64 record_size = sizeof(RecordHeader) + data.size();
+    if (sizeof(PackHeader) + record_size > size_limit) {
+        return;
+    }
+
+    // Only this thread appends, so the end of the pack read here is where the record lands
+    u64 offset{};
+    {
+        std::scoped_lock lk{lock};
+        if (!is_open || entries.contains(key)) {
+            return;
+        }
+        offset = pack_size;
+    }
+    if (offset + record_size > size_limit) {
+        TrimOpenPack(size_limit);
+        std::scoped_lock lk{lock};
+        if (!is_open || pack_size + record_size > size_limit) {
+            return;
+        }
+        offset = pack_size;
+    }
+
+    // The record is written without the lock so that uploads are not held up by disk I/O. Load
+    // cannot see it until its entry is published below.
+    const RecordHeader record{
+        .magic = RECORD_MAGIC,
+        .size = static_cast<u32>(data.size()),
+        .content = key.content,
+        .descriptor = key.descriptor,
+        .data_hash = data_hash,
+    };
+    if (!pack.WriteObject(record) ||
+        pack.WriteSpan(std::span<const u8>(data)) != data.size() || !pack.Flush()) {
+        LOG_ERROR(HW_GPU, "Failed to append to the decoded texture pack");
+        // Later records are placed at the end of the pack, so a partial one must not stay in
+        // front of them. The handle is closed first so nothing it still buffers lands after the
+        // truncation.
+        const auto pack_path = base_dir / "decoded.bin";
+        pack.Close();
+        Common::FS::IOFile file{pack_path, Common::FS::FileAccessMode::ReadWrite};
+        const bool truncated = file.IsOpen() && file.SetSize(offset);
+        file.Close();
+
+        std::scoped_lock lk{lock};
+        if (!truncated) {
+            LOG_ERROR(HW_GPU, "Failed to truncate the decoded texture pack, closing it");
+            Close();
+            return;
+        }
+        OpenPack(pack_path);
+        return;
+    }
+
+    std::scoped_lock lk{lock};
+    entries.emplace(key, Entry{offset + sizeof(RecordHeader), record.size, data_hash, session});
+    pack_size = offset + record_size;
+    lru_changed = true;
+}
+
+} // namespace VideoCommon
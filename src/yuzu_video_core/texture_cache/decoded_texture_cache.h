@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "yuzu_common/common_types.h"
+#include "yuzu_common/fs/file.h"
+#include "yuzu_common/fs/file_mapping.h"
+#include "yuzu_common/thread_worker.h"
+
+namespace VideoCommon {
+
+struct DecodedTextureKey {
+    u128 content{};
+    u64 descriptor{};
+
+    bool operator==(const DecodedTextureKey&) const = default;
+};
+
+struct DecodedTextureKeyHash {
+    size_t operator()(const DecodedTextureKey& key) const noexcept {
+        return static_cast<size_t>(key.content[0] ^ key.content[1] ^ key.descriptor);
+    }
+};
+
+/**
+ * A per title store of decoded ASTC and BCn texel data, addressed by a hash of the guest bytes and
+ * everything else the decoded result depends on. Entries are appended to a pack file that is
+ * mapped on open, and the least recently used entries are dropped whenever the pack would grow
+ * past its size limit.
+ */
+class DecodedTextureCache {
+public:
+    DecodedTextureCache();
+    ~DecodedTextureCache();
+
+    DecodedTextureCache(const DecodedTextureCache&) = delete;
+    DecodedTextureCache& operator=(const DecodedTextureCache&) = delete;
+
+    /**
+     * Opens the pack of the given title, does nothing if it is already open or caching is off.
+     * A channel that GPU::InitChannel has not set up has a program_id of 0 and uses the title the
+     * frontend booted, from Settings::values.disk_texture_cache_title_id.
+     */
+    void Open(u64 program_id);
+
+    /// Returns true if a pack is open, keys are not worth hashing otherwise.
+    [[nodiscard]] bool IsOpen();
+
+    /// Makes the key for a level of guest data, descriptor covers format, size and decode mode.
+    [[nodiscard]] static DecodedTextureKey MakeKey(std::span<const u8> input, u64 descriptor);
+
+    /// Copies the decoded data for key into output, returns false if it is not cached.
+    [[nodiscard]] bool Load(const DecodedTextureKey& key, std::span<u8> output);
+
+    /// Queues decoded data to be added to the pack.
+    void Store(const DecodedTextureKey& key, std::span<const u8> data);
+
+private:
+    struct Entry {
+        u64 offset;
+        u32 size;
+        u64 data_hash;
+        u64 last_used;
+    };
+    using EntryMap = std::unordered_map<DecodedTextureKey, Entry, DecodedTextureKeyHash>;
+
+    struct TrimmedPack {
+        EntryMap entries;
+        u64 size;
+    };
+
+    void Close();
+    bool OpenPack(const std::filesystem::path& pack_path);
+    void TrimOpenPack(u64 size_limit);
+    void LoadIndex(const std::filesystem::path& pack_path, const std::filesystem::path& lru_path);
+    void Trim(const std::filesystem::path& pack_path, u64 size_limit);
+    static std::optional<TrimmedPack> WriteTrimmedPack(const std::filesystem::path& temp_path,
+                                                       std::span<const u8> pack_data,
+                                                       const EntryMap& current, u64 size_limit);
+    void ReplacePack(const std::filesystem::path& pack_path,
+                     const std::filesystem::path& temp_path, TrimmedPack trimmed);
+    void SaveLru();
+    void Append(const DecodedTextureKey& key, std::vector<u8> data);
+
+    std::mutex lock;
+    u64 program_id{};
+    bool is_open{};
+    std::filesystem::path base_dir;
+
+    // The mapping, the reader and the index are shared with Load and guarded by lock. The append
+    // handle is only used by the writer thread, which writes records without holding the lock.
+    Common::FS::FileMapping mapping;
+    Common::FS::IOFile reader;
+    Common::FS::IOFile pack;
+    u64 pack_size{};
+    u64 session{};
+    bool lru_changed{};
+    EntryMap entries;
+
+    // Only started by the first Open that finds caching on, so it costs nothing when it is off
+    std::optional<Common::ThreadWorker> writer;
+};
+
+} // namespace VideoCommon
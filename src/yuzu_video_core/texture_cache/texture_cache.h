@@ -1090,7 +1090,9 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        decoded_texture_cache.Open(program_id);
+        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies,
+                     &decoded_texture_cache);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1295,13 +1297,14 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     auto copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
                                  local_unswizzle_data_buffer);
     const size_t out_size = MapSizeBytes(image);
+    decoded_texture_cache.Open(program_id);
 
     auto func = [out_size, copies, info = image.info,
-                 input = std::move(local_unswizzle_data_buffer),
-                 async_decode = decode_ptr]() mutable {
+                 input = std::move(local_unswizzle_data_buffer), async_decode = decode_ptr,
+                 decoded_cache = &decoded_texture_cache]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        ConvertImage(input, info, async_decode->decoded_data, copies_span, decoded_cache);
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
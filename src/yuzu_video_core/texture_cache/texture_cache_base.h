@@ -28,6 +28,7 @@
 #include "yuzu_video_core/delayed_destruction_ring.h"
 #include "yuzu_video_core/engines/fermi_2d.h"
 #include "yuzu_video_core/surface.h"
+#include "yuzu_video_core/texture_cache/decoded_texture_cache.h"
 #include "yuzu_video_core/texture_cache/descriptor_table.h"
 #include "yuzu_video_core/texture_cache/image_base.h"
 #include "yuzu_video_core/texture_cache/image_info.h"
@@ -489,6 +490,8 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    // Declared before the decode worker, queued decodes may still store into it while it drains
+    DecodedTextureCache decoded_texture_cache;
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
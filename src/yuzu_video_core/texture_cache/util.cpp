@@ -16,6 +16,7 @@
 #include "yuzu_common/alignment.h"
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/bit_util.h"
+#include "yuzu_common/cityhash.h"
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/div_ceil.h"
 #include "yuzu_common/scratch_buffer.h"
@@ -26,6 +27,7 @@
 #include "yuzu_video_core/memory_manager.h"
 #include "yuzu_video_core/surface.h"
 #include "yuzu_video_core/texture_cache/decode_bc.h"
+#include "yuzu_video_core/texture_cache/decoded_texture_cache.h"
 #include "yuzu_video_core/texture_cache/format_lookup_table.h"
 #include "yuzu_video_core/texture_cache/formatter.h"
 #include "yuzu_video_core/texture_cache/samples_helper.h"
@@ -566,6 +568,37 @@ void SwizzleBlockLinearImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr
     ASSERT(host_offset - copy.buffer_offset == copy.buffer_size);
 }
 
+[[nodiscard]] u32 DecodedLevelSize(PixelFormat format, const BufferImageCopy& copy,
+                                   Settings::AstcRecompression recompression) {
+    const u32 num_slices = copy.image_subresource.num_layers * copy.image_extent.depth;
+    if (!IsPixelFormatASTC(format)) {
+        return copy.image_extent.width * copy.image_extent.height * num_slices *
+               ConvertedBytesPerBlock(format);
+    }
+    if (recompression == Settings::AstcRecompression::Uncompressed) {
+        return copy.image_extent.width * copy.image_extent.height * num_slices *
+               BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
+    }
+    const u32 aligned_plane_dim =
+        Common::AlignUp(copy.image_extent.width, 4) * Common::AlignUp(copy.image_extent.height, 4);
+    const u32 bpp_div = recompression == Settings::AstcRecompression::Bc1 ? 2 : 1;
+    return aligned_plane_dim * num_slices / bpp_div;
+}
+
+[[nodiscard]] u64 DecodedLevelDescriptor(PixelFormat format, const BufferImageCopy& copy,
+                                         Settings::AstcRecompression recompression) {
+    // BCn output does not depend on the ASTC recompression mode
+    const u32 mode = IsPixelFormatASTC(format) ? static_cast<u32>(recompression) + 1 : 0;
+    const std::array<u32, 5> fields{
+        static_cast<u32>(format),
+        copy.image_extent.width,
+        copy.image_extent.height,
+        copy.image_subresource.num_layers * copy.image_extent.depth,
+        mode,
+    };
+    return Common::CityHash64(reinterpret_cast<const char*>(fields.data()), sizeof(fields));
+}
+
 } // Anonymous namespace
 
 u32 CalculateGuestSizeInBytes(const ImageInfo& info) noexcept {
@@ -911,10 +944,15 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
 }
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+                  std::span<BufferImageCopy> copies, DecodedTextureCache* decoded_texture_cache) {
     u32 output_offset = 0;
     Common::ScratchBuffer<u8> decode_scratch;
 
+    // Hashing every level is only worth it when there is a pack to look the keys up in
+    if (decoded_texture_cache != nullptr && !decoded_texture_cache->IsOpen()) {
+        decoded_texture_cache = nullptr;
+    }
+
     const Extent2D tile_size = DefaultBlockSize(info.format);
     for (BufferImageCopy& copy : copies) {
         const u32 level = copy.image_subresource.base_level;
@@ -931,11 +969,25 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         const auto recompression_setting = Settings::values.astc_recompression.GetValue();
         const bool astc = IsPixelFormatASTC(info.format);
 
+        const u32 level_offset = output_offset;
+        const u32 decoded_size = DecodedLevelSize(info.format, copy, recompression_setting);
+        std::optional<DecodedTextureKey> cache_key;
+        bool cached = false;
+        if (decoded_texture_cache) {
+            cache_key = DecodedTextureCache::MakeKey(
+                input_offset.first(copy.buffer_size),
+                DecodedLevelDescriptor(info.format, copy, recompression_setting));
+            cached = decoded_texture_cache->Load(*cache_key,
+                                                 output.subspan(level_offset, decoded_size));
+        }
+
         if (astc && recompression_setting == Settings::AstcRecompression::Uncompressed) {
-            Tegra::Texture::ASTC::Decompress(
-                input_offset, copy.image_extent.width, copy.image_extent.height,
-                copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, output.subspan(output_offset));
+            if (!cached) {
+                Tegra::Texture::ASTC::Decompress(
+                    input_offset, copy.image_extent.width, copy.image_extent.height,
+                    copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
+                    tile_size.height, output.subspan(output_offset));
+            }
 
             output_offset += copy.image_extent.width * copy.image_extent.height *
                              copy.image_subresource.num_layers *
@@ -946,37 +998,39 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
             const auto compress = recompression_setting == Settings::AstcRecompression::Bc1
                                       ? Tegra::Texture::BCN::CompressBC1
                                       : Tegra::Texture::BCN::CompressBC3;
-            const auto bpp_div = recompression_setting == Settings::AstcRecompression::Bc1 ? 2 : 1;
 
-            const u32 plane_dim = copy.image_extent.width * copy.image_extent.height;
-            const u32 level_size = plane_dim * copy.image_extent.depth *
-                                   copy.image_subresource.num_layers *
-                                   BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
-            decode_scratch.resize_destructive(level_size);
-
-            Tegra::Texture::ASTC::Decompress(
-                input_offset, copy.image_extent.width, copy.image_extent.height,
-                copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, decode_scratch);
-
-            compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
-                     copy.image_subresource.num_layers * copy.image_extent.depth,
-                     output.subspan(output_offset));
-
-            const u32 aligned_plane_dim = Common::AlignUp(copy.image_extent.width, 4) *
-                                          Common::AlignUp(copy.image_extent.height, 4);
+            if (!cached) {
+                const u32 plane_dim = copy.image_extent.width * copy.image_extent.height;
+                const u32 level_size = plane_dim * copy.image_extent.depth *
+                                       copy.image_subresource.num_layers *
+                                       BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
+                decode_scratch.resize_destructive(level_size);
+
+                Tegra::Texture::ASTC::Decompress(
+                    input_offset, copy.image_extent.width, copy.image_extent.height,
+                    copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
+                    tile_size.height, decode_scratch);
+
+                compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
+                         copy.image_subresource.num_layers * copy.image_extent.depth,
+                         output.subspan(output_offset));
+            }
 
-            copy.buffer_size =
-                (aligned_plane_dim * copy.image_extent.depth * copy.image_subresource.num_layers) /
-                bpp_div;
+            copy.buffer_size = decoded_size;
             output_offset += static_cast<u32>(copy.buffer_size);
         } else {
-            DecompressBCn(input_offset, output.subspan(output_offset), copy, info.format);
+            if (!cached) {
+                DecompressBCn(input_offset, output.subspan(output_offset), copy, info.format);
+            }
             output_offset += copy.image_extent.width * copy.image_extent.height *
                              copy.image_subresource.num_layers *
                              ConvertedBytesPerBlock(info.format);
         }
 
+        if (cache_key && !cached) {
+            decoded_texture_cache->Store(*cache_key, output.subspan(level_offset, decoded_size));
+        }
+
         copy.buffer_row_length = mip_size.width;
         copy.buffer_image_height = mip_size.height;
     }
@@ -17,6 +17,8 @@
 
 namespace VideoCommon {
 
+class DecodedTextureCache;
+
 using Tegra::Texture::TICEntry;
 
 using LevelArray = std::array<u32, MAX_MIP_LEVELS>;
@@ -67,7 +69,8 @@ struct OverlapResult {
     std::span<const u8> input, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies,
+                  DecodedTextureCache* decoded_texture_cache = nullptr);
 
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
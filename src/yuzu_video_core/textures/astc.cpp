@@ -5,18 +5,33 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <vector>
 
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define ASTC_X64
+#ifdef _MSC_VER
+#define ASTC_TARGET_SSE41
+#define ASTC_TARGET_AVX2
+#else
+#define ASTC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define ASTC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 #include <boost/container/static_vector.hpp>
 
 #include "yuzu_common/alignment.h"
 #include "yuzu_common/common_types.h"
 #include "yuzu_common/polyfill_ranges.h"
 #include "yuzu_video_core/textures/astc.h"
+#include "yuzu_video_core/textures/host_simd.h"
 #include "yuzu_video_core/textures/workers.h"
 
 class InputBitStream {
@@ -118,16 +133,16 @@ private:
 template <typename IntType>
 class Bits {
 public:
-    explicit Bits(const IntType& v) : m_Bits(v) {}
+    constexpr explicit Bits(const IntType& v) : m_Bits(v) {}
 
     Bits(const Bits&) = delete;
     Bits& operator=(const Bits&) = delete;
 
-    u8 operator[](u32 bitPos) const {
+    constexpr u8 operator[](u32 bitPos) const {
         return static_cast<u8>((m_Bits >> bitPos) & 1);
     }
 
-    IntType operator()(u32 start, u32 end) const {
+    constexpr IntType operator()(u32 start, u32 end) const {
         if (start == end) {
             return (*this)[start];
         } else if (start > end) {
@@ -157,7 +172,7 @@ struct IntegerEncodedValue {
     }
 
     // Returns the number of bits required to encode num_vals values.
-    u32 GetBitLength(u32 num_vals) const {
+    constexpr u32 GetBitLength(u32 num_vals) const {
         u32 total_bits = num_bits * num_vals;
         if (encoding == IntegerEncoding::Trit) {
             total_bits += (num_vals * 8 + 4) / 5;
@@ -221,25 +236,9 @@ using IntegerEncodedVector = boost::container::static_vector<
         boost::container::inplace_alignment<alignof(IntegerEncodedValue)>,
         boost::container::throw_on_overflow<false>>::type>;
 
-static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result, u32 nBitsPerValue) {
-    // Implement the algorithm in section C.2.12
-    std::array<u32, 5> m;
-    std::array<u32, 5> t;
-    u32 T;
-
-    // Read the trit encoded block according to
-    // table C.2.14
-    m[0] = bits.ReadBits(nBitsPerValue);
-    T = bits.ReadBits<2>();
-    m[1] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBits<2>() << 2;
-    m[2] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBit() << 4;
-    m[3] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBits<2>() << 5;
-    m[4] = bits.ReadBits(nBitsPerValue);
-    T |= bits.ReadBit() << 7;
-
+// Trits of a trit block from its eight interleaved T bits, as in section C.2.12
+static constexpr std::array<u8, 5> DecodeTrits(u32 T) {
+    std::array<u32, 5> t{};
     u32 C = 0;
 
     Bits<u32> Tb(T);
@@ -272,28 +271,13 @@ static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result,
         t[0] = (Cb[1] << 1) | (Cb[0] & ~Cb[1]);
     }
 
-    for (std::size_t i = 0; i < 5; ++i) {
-        IntegerEncodedValue& val = result.emplace_back(IntegerEncoding::Trit, nBitsPerValue);
-        val.bit_value = m[i];
-        val.trit_value = t[i];
-    }
+    return {static_cast<u8>(t[0]), static_cast<u8>(t[1]), static_cast<u8>(t[2]),
+            static_cast<u8>(t[3]), static_cast<u8>(t[4])};
 }
 
-static void DecodeQuintBlock(InputBitStream& bits, IntegerEncodedVector& result,
-                             u32 nBitsPerValue) {
-    // Implement the algorithm in section C.2.12
-    u32 m[3];
-    u32 q[3];
-    u32 Q;
-
-    // Read the trit encoded block according to
-    // table C.2.15
-    m[0] = bits.ReadBits(nBitsPerValue);
-    Q = bits.ReadBits<3>();
-    m[1] = bits.ReadBits(nBitsPerValue);
-    Q |= bits.ReadBits<2>() << 3;
-    m[2] = bits.ReadBits(nBitsPerValue);
-    Q |= bits.ReadBits<2>() << 5;
+// Quints of a quint block from its seven interleaved Q bits, as in section C.2.12
+static constexpr std::array<u8, 3> DecodeQuints(u32 Q) {
+    std::array<u32, 3> q{};
 
     Bits<u32> Qb(Q);
     if (Qb(1, 2) == 3 && Qb(5, 6) == 0) {
@@ -319,6 +303,67 @@ static void DecodeQuintBlock(InputBitStream& bits, IntegerEncodedVector& result,
         }
     }
 
+    return {static_cast<u8>(q[0]), static_cast<u8>(q[1]), static_cast<u8>(q[2])};
+}
+
+static constexpr auto TRIT_DECODE_TABLE = [] {
+    std::array<std::array<u8, 5>, 256> table{};
+    for (u32 T = 0; T < table.size(); ++T) {
+        table[T] = DecodeTrits(T);
+    }
+    return table;
+}();
+
+static constexpr auto QUINT_DECODE_TABLE = [] {
+    std::array<std::array<u8, 3>, 128> table{};
+    for (u32 Q = 0; Q < table.size(); ++Q) {
+        table[Q] = DecodeQuints(Q);
+    }
+    return table;
+}();
+
+static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result, u32 nBitsPerValue) {
+    // Implement the algorithm in section C.2.12
+    std::array<u32, 5> m;
+    u32 T;
+
+    // Read the trit encoded block according to
+    // table C.2.14
+    m[0] = bits.ReadBits(nBitsPerValue);
+    T = bits.ReadBits<2>();
+    m[1] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<2>() << 2;
+    m[2] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBit() << 4;
+    m[3] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBits<2>() << 5;
+    m[4] = bits.ReadBits(nBitsPerValue);
+    T |= bits.ReadBit() << 7;
+
+    const std::array<u8, 5>& t = TRIT_DECODE_TABLE[T];
+    for (std::size_t i = 0; i < 5; ++i) {
+        IntegerEncodedValue& val = result.emplace_back(IntegerEncoding::Trit, nBitsPerValue);
+        val.bit_value = m[i];
+        val.trit_value = t[i];
+    }
+}
+
+static void DecodeQuintBlock(InputBitStream& bits, IntegerEncodedVector& result,
+                             u32 nBitsPerValue) {
+    // Implement the algorithm in section C.2.12
+    u32 m[3];
+    u32 Q;
+
+    // Read the trit encoded block according to
+    // table C.2.15
+    m[0] = bits.ReadBits(nBitsPerValue);
+    Q = bits.ReadBits<3>();
+    m[1] = bits.ReadBits(nBitsPerValue);
+    Q |= bits.ReadBits<2>() << 3;
+    m[2] = bits.ReadBits(nBitsPerValue);
+    Q |= bits.ReadBits<2>() << 5;
+
+    const std::array<u8, 3>& q = QUINT_DECODE_TABLE[Q];
     for (std::size_t i = 0; i < 3; ++i) {
         IntegerEncodedValue& val = result.emplace_back(IntegerEncoding::Quint, nBitsPerValue);
         val.bit_value = m[i];
@@ -385,12 +430,11 @@ struct TexelWeightParams {
     }
 };
 
-static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
+// Decodes the eleven block mode bits. For void extent blocks the caller still has to check the
+// bit that follows them.
+static TexelWeightParams DecodeBlockMode(u16 modeBits) {
     TexelWeightParams params;
 
-    // Read the entire block mode all at once
-    u16 modeBits = static_cast<u16>(strm.ReadBits<11>());
-
     // Does this match the void extent block mode?
     if ((modeBits & 0x01FF) == 0x1FC) {
         if (modeBits & 0x200) {
@@ -400,7 +444,7 @@ static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
         }
 
         // Next two bits must be one.
-        if (!(modeBits & 0x400) || !strm.ReadBit()) {
+        if (!(modeBits & 0x400)) {
             params.m_bError = true;
         }
 
@@ -584,6 +628,18 @@ static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
     return params;
 }
 
+static TexelWeightParams DecodeBlockInfo(InputBitStream& strm) {
+    // Read the entire block mode all at once
+    TexelWeightParams params = DecodeBlockMode(static_cast<u16>(strm.ReadBits<11>()));
+
+    // The second of the two bits of a void extent that must be one follows the block mode
+    if ((params.m_bVoidExtentLDR || params.m_bVoidExtentHDR) && !params.m_bError &&
+        !strm.ReadBit()) {
+        params.m_bError = true;
+    }
+    return params;
+}
+
 // Replicates low num_bits such that [(to_bit - 1):(to_bit - 1 - from_bit)]
 // is the same as [(num_bits - 1):0] and repeats all the way down.
 template <typename IntType>
@@ -815,21 +871,13 @@ public:
     }
 };
 
-static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, const u32 nPartitions,
-                              const u32 nBitsForColorData) {
-    // First figure out how many color values we have
-    u32 nValues = 0;
-    for (u32 i = 0; i < nPartitions; i++) {
-        nValues += ((modes[i] >> 2) + 1) << 1;
-    }
-
-    // Then based on the number of values and the remaining number of bits,
-    // figure out the max value for each of them...
+// Picks the largest range whose encoding of nValues color values fits in nBits
+static u32 SelectColorRange(u32 nValues, u32 nBits) {
     u32 range = 256;
     while (--range > 0) {
         IntegerEncodedValue val = ASTC_ENCODINGS_VALUES[range];
         u32 bitLength = val.GetBitLength(nValues);
-        if (bitLength <= nBitsForColorData) {
+        if (bitLength <= nBits) {
             // Find the smallest possible range that matches the given encoding
             while (--range > 0) {
                 IntegerEncodedValue newval = ASTC_ENCODINGS_VALUES[range];
@@ -843,6 +891,20 @@ static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, co
             break;
         }
     }
+    return range;
+}
+
+static void DecodeColorValues(u32* out, std::span<u8> data, const u32* modes, const u32 nPartitions,
+                              const u32 nBitsForColorData) {
+    // First figure out how many color values we have
+    u32 nValues = 0;
+    for (u32 i = 0; i < nPartitions; i++) {
+        nValues += ((modes[i] >> 2) + 1) << 1;
+    }
+
+    // Then based on the number of values and the remaining number of bits,
+    // figure out the max value for each of them...
+    const u32 range = SelectColorRange(nValues, nBitsForColorData);
 
     // We now have enough to decode our integer sequence.
     IntegerEncodedVector decodedColorValues;
@@ -1075,11 +1137,94 @@ static u32 UnquantizeTexelWeight(const IntegerEncodedValue& val) {
     return result;
 }
 
+// Blocks are at most 12x12 texels, the batched kernels round the texel count up to 32 texels
+static constexpr u32 kMaxTexels = 12 * 12;
+static constexpr u32 kPaddedTexels = 160;
+
+// Bilinear taps of every texel into the weight grid, stored by tap so that SIMD kernels load the
+// same tap of consecutive texels. Taps outside of the grid read the first grid weight with a tap
+// weight of zero.
+struct WeightInfillTable {
+    u32 blockWidth = 0;
+    u32 blockHeight = 0;
+    u32 gridWidth = 0;
+    u32 gridHeight = 0;
+    std::array<std::array<u8, kPaddedTexels>, 4> indices{};
+    // Tap weights of each texel in pairs, {w00, w01} in the first array and {w10, w11} in the
+    // second, the operand layout of a multiply and add of adjacent bytes
+    std::array<std::array<u8, kPaddedTexels * 2>, 2> weights{};
+};
+
+// The bilinear infill (Section C.2.18) only depends on the block footprint and the weight grid
+// size, so the taps are computed once per combination. Encoders pick the grid size of every block
+// out of dozens, which a handful of cached tables would keep rebuilding, so each worker thread
+// keeps one table per grid size instead. Grids are 2 to 12 weights wide and high; a table is
+// 1.3 KiB and only allocated once its grid size comes up, 157 KiB per thread at most. All blocks
+// of a texture share the footprint, so tables are only rebuilt when it changes.
+static const WeightInfillTable& GetWeightInfillTable(u32 blockWidth, u32 blockHeight,
+                                                     u32 gridWidth, u32 gridHeight) {
+    thread_local std::array<std::unique_ptr<WeightInfillTable>, 11 * 11> tables;
+
+    auto& entry = tables[(gridHeight - 2) * 11 + (gridWidth - 2)];
+    if (!entry) {
+        entry = std::make_unique<WeightInfillTable>();
+    }
+    auto& table = *entry;
+    if (table.blockWidth == blockWidth && table.blockHeight == blockHeight &&
+        table.gridWidth == gridWidth && table.gridHeight == gridHeight) {
+        return table;
+    }
+
+    table = {};
+    table.blockWidth = blockWidth;
+    table.blockHeight = blockHeight;
+    table.gridWidth = gridWidth;
+    table.gridHeight = gridHeight;
+
+    const u32 Ds = (1024 + (blockWidth / 2)) / (blockWidth - 1);
+    const u32 Dt = (1024 + (blockHeight / 2)) / (blockHeight - 1);
+    const u32 gridSize = gridWidth * gridHeight;
+
+    for (u32 t = 0; t < blockHeight; t++) {
+        for (u32 s = 0; s < blockWidth; s++) {
+            const u32 cs = Ds * s;
+            const u32 ct = Dt * t;
+
+            const u32 gs = (cs * (gridWidth - 1) + 32) >> 6;
+            const u32 gt = (ct * (gridHeight - 1) + 32) >> 6;
+
+            const u32 js = gs >> 4;
+            const u32 fs = gs & 0xF;
+
+            const u32 jt = gt >> 4;
+            const u32 ft = gt & 0x0F;
+
+            const u32 w11 = (fs * ft + 8) >> 4;
+            const u32 w10 = ft - w11;
+            const u32 w01 = fs - w11;
+            const u32 w00 = 16 - fs - ft + w11;
+
+            const u32 v0 = js + jt * gridWidth;
+            const std::array<u32, 4> taps{v0, v0 + 1, v0 + gridWidth, v0 + gridWidth + 1};
+            const std::array<u32, 4> tapWeights{w00, w01, w10, w11};
+
+            const u32 texel = t * blockWidth + s;
+            for (u32 i = 0; i < 4; i++) {
+                const bool inside = taps[i] < gridSize;
+                table.indices[i][texel] = static_cast<u8>(inside ? taps[i] : 0);
+                table.weights[i / 2][texel * 2 + i % 2] =
+                    static_cast<u8>(inside ? tapWeights[i] : 0);
+            }
+        }
+    }
+    return table;
+}
+
 static void UnquantizeTexelWeights(u32 out[2][144], const IntegerEncodedVector& weights,
                                    const TexelWeightParams& params, const u32 blockWidth,
                                    const u32 blockHeight) {
     u32 weightIdx = 0;
-    u32 unquantized[2][144];
+    u32 unquantized[2][kMaxTexels];
 
     for (auto itr = weights.begin(); itr != weights.end(); ++itr) {
         unquantized[0][weightIdx] = UnquantizeTexelWeight(*itr);
@@ -1097,50 +1242,22 @@ static void UnquantizeTexelWeights(u32 out[2][144], const IntegerEncodedVector&
     }
 
     // Do infill if necessary (Section C.2.18) ...
-    u32 Ds = (1024 + (blockWidth / 2)) / (blockWidth - 1);
-    u32 Dt = (1024 + (blockHeight / 2)) / (blockHeight - 1);
+    const WeightInfillTable& infill =
+        GetWeightInfillTable(blockWidth, blockHeight, params.m_Width, params.m_Height);
 
     const u32 kPlaneScale = params.m_bDualPlane ? 2U : 1U;
-    for (u32 plane = 0; plane < kPlaneScale; plane++)
-        for (u32 t = 0; t < blockHeight; t++)
-            for (u32 s = 0; s < blockWidth; s++) {
-                u32 cs = Ds * s;
-                u32 ct = Dt * t;
-
-                u32 gs = (cs * (params.m_Width - 1) + 32) >> 6;
-                u32 gt = (ct * (params.m_Height - 1) + 32) >> 6;
-
-                u32 js = gs >> 4;
-                u32 fs = gs & 0xF;
-
-                u32 jt = gt >> 4;
-                u32 ft = gt & 0x0F;
-
-                u32 w11 = (fs * ft + 8) >> 4;
-                u32 w10 = ft - w11;
-                u32 w01 = fs - w11;
-                u32 w00 = 16 - fs - ft + w11;
-
-                u32 v0 = js + jt * params.m_Width;
-
-#define FIND_TEXEL(tidx, bidx)                                                                     \
-    u32 p##bidx = 0;                                                                               \
-    do {                                                                                           \
-        if ((tidx) < (params.m_Width * params.m_Height)) {                                         \
-            p##bidx = unquantized[plane][(tidx)];                                                  \
-        }                                                                                          \
-    } while (0)
-
-                FIND_TEXEL(v0, 00);
-                FIND_TEXEL(v0 + 1, 01);
-                FIND_TEXEL(v0 + params.m_Width, 10);
-                FIND_TEXEL(v0 + params.m_Width + 1, 11);
-
-#undef FIND_TEXEL
-
-                out[plane][t * blockWidth + s] =
-                    (p00 * w00 + p01 * w01 + p10 * w10 + p11 * w11 + 8) >> 4;
-            }
+    const u32 numTexels = blockWidth * blockHeight;
+    for (u32 plane = 0; plane < kPlaneScale; plane++) {
+        const u32* const planeWeights = unquantized[plane];
+        for (u32 i = 0; i < numTexels; i++) {
+            out[plane][i] = (planeWeights[infill.indices[0][i]] * infill.weights[0][i * 2] +
+                             planeWeights[infill.indices[1][i]] * infill.weights[0][i * 2 + 1] +
+                             planeWeights[infill.indices[2][i]] * infill.weights[1][i * 2] +
+                             planeWeights[infill.indices[3][i]] * infill.weights[1][i * 2 + 1] +
+                             8) >>
+                            4;
+        }
+    }
 }
 
 // Transfers a bit as described in C.2.14
@@ -1419,6 +1536,29 @@ static void FillError(std::span<u32> outBuf, u32 blockWidth, u32 blockHeight) {
     }
 }
 
+// Interpolates between two endpoints expanded to 16 bits and converts back to 8 bits. The integer
+// rounding is exactly round(255 * C / 65536), which maps 65535 to 255 as the spec requires.
+static constexpr u32 InterpolateChannel(u32 C0, u32 C1, u32 weight) {
+    const u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
+    return (C * 255 + 32768) >> 16;
+}
+
+// Endpoint components are stored as A, R, G, B, texels are packed as R8G8B8A8
+static constexpr std::array<u32, 4> kChannelShift{24, 0, 8, 16};
+
+using EndpointChannels = std::array<u32, 4>;
+
+static void InterpolateSinglePartition(const EndpointChannels& C0, const EndpointChannels& C1,
+                                       const u32* weights, u32 numTexels, u32* out) {
+    for (u32 i = 0; i < numTexels; i++) {
+        u32 texel = 0;
+        for (u32 c = 0; c < 4; c++) {
+            texel |= InterpolateChannel(C0[c], C1[c], weights[i]) << kChannelShift[c];
+        }
+        out[i] = texel;
+    }
+}
+
 static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
                             const u32 blockHeight, std::span<u32, 12 * 12> outBuf) {
     InputBitStream strm(inBuf);
@@ -1617,6 +1757,19 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
     u32 weights[2][144];
     UnquantizeTexelWeights(weights, texelWeightValues, weightParams, blockWidth, blockHeight);
 
+    // Single partition, single plane blocks are by far the most common, they need neither the
+    // partition selection nor the plane selection per texel.
+    if (nPartitions == 1 && !weightParams.m_bDualPlane) {
+        EndpointChannels C0;
+        EndpointChannels C1;
+        for (u32 c = 0; c < 4; c++) {
+            C0[c] = ReplicateByteTo16(endpoints[0][0].Component(c));
+            C1[c] = ReplicateByteTo16(endpoints[0][1].Component(c));
+        }
+        InterpolateSinglePartition(C0, C1, weights[0], blockWidth * blockHeight, outBuf.data());
+        return;
+    }
+
     // Now that we have endpoints and weights, we can interpolate and generate
     // the proper decoding...
     for (u32 j = 0; j < blockHeight; j++)
@@ -1638,23 +1791,722 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
                 }
 
                 u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+                p.Component(c) = static_cast<u16>(InterpolateChannel(C0, C1, weight));
             }
 
             outBuf[j * blockWidth + i] = p.Pack();
         }
 }
 
+// Single partition, single plane blocks with an LDR endpoint mode are by far the most common.
+// When the host has SSE4.1 they are decoded a batch at a time instead of one by one: the bit
+// level parse, the color and weight unquantization, the weight infill and the interpolation each
+// run over the whole batch before the next stage starts. Every other block, and every block on
+// hosts without SSE4.1, goes through DecompressBlock.
+static constexpr u32 kBatchSize = 8;
+
+// Endpoint modes of the LDR profile (Section C.2.14)
+static constexpr u32 kLdrEndpointModes = 0x3773;
+
+// Lane constants that unquantize one integer encoding with the same arithmetic for bits, trits
+// and quints (Sections C.2.13 and C.2.17). With x = bits & mask and B = (x * multiplier) >> shift,
+//   T = (B * bitScale + digit * digitScale) ^ A, with A = (bits & 1) ? sign : 0
+//   value = (A & top) | (T >> 2)
+// Plain bits scale B by four and have no sign, so the value is B, their bit replication. SSE has
+// no per lane shift, so the product is doubled and the shift is a high multiply by shiftScale,
+// 1 << (15 - shift).
+struct UnquantizeConstants {
+    u16 mask = 0;
+    u16 multiplier = 0;
+    u16 shiftScale = 0;
+    u16 bitScale = 0;
+    u16 digitScale = 0;
+    u16 sign = 0;
+    u16 top = 0;
+    // Trit and quint weights without bits are read from values by their digit instead
+    bool lookup = false;
+    std::array<u8, 16> values{};
+};
+
+static constexpr UnquantizeConstants MakeUnquantizeConstants(u32 range, bool weight) {
+    const IntegerEncodedValue encoding = ASTC_ENCODINGS_VALUES[range];
+    const u32 bits = encoding.num_bits;
+    UnquantizeConstants constants;
+
+    if (encoding.encoding == IntegerEncoding::JustBits) {
+        // The replication is the top bits of enough copies of the value side by side
+        const u32 targetBits = weight ? 6 : 8;
+        const u32 copies = (targetBits + bits - 1) / bits;
+        u32 multiplier = 0;
+        for (u32 i = 0; i < copies; i++) {
+            multiplier |= 1U << (i * bits);
+        }
+        constants.mask = static_cast<u16>((1U << bits) - 1);
+        constants.multiplier = static_cast<u16>(multiplier * 2);
+        constants.shiftScale = static_cast<u16>(1U << (15 - (copies * bits - targetBits)));
+        constants.bitScale = 4;
+        return constants;
+    }
+
+    const bool trit = encoding.encoding == IntegerEncoding::Trit;
+    if (bits == 0) {
+        if (weight) {
+            // Already changed from [0,63] to [0,64]
+            constants.lookup = true;
+            if (trit) {
+                constants.values = {0, 32, 64};
+            } else {
+                constants.values = {0, 16, 32, 48, 64};
+            }
+        }
+        return constants;
+    }
+
+    // The bit patterns of B as a multiply and shift of the bits above the lowest one
+    struct Pattern {
+        u16 multiplier;
+        u16 shift;
+        u16 C;
+    };
+    constexpr std::array<Pattern, 6> colorTrits{
+        {{0, 0, 204}, {0x116, 0, 93}, {0x85, 0, 44}, {0x41, 0, 22}, {0x81, 2, 11}, {0x101, 4, 5}}};
+    constexpr std::array<Pattern, 5> colorQuints{
+        {{0, 0, 113}, {0x10C, 0, 54}, {0x105, 1, 26}, {0x81, 1, 13}, {0x101, 3, 6}}};
+    constexpr std::array<Pattern, 3> weightTrits{{{0, 0, 50}, {0x45, 0, 23}, {0x21, 0, 11}}};
+    constexpr std::array<Pattern, 2> weightQuints{{{0, 0, 28}, {0x42, 0, 13}}};
+
+    Pattern pattern{};
+    if (weight) {
+        pattern = trit ? weightTrits[bits - 1] : weightQuints[bits - 1];
+    } else {
+        pattern = trit ? colorTrits[bits - 1] : colorQuints[bits - 1];
+    }
+    constants.mask = static_cast<u16>(((1U << (bits - 1)) - 1) << 1);
+    constants.multiplier = pattern.multiplier;
+    constants.shiftScale = static_cast<u16>(1U << (15 - pattern.shift));
+    constants.bitScale = 1;
+    constants.digitScale = pattern.C;
+    constants.sign = weight ? 0x7F : 0x1FF;
+    constants.top = weight ? 0x20 : 0x80;
+    return constants;
+}
+
+static constexpr auto COLOR_UNQUANTIZE_TABLE = [] {
+    std::array<UnquantizeConstants, 256> table{};
+    for (u32 range = 1; range < table.size(); ++range) {
+        table[range] = MakeUnquantizeConstants(range, false);
+    }
+    return table;
+}();
+
+static constexpr auto WEIGHT_UNQUANTIZE_TABLE = [] {
+    std::array<UnquantizeConstants, 32> table{};
+    for (u32 range = 1; range < table.size(); ++range) {
+        table[range] = MakeUnquantizeConstants(range, true);
+    }
+    return table;
+}();
+
+// Color range of a single partition block for each endpoint mode class and color bit count
+static u32 GetSinglePartitionColorRange(u32 nValues, u32 nBits) {
+    static const auto table = [] {
+        std::array<std::array<u8, 128>, 4> ranges{};
+        for (u32 i = 0; i < ranges.size(); ++i) {
+            for (u32 bits = 0; bits < ranges[i].size(); ++bits) {
+                ranges[i][bits] = static_cast<u8>(SelectColorRange((i + 1) * 2, bits));
+            }
+        }
+        return ranges;
+    }();
+    return table[nValues / 2 - 1][nBits];
+}
+
+// Reads bits of a 128 bit value from the least significant one up, past the end reads zero
+class BlockBitReader {
+public:
+    constexpr explicit BlockBitReader(u64 low_, u64 high_) : low{low_}, high{high_} {}
+
+    constexpr u32 ReadBits(u32 nBits) {
+        u64 bits = 0;
+        if (position < 64) {
+            bits = low >> position;
+            if (position > 0) {
+                bits |= high << (64 - position);
+            }
+        } else if (position < 128) {
+            bits = high >> (position - 64);
+        }
+        position += nBits;
+        return static_cast<u32>(bits & ((u64{1} << nBits) - 1));
+    }
+
+private:
+    u64 low;
+    u64 high;
+    u32 position = 0;
+};
+
+static constexpr u64 ReverseBits(u64 value) {
+    value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+    value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    value = ((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+    value = ((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+    return (value >> 32) | (value << 32);
+}
+
+// Keeps the lowest nBits of a 128 bit value
+static constexpr void MaskBits(u64& low, u64& high, u32 nBits) {
+    if (nBits < 64) {
+        low &= (u64{1} << nBits) - 1;
+        high = 0;
+    } else {
+        high &= (u64{1} << (nBits - 64)) - 1;
+    }
+}
+
+// Decodes an integer sequence into the trit or quint digit and the low bits of every value.
+// Trits and quints are decoded in whole blocks of five and three values.
+static void DecodeQuantizedSequence(BlockBitReader& reader, u32 range, u32 nValues, u8* digits,
+                                    u8* bits) {
+    const IntegerEncodedValue encoding = ASTC_ENCODINGS_VALUES[range];
+    const u32 n = encoding.num_bits;
+
+    switch (encoding.encoding) {
+    case IntegerEncoding::JustBits:
+        for (u32 i = 0; i < nValues; i++) {
+            digits[i] = 0;
+            bits[i] = static_cast<u8>(reader.ReadBits(n));
+        }
+        break;
+
+    case IntegerEncoding::Trit:
+        for (u32 i = 0; i < nValues; i += 5) {
+            bits[i] = static_cast<u8>(reader.ReadBits(n));
+            u32 T = reader.ReadBits(2);
+            bits[i + 1] = static_cast<u8>(reader.ReadBits(n));
+            T |= reader.ReadBits(2) << 2;
+            bits[i + 2] = static_cast<u8>(reader.ReadBits(n));
+            T |= reader.ReadBits(1) << 4;
+            bits[i + 3] = static_cast<u8>(reader.ReadBits(n));
+            T |= reader.ReadBits(2) << 5;
+            bits[i + 4] = static_cast<u8>(reader.ReadBits(n));
+            T |= reader.ReadBits(1) << 7;
+            std::memcpy(digits + i, TRIT_DECODE_TABLE[T].data(), 5);
+        }
+        break;
+
+    case IntegerEncoding::Quint:
+        for (u32 i = 0; i < nValues; i += 3) {
+            bits[i] = static_cast<u8>(reader.ReadBits(n));
+            u32 Q = reader.ReadBits(3);
+            bits[i + 1] = static_cast<u8>(reader.ReadBits(n));
+            Q |= reader.ReadBits(2) << 3;
+            bits[i + 2] = static_cast<u8>(reader.ReadBits(n));
+            Q |= reader.ReadBits(2) << 5;
+            std::memcpy(digits + i, QUINT_DECODE_TABLE[Q].data(), 3);
+        }
+        break;
+    }
+}
+
+struct BatchBlock {
+    u32 index = 0;
+    u32 colorEndpointMode = 0;
+    u32 gridWidth = 0;
+    u32 gridHeight = 0;
+    const UnquantizeConstants* colorConstants = nullptr;
+    const UnquantizeConstants* weightConstants = nullptr;
+    std::array<u8, 16> colorDigits{};
+    std::array<u8, 16> colorBits{};
+    std::array<u8, 16> colors{};
+    // At most 64 weights, decoded up to a whole trit block and read 16 at a time
+    std::array<u8, 80> weightDigits{};
+    std::array<u8, 80> weightBits{};
+    std::array<u8, 80> gridWeights{};
+    // Endpoints {e0, e1} of the R, G, B and A channels, for two texels
+    std::array<u8, 16> endpoints{};
+    std::array<u8, kPaddedTexels> weights{};
+};
+
+// Decodes the bit level of a block the batched path handles, returns false for any other block
+static bool ParseBatchBlock(std::span<const u8, 16> inBuf, u32 blockWidth, u32 blockHeight,
+                            BatchBlock& block) {
+    u64 low;
+    u64 high;
+    std::memcpy(&low, inBuf.data(), sizeof(low));
+    std::memcpy(&high, inBuf.data() + sizeof(low), sizeof(high));
+
+    const TexelWeightParams params = DecodeBlockMode(static_cast<u16>(low & 0x7FF));
+    if (params.m_bError || params.m_bVoidExtentLDR || params.m_bVoidExtentHDR ||
+        params.m_bDualPlane || params.m_Width > blockWidth || params.m_Height > blockHeight) {
+        return false;
+    }
+
+    const u32 colorEndpointMode = static_cast<u32>(low >> 13) & 0xF;
+    if (((low >> 11) & 3) != 0 || ((kLdrEndpointModes >> colorEndpointMode) & 1) == 0) {
+        return false;
+    }
+
+    // Only weight grids and color ranges the spec allows (Section C.2.24), the general path
+    // decides what to do with the others
+    const u32 nWeights = params.GetNumWeightValues();
+    const u32 nWeightBits = params.GetPackedBitSize();
+    if (nWeights > 64 || nWeightBits < 24 || nWeightBits > 96) {
+        return false;
+    }
+    const u32 nColorValues = ((colorEndpointMode >> 2) + 1) << 1;
+    const u32 nColorBits = 128 - 17 - nWeightBits;
+    const u32 colorRange = GetSinglePartitionColorRange(nColorValues, nColorBits);
+    if (colorRange < 5) {
+        return false;
+    }
+
+    block.colorEndpointMode = colorEndpointMode;
+    block.gridWidth = params.m_Width;
+    block.gridHeight = params.m_Height;
+    block.colorConstants = &COLOR_UNQUANTIZE_TABLE[colorRange];
+    block.weightConstants = &WEIGHT_UNQUANTIZE_TABLE[params.m_MaxWeight];
+
+    // Color endpoint data follows the block mode, the partition count and the endpoint mode
+    u64 colorLow = (low >> 17) | (high << 47);
+    u64 colorHigh = high >> 17;
+    MaskBits(colorLow, colorHigh, nColorBits);
+    BlockBitReader colorReader(colorLow, colorHigh);
+    DecodeQuantizedSequence(colorReader, colorRange, nColorValues, block.colorDigits.data(),
+                            block.colorBits.data());
+
+    // Weights are stored backwards from the end of the block
+    u64 weightLow = ReverseBits(high);
+    u64 weightHigh = ReverseBits(low);
+    MaskBits(weightLow, weightHigh, nWeightBits);
+    BlockBitReader weightReader(weightLow, weightHigh);
+    DecodeQuantizedSequence(weightReader, params.m_MaxWeight, nWeights, block.weightDigits.data(),
+                            block.weightBits.data());
+    return true;
+}
+
+// Texel bytes are R, G, B and A, Pixel components A, R, G and B
+static constexpr std::array<u32, 4> kTexelComponent{1, 2, 3, 0};
+
+static void ComputeEndpointPairs(BatchBlock& block) {
+    u32 colorValues[8];
+    for (u32 i = 0; i < 8; i++) {
+        colorValues[i] = block.colors[i];
+    }
+
+    Pixel ep1;
+    Pixel ep2;
+    const u32* colorValuesPtr = colorValues;
+    ComputeEndpoints(ep1, ep2, colorValuesPtr, block.colorEndpointMode);
+
+    for (u32 c = 0; c < 4; c++) {
+        const u8 e0 = static_cast<u8>(ep1.Component(kTexelComponent[c]));
+        const u8 e1 = static_cast<u8>(ep2.Component(kTexelComponent[c]));
+        block.endpoints[c * 2] = block.endpoints[8 + c * 2] = e0;
+        block.endpoints[c * 2 + 1] = block.endpoints[8 + c * 2 + 1] = e1;
+    }
+}
+
+// With 8 bit endpoints the channel interpolation of C0 = 257 * e0 and C1 = 257 * e1 only depends
+// on X = e0 * (64 - w) + e1 * w, and for every X up to 255 * 64 it equals
+// (X + 32 - (X >> 13)) >> 6, which fits in 16 bit lanes.
+static_assert([] {
+    for (u32 X = 0; X <= 255 * 64; X++) {
+        const u32 C = (257 * X + 32) / 64;
+        if (((C * 255 + 32768) >> 16) != ((X + 32 - (X >> 13)) >> 6)) {
+            return false;
+        }
+    }
+    return true;
+}());
+
+// {64 - w, w} pairs of texels 2j and 2j + 1 out of eight, each repeated for the four channels
+alignas(16) static constexpr std::array<std::array<u8, 16>, 4> kSpreadWeights{{
+    {0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3},
+    {4, 5, 4, 5, 4, 5, 4, 5, 6, 7, 6, 7, 6, 7, 6, 7},
+    {8, 9, 8, 9, 8, 9, 8, 9, 10, 11, 10, 11, 10, 11, 10, 11},
+    {12, 13, 12, 13, 12, 13, 12, 13, 14, 15, 14, 15, 14, 15, 14, 15},
+}};
+
+#ifdef ASTC_X64
+ASTC_TARGET_SSE41 static __m128i Broadcast16Sse41(u16 value) {
+    return _mm_set1_epi16(static_cast<s16>(value));
+}
+
+ASTC_TARGET_SSE41 static __m128i UnquantizeSse41(__m128i digits, __m128i bits,
+                                                 const UnquantizeConstants& k) {
+    const __m128i x = _mm_and_si128(bits, Broadcast16Sse41(k.mask));
+    const __m128i B = _mm_mulhi_epu16(_mm_mullo_epi16(x, Broadcast16Sse41(k.multiplier)),
+                                      Broadcast16Sse41(k.shiftScale));
+    const __m128i A =
+        _mm_mullo_epi16(_mm_and_si128(bits, _mm_set1_epi16(1)), Broadcast16Sse41(k.sign));
+    __m128i T = _mm_add_epi16(_mm_mullo_epi16(B, Broadcast16Sse41(k.bitScale)),
+                              _mm_mullo_epi16(digits, Broadcast16Sse41(k.digitScale)));
+    T = _mm_xor_si128(T, A);
+    return _mm_or_si128(_mm_and_si128(A, Broadcast16Sse41(k.top)), _mm_srli_epi16(T, 2));
+}
+
+ASTC_TARGET_SSE41 static void UnquantizeColorsSse41(std::span<BatchBlock> blocks) {
+    for (BatchBlock& block : blocks) {
+        const __m128i digits = _mm_cvtepu8_epi16(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.colorDigits.data())));
+        const __m128i bits = _mm_cvtepu8_epi16(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.colorBits.data())));
+        const __m128i values = UnquantizeSse41(digits, bits, *block.colorConstants);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(block.colors.data()),
+                         _mm_packus_epi16(values, values));
+    }
+}
+
+ASTC_TARGET_SSE41 static void UnquantizeWeightsSse41(BatchBlock& block) {
+    const UnquantizeConstants& k = *block.weightConstants;
+    const u32 nWeights = block.gridWidth * block.gridHeight;
+
+    if (k.lookup) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k.values.data()));
+        for (u32 i = 0; i < nWeights; i += 16) {
+            const __m128i digits =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(block.weightDigits.data() + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(block.gridWeights.data() + i),
+                             _mm_shuffle_epi8(values, digits));
+        }
+        return;
+    }
+
+    const __m128i half = _mm_set1_epi16(32);
+    for (u32 i = 0; i < nWeights; i += 8) {
+        const __m128i digits = _mm_cvtepu8_epi16(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.weightDigits.data() + i)));
+        const __m128i bits = _mm_cvtepu8_epi16(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.weightBits.data() + i)));
+        __m128i values = UnquantizeSse41(digits, bits, k);
+
+        // Change from [0,63] to [0,64]
+        values = _mm_sub_epi16(values, _mm_cmpgt_epi16(values, half));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(block.gridWeights.data() + i),
+                         _mm_packus_epi16(values, values));
+    }
+}
+
+// Looks up 16 of the up to 64 grid weights at once, one byte shuffle per 16 weights
+ASTC_TARGET_SSE41 static __m128i LookupGridSse41(const __m128i* grid,
+                                                 __m128i index) {
+    // Bits 4 and 5 of the index pick the register, moved up to the bit a blend selects by
+    const __m128i selectLow = _mm_slli_epi16(index, 3);
+    const __m128i selectHigh = _mm_slli_epi16(index, 2);
+    const __m128i low = _mm_blendv_epi8(_mm_shuffle_epi8(grid[0], index),
+                                        _mm_shuffle_epi8(grid[1], index), selectLow);
+    const __m128i high = _mm_blendv_epi8(_mm_shuffle_epi8(grid[2], index),
+                                         _mm_shuffle_epi8(grid[3], index), selectLow);
+    return _mm_blendv_epi8(low, high, selectHigh);
+}
+
+ASTC_TARGET_SSE41 static void InfillWeightsSse41(const WeightInfillTable& table, const u8* grid,
+                                                 u8* weights, u32 numTexels) {
+    __m128i gridWeights[4];
+    for (u32 i = 0; i < 4; i++) {
+        gridWeights[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grid + i * 16));
+    }
+    const __m128i round = _mm_set1_epi16(8);
+
+    for (u32 i = 0; i < numTexels; i += 16) {
+        __m128i taps[4];
+        for (u32 tap = 0; tap < 4; tap++) {
+            const __m128i index =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.indices[tap].data() + i));
+            taps[tap] = LookupGridSse41(gridWeights, index);
+        }
+        const u8* const weights01 = table.weights[0].data() + i * 2;
+        const u8* const weights23 = table.weights[1].data() + i * 2;
+
+        __m128i low = _mm_add_epi16(
+            _mm_maddubs_epi16(_mm_unpacklo_epi8(taps[0], taps[1]),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights01))),
+            _mm_maddubs_epi16(_mm_unpacklo_epi8(taps[2], taps[3]),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights23))));
+        __m128i high = _mm_add_epi16(
+            _mm_maddubs_epi16(_mm_unpackhi_epi8(taps[0], taps[1]),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights01 + 16))),
+            _mm_maddubs_epi16(_mm_unpackhi_epi8(taps[2], taps[3]),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights23 + 16))));
+        low = _mm_srli_epi16(_mm_add_epi16(low, round), 4);
+        high = _mm_srli_epi16(_mm_add_epi16(high, round), 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(weights + i), _mm_packus_epi16(low, high));
+    }
+}
+
+ASTC_TARGET_SSE41 static __m128i RoundChannelsSse41(__m128i X) {
+    return _mm_srli_epi16(
+        _mm_sub_epi16(_mm_add_epi16(X, _mm_set1_epi16(32)), _mm_srli_epi16(X, 13)), 6);
+}
+
+ASTC_TARGET_SSE41 static void InterpolateSse41(const std::array<u8, 16>& endpoints,
+                                               const u8* weights, u32 numTexels, u32* out) {
+    const __m128i pairs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(endpoints.data()));
+    __m128i spread[4];
+    for (u32 j = 0; j < 4; j++) {
+        spread[j] = _mm_load_si128(reinterpret_cast<const __m128i*>(kSpreadWeights[j].data()));
+    }
+    const __m128i maxWeight = _mm_set1_epi8(64);
+
+    for (u32 i = 0; i < numTexels; i += 16) {
+        const __m128i weight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+        const __m128i inverseWeight = _mm_sub_epi8(maxWeight, weight);
+        const __m128i weightPairs[2]{_mm_unpacklo_epi8(inverseWeight, weight),
+                                                 _mm_unpackhi_epi8(inverseWeight, weight)};
+        for (u32 half = 0; half < 2; half++) {
+            for (u32 j = 0; j < 4; j += 2) {
+                const __m128i first = RoundChannelsSse41(
+                    _mm_maddubs_epi16(pairs, _mm_shuffle_epi8(weightPairs[half], spread[j])));
+                const __m128i second = RoundChannelsSse41(
+                    _mm_maddubs_epi16(pairs, _mm_shuffle_epi8(weightPairs[half], spread[j + 1])));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + half * 8 + j * 2),
+                                 _mm_packus_epi16(first, second));
+            }
+        }
+    }
+}
+
+// Each 128 bit lane holds a different block, with its own constants
+ASTC_TARGET_AVX2 static __m256i Broadcast16Avx2(u16 low, u16 high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi16(static_cast<s16>(low))),
+                                   _mm_set1_epi16(static_cast<s16>(high)), 1);
+}
+
+ASTC_TARGET_AVX2 static __m256i UnquantizeAvx2(__m256i digits, __m256i bits,
+                                               const UnquantizeConstants& low,
+                                               const UnquantizeConstants& high) {
+    const __m256i x = _mm256_and_si256(bits, Broadcast16Avx2(low.mask, high.mask));
+    const __m256i B = _mm256_mulhi_epu16(
+        _mm256_mullo_epi16(x, Broadcast16Avx2(low.multiplier, high.multiplier)),
+        Broadcast16Avx2(low.shiftScale, high.shiftScale));
+    const __m256i A = _mm256_mullo_epi16(_mm256_and_si256(bits, _mm256_set1_epi16(1)),
+                                         Broadcast16Avx2(low.sign, high.sign));
+    __m256i T = _mm256_add_epi16(
+        _mm256_mullo_epi16(B, Broadcast16Avx2(low.bitScale, high.bitScale)),
+        _mm256_mullo_epi16(digits, Broadcast16Avx2(low.digitScale, high.digitScale)));
+    T = _mm256_xor_si256(T, A);
+    return _mm256_or_si256(_mm256_and_si256(A, Broadcast16Avx2(low.top, high.top)),
+                           _mm256_srli_epi16(T, 2));
+}
+
+// Two blocks per register
+ASTC_TARGET_AVX2 static void UnquantizeColorsAvx2(std::span<BatchBlock> blocks) {
+    size_t i = 0;
+    for (; i + 2 <= blocks.size(); i += 2) {
+        BatchBlock& first = blocks[i];
+        BatchBlock& second = blocks[i + 1];
+        const __m256i digits = _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(first.colorDigits.data())),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second.colorDigits.data()))));
+        const __m256i bits = _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(first.colorBits.data())),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second.colorBits.data()))));
+        const __m256i values =
+            UnquantizeAvx2(digits, bits, *first.colorConstants, *second.colorConstants);
+        const __m128i colors = _mm_packus_epi16(_mm256_castsi256_si128(values),
+                                                _mm256_extracti128_si256(values, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(first.colors.data()), colors);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(second.colors.data()),
+                         _mm_unpackhi_epi64(colors, colors));
+    }
+    UnquantizeColorsSse41(blocks.subspan(i));
+}
+
+ASTC_TARGET_AVX2 static void UnquantizeWeightsAvx2(BatchBlock& block) {
+    const UnquantizeConstants& k = *block.weightConstants;
+    if (k.lookup) {
+        UnquantizeWeightsSse41(block);
+        return;
+    }
+
+    const u32 nWeights = block.gridWidth * block.gridHeight;
+    const __m256i half = _mm256_set1_epi16(32);
+    for (u32 i = 0; i < nWeights; i += 16) {
+        const __m256i digits = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block.weightDigits.data() + i)));
+        const __m256i bits = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block.weightBits.data() + i)));
+        __m256i values = UnquantizeAvx2(digits, bits, k, k);
+
+        // Change from [0,63] to [0,64]
+        values = _mm256_sub_epi16(values, _mm256_cmpgt_epi16(values, half));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block.gridWeights.data() + i),
+                         _mm_packus_epi16(_mm256_castsi256_si128(values),
+                                          _mm256_extracti128_si256(values, 1)));
+    }
+}
+
+ASTC_TARGET_AVX2 static __m256i LookupGridAvx2(const __m256i* grid,
+                                               __m256i index) {
+    const __m256i selectLow = _mm256_slli_epi16(index, 3);
+    const __m256i selectHigh = _mm256_slli_epi16(index, 2);
+    const __m256i low = _mm256_blendv_epi8(_mm256_shuffle_epi8(grid[0], index),
+                                           _mm256_shuffle_epi8(grid[1], index), selectLow);
+    const __m256i high = _mm256_blendv_epi8(_mm256_shuffle_epi8(grid[2], index),
+                                            _mm256_shuffle_epi8(grid[3], index), selectLow);
+    return _mm256_blendv_epi8(low, high, selectHigh);
+}
+
+// 32 texels per iteration. The byte unpacks work within 128 bit lanes, so the low half holds
+// texels 0-7 and 16-23 and the tap weights are regrouped to match.
+ASTC_TARGET_AVX2 static void InfillWeightsAvx2(const WeightInfillTable& table, const u8* grid,
+                                               u8* weights, u32 numTexels) {
+    __m256i gridWeights[4];
+    for (u32 i = 0; i < 4; i++) {
+        gridWeights[i] = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(grid + i * 16)));
+    }
+    const __m256i round = _mm256_set1_epi16(8);
+
+    for (u32 i = 0; i < numTexels; i += 32) {
+        __m256i taps[4];
+        for (u32 tap = 0; tap < 4; tap++) {
+            const __m256i index = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(table.indices[tap].data() + i));
+            taps[tap] = LookupGridAvx2(gridWeights, index);
+        }
+        __m256i tapWeights[4];
+        for (u32 pair = 0; pair < 2; pair++) {
+            const u8* const pairWeights = table.weights[pair].data() + i * 2;
+            const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairWeights));
+            const __m256i second =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairWeights + 32));
+            tapWeights[pair * 2] = _mm256_permute2x128_si256(first, second, 0x20);
+            tapWeights[pair * 2 + 1] = _mm256_permute2x128_si256(first, second, 0x31);
+        }
+
+        __m256i low = _mm256_add_epi16(
+            _mm256_maddubs_epi16(_mm256_unpacklo_epi8(taps[0], taps[1]), tapWeights[0]),
+            _mm256_maddubs_epi16(_mm256_unpacklo_epi8(taps[2], taps[3]), tapWeights[2]));
+        __m256i high = _mm256_add_epi16(
+            _mm256_maddubs_epi16(_mm256_unpackhi_epi8(taps[0], taps[1]), tapWeights[1]),
+            _mm256_maddubs_epi16(_mm256_unpackhi_epi8(taps[2], taps[3]), tapWeights[3]));
+        low = _mm256_srli_epi16(_mm256_add_epi16(low, round), 4);
+        high = _mm256_srli_epi16(_mm256_add_epi16(high, round), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(weights + i),
+                            _mm256_packus_epi16(low, high));
+    }
+}
+
+ASTC_TARGET_AVX2 static __m256i RoundChannelsAvx2(__m256i X) {
+    return _mm256_srli_epi16(
+        _mm256_sub_epi16(_mm256_add_epi16(X, _mm256_set1_epi16(32)), _mm256_srli_epi16(X, 13)), 6);
+}
+
+// Eight texels per store, the low lane spreads texels 0-3 and the high lane texels 4-7
+ASTC_TARGET_AVX2 static void InterpolateAvx2(const std::array<u8, 16>& endpoints,
+                                             const u8* weights, u32 numTexels, u32* out) {
+    const __m256i pairs = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(endpoints.data())));
+    __m256i spread[2];
+    for (u32 j = 0; j < 2; j++) {
+        spread[j] = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(kSpreadWeights[j].data()))),
+            _mm_load_si128(reinterpret_cast<const __m128i*>(kSpreadWeights[j + 2].data())), 1);
+    }
+    const __m128i maxWeight = _mm_set1_epi8(64);
+
+    for (u32 i = 0; i < numTexels; i += 16) {
+        const __m128i weight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+        const __m128i inverseWeight = _mm_sub_epi8(maxWeight, weight);
+        const __m128i weightPairs[2]{_mm_unpacklo_epi8(inverseWeight, weight),
+                                                 _mm_unpackhi_epi8(inverseWeight, weight)};
+        for (u32 half = 0; half < 2; half++) {
+            const __m256i texelPairs = _mm256_broadcastsi128_si256(weightPairs[half]);
+            const __m256i first = RoundChannelsAvx2(
+                _mm256_maddubs_epi16(pairs, _mm256_shuffle_epi8(texelPairs, spread[0])));
+            const __m256i second = RoundChannelsAvx2(
+                _mm256_maddubs_epi16(pairs, _mm256_shuffle_epi8(texelPairs, spread[1])));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + half * 8),
+                                _mm256_packus_epi16(first, second));
+        }
+    }
+}
+#endif
+
+struct BatchKernels {
+    void (*unquantizeColors)(std::span<BatchBlock> blocks);
+    void (*unquantizeWeights)(BatchBlock& block);
+    void (*infillWeights)(const WeightInfillTable& table, const u8* grid, u8* weights,
+                          u32 numTexels);
+    void (*interpolate)(const std::array<u8, 16>& endpoints, const u8* weights, u32 numTexels,
+                        u32* out);
+};
+
+// Returns nullptr when every block has to go through DecompressBlock
+static const BatchKernels* SelectBatchKernels() {
+#ifdef ASTC_X64
+    static constexpr BatchKernels avx2{&UnquantizeColorsAvx2, &UnquantizeWeightsAvx2,
+                                       &InfillWeightsAvx2, &InterpolateAvx2};
+    static constexpr BatchKernels sse41{&UnquantizeColorsSse41, &UnquantizeWeightsSse41,
+                                        &InfillWeightsSse41, &InterpolateSse41};
+    switch (GetHostSimd()) {
+    case HostSimd::AVX2:
+        return &avx2;
+    case HostSimd::SSE41:
+        return &sse41;
+    default:
+        break;
+    }
+#endif
+    return nullptr;
+}
+
+// Decodes consecutive blocks and hands each one to store with its index and its texels
+template <typename StoreFn>
+static void DecompressBatched(const BatchKernels& kernels, std::span<const u8> blocks,
+                              u32 blockWidth, u32 blockHeight, StoreFn&& store) {
+    const u32 numBlocks = static_cast<u32>(blocks.size() / 16);
+    const u32 numTexels = blockWidth * blockHeight;
+    std::array<BatchBlock, kBatchSize> batch;
+    alignas(32) std::array<u32, kPaddedTexels> texels;
+
+    for (u32 first = 0; first < numBlocks; first += kBatchSize) {
+        const u32 count = std::min(kBatchSize, numBlocks - first);
+        u32 numParsed = 0;
+        for (u32 i = 0; i < count; i++) {
+            const std::span<const u8, 16> block{blocks.subspan((first + i) * 16, 16)};
+            if (ParseBatchBlock(block, blockWidth, blockHeight, batch[numParsed])) {
+                batch[numParsed++].index = first + i;
+                continue;
+            }
+            DecompressBlock(block, blockWidth, blockHeight,
+                            std::span<u32, kMaxTexels>{texels.data(), kMaxTexels});
+            store(first + i, texels.data());
+        }
+
+        const std::span<BatchBlock> parsed{batch.data(), numParsed};
+        kernels.unquantizeColors(parsed);
+        for (BatchBlock& block : parsed) {
+            ComputeEndpointPairs(block);
+            kernels.unquantizeWeights(block);
+        }
+
+        // A grid as large as the footprint lands every texel on a grid point, the infill keeps
+        // the weights as they are
+        for (BatchBlock& block : parsed) {
+            const u8* weights = block.gridWeights.data();
+            if (block.gridWidth != blockWidth || block.gridHeight != blockHeight) {
+                const WeightInfillTable& infill = GetWeightInfillTable(
+                    blockWidth, blockHeight, block.gridWidth, block.gridHeight);
+                kernels.infillWeights(infill, block.gridWeights.data(), block.weights.data(),
+                                      numTexels);
+                weights = block.weights.data();
+            }
+            kernels.interpolate(block.endpoints, weights, numTexels, texels.data());
+            store(block.index, texels.data());
+        }
+    }
+}
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
+    const BatchKernels* const kernels = SelectBatchKernels();
 
     Common::ThreadWorker& workers{GetThreadWorkers()};
 
@@ -1662,26 +2514,36 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
         const u32 depth_offset = z * height * width * 4;
         for (u32 y_index = 0; y_index < rows; ++y_index) {
             auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
-                                      cols, z, depth_offset, y_index] {
+                                      cols, z, depth_offset, y_index, kernels] {
                 const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
-
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
+                const u32 row_index = (z * rows * cols) + (y_index * cols);
 
+                const auto store = [&](u32 x_index, const u32* uncompData) {
+                    const u32 x = x_index * block_width;
                     u32 decompWidth = std::min(block_width, width - x);
                     u32 decompHeight = std::min(block_height, height - y);
 
                     const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
                     for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
+                        std::memcpy(outRow.data() + h * width * 4, uncompData + h * block_width,
+                                    decompWidth * 4);
                     }
+                };
+
+                if (kernels != nullptr) {
+                    DecompressBatched(*kernels, data.subspan(row_index * 16, cols * 16),
+                                      block_width, block_height, store);
+                    return;
+                }
+
+                for (u32 x_index = 0; x_index < cols; ++x_index) {
+                    const u32 block_index = row_index + x_index;
+                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+                    // Blocks can be at most 12x12
+                    std::array<u32, 12 * 12> uncompData;
+                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
+                    store(x_index, uncompData.data());
                 }
             };
             workers.QueueWork(std::move(decompress_stride));
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
@@ -10,11 +11,16 @@
 #include "yuzu_common/yuzu_assert.h"
 #include "yuzu_common/bit_util.h"
 #include "yuzu_common/div_ceil.h"
+#include "yuzu_common/literals.h"
 #include "yuzu_video_core/gpu.h"
 #include "yuzu_video_core/textures/decoders.h"
+#include "yuzu_video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 namespace {
+
+using namespace Common::Literals;
+
 template <u32 mask>
 constexpr u32 pdep(u32 value) {
     u32 result = 0;
@@ -33,59 +39,138 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
-template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
-void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
-                 u32 block_height, u32 block_depth, u32 stride) {
-    // The origin of the transformation can be configured here, leave it as zero as the current API
-    // doesn't expose it.
-    static constexpr u32 origin_x = 0;
-    static constexpr u32 origin_y = 0;
-    static constexpr u32 origin_z = 0;
-
-    // We can configure here a custom pitch
-    // As it's not exposed 'width * BYTES_PER_PIXEL' will be the expected pitch.
-    const u32 pitch = width * BYTES_PER_PIXEL;
-
-    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
-    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
-    const u32 slice_size =
-        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
-
-    const u32 block_height_mask = (1U << block_height) - 1;
-    const u32 block_depth_mask = (1U << block_depth) - 1;
-    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
-
-    for (u32 slice = 0; slice < depth; ++slice) {
-        const u32 z = slice + origin_z;
-        const u32 offset_z = (z >> block_depth) * slice_size +
-                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
-        for (u32 line = 0; line < height; ++line) {
-            const u32 y = line + origin_y;
-            const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
+// Every 16 byte aligned run of a GOB row stays contiguous once swizzled, so whole textures are
+// moved a GOB at a time in 16 byte pieces instead of texel by texel.
+constexpr u32 GOB_SECTOR_SIZE = 16;
+constexpr u32 GOB_SECTORS_X = GOB_SIZE_X / GOB_SECTOR_SIZE;
+
+constexpr std::array<u32, GOB_SECTORS_X * GOB_SIZE_Y> GOB_SECTOR_OFFSETS = [] {
+    std::array<u32, GOB_SECTORS_X * GOB_SIZE_Y> offsets{};
+    for (u32 y = 0; y < GOB_SIZE_Y; ++y) {
+        for (u32 x = 0; x < GOB_SECTORS_X; ++x) {
+            offsets[y * GOB_SECTORS_X + x] =
+                pdep<SWIZZLE_X_BITS>(x * GOB_SECTOR_SIZE) | pdep<SWIZZLE_Y_BITS>(y);
+        }
+    }
+    return offsets;
+}();
 
-            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
-            const u32 offset_y = (block_y >> block_height) * block_size +
-                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+// Textures at least this large are split across the transcode workers
+constexpr std::size_t PARALLEL_SWIZZLE_THRESHOLD = 1_MiB;
 
-            u32 swizzled_x = pdep<SWIZZLE_X_BITS>(origin_x * BYTES_PER_PIXEL);
-            for (u32 column = 0; column < width;
-                 ++column, incrpdep<SWIZZLE_X_BITS, BYTES_PER_PIXEL>(swizzled_x)) {
-                const u32 x = (column + origin_x) * BYTES_PER_PIXEL;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
+/// Copies a full GOB, dst and src are the swizzled GOB and the linear GOB origin in the order
+/// given by TO_LINEAR. The 16 byte copies compile to single SSE2 moves.
+template <bool TO_LINEAR>
+void CopyGob(u8* dst, const u8* src, std::size_t pitch) {
+    for (u32 y = 0; y < GOB_SIZE_Y; ++y) {
+        for (u32 x = 0; x < GOB_SECTORS_X; ++x) {
+            const std::size_t swizzled = GOB_SECTOR_OFFSETS[y * GOB_SECTORS_X + x];
+            const std::size_t linear = y * pitch + x * GOB_SECTOR_SIZE;
+            std::memcpy(dst + (TO_LINEAR ? swizzled : linear),
+                        src + (TO_LINEAR ? linear : swizzled), GOB_SECTOR_SIZE);
+        }
+    }
+}
 
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + (swizzled_x | swizzled_y);
+/// Copies the part of a GOB that lies inside the texture when it is cut by the right or bottom
+/// edge.
+template <bool TO_LINEAR>
+void CopyPartialGob(u8* dst, const u8* src, std::size_t pitch, u32 width_bytes, u32 rows) {
+    for (u32 y = 0; y < rows; ++y) {
+        for (u32 x = 0; x < width_bytes; x += GOB_SECTOR_SIZE) {
+            const std::size_t swizzled =
+                GOB_SECTOR_OFFSETS[y * GOB_SECTORS_X + x / GOB_SECTOR_SIZE];
+            const std::size_t linear = y * pitch + x;
+            std::memcpy(dst + (TO_LINEAR ? swizzled : linear),
+                        src + (TO_LINEAR ? linear : swizzled),
+                        std::min(GOB_SECTOR_SIZE, width_bytes - x));
+        }
+    }
+}
 
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * BYTES_PER_PIXEL;
+struct SwizzleLayout {
+    u32 pitch;
+    u32 height;
+    u32 block_height;
+    u32 block_depth;
+    u32 block_size;
+    u32 slice_size;
+    u32 x_shift;
+};
 
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+template <bool TO_LINEAR>
+void SwizzleBlockRow(u8* output, const u8* input, const SwizzleLayout& layout, u32 slice,
+                     u32 block_y) {
+    const u32 block_depth_mask = (1U << layout.block_depth) - 1;
+    const u32 offset_z = (slice >> layout.block_depth) * layout.slice_size +
+                         ((slice & block_depth_mask) << (GOB_SIZE_SHIFT + layout.block_height));
+    const std::size_t slice_offset = static_cast<std::size_t>(slice) * layout.pitch * layout.height;
+
+    const u32 gobs_in_block = 1U << layout.block_height;
+    const u32 gob_y_begin = block_y << layout.block_height;
+    const u32 gob_y_end =
+        std::min(gob_y_begin + gobs_in_block, Common::DivCeilLog2(layout.height, GOB_SIZE_Y_SHIFT));
+    const u32 gobs_x = Common::DivCeilLog2(layout.pitch, GOB_SIZE_X_SHIFT);
+
+    for (u32 gob_y = gob_y_begin; gob_y < gob_y_end; ++gob_y) {
+        const u32 line = gob_y << GOB_SIZE_Y_SHIFT;
+        const u32 rows = std::min(GOB_SIZE_Y, layout.height - line);
+        const u32 offset_y =
+            block_y * layout.block_size + ((gob_y - gob_y_begin) << GOB_SIZE_SHIFT);
+
+        for (u32 gob_x = 0; gob_x < gobs_x; ++gob_x) {
+            const u32 x = gob_x << GOB_SIZE_X_SHIFT;
+            const std::size_t swizzled_offset = offset_z + offset_y + (gob_x << layout.x_shift);
+            const std::size_t linear_offset =
+                slice_offset + static_cast<std::size_t>(line) * layout.pitch + x;
+
+            u8* const dst = output + (TO_LINEAR ? swizzled_offset : linear_offset);
+            const u8* const src = input + (TO_LINEAR ? linear_offset : swizzled_offset);
+
+            const u32 width_bytes = std::min(GOB_SIZE_X, layout.pitch - x);
+            if (width_bytes == GOB_SIZE_X && rows == GOB_SIZE_Y) {
+                CopyGob<TO_LINEAR>(dst, src, layout.pitch);
+            } else {
+                CopyPartialGob<TO_LINEAR>(dst, src, layout.pitch, width_bytes, rows);
+            }
+        }
+    }
+}
 
-                std::memcpy(dst, src, BYTES_PER_PIXEL);
+template <bool TO_LINEAR>
+void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 pitch, u32 height, u32 depth,
+                 u32 block_height, u32 block_depth, u32 stride) {
+    SwizzleLayout layout{};
+    layout.pitch = pitch;
+    layout.height = height;
+    layout.block_height = block_height;
+    layout.block_depth = block_depth;
+    layout.block_size = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT)
+                        << (GOB_SIZE_SHIFT + block_height + block_depth);
+    layout.slice_size = Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) *
+                        layout.block_size;
+    layout.x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+
+    u8* const dst = output.data();
+    const u8* const src = input.data();
+    const u32 blocks_y = Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT);
+
+    const std::size_t total_size = static_cast<std::size_t>(pitch) * height * depth;
+    if (total_size < PARALLEL_SWIZZLE_THRESHOLD || depth * blocks_y < 2) {
+        for (u32 slice = 0; slice < depth; ++slice) {
+            for (u32 block_y = 0; block_y < blocks_y; ++block_y) {
+                SwizzleBlockRow<TO_LINEAR>(dst, src, layout, slice, block_y);
             }
         }
+        return;
     }
+
+    // Block rows of every slice touch disjoint ranges on both sides
+    ForEachChunk(depth * blocks_y, 1, [&](u32 begin, u32 end) {
+        for (u32 row = begin; row < end; ++row) {
+            SwizzleBlockRow<TO_LINEAR>(dst, src, layout, row / blocks_y, row % blocks_y);
+        }
+    });
 }
 
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
@@ -151,51 +236,22 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
     }
 }
 
-template <bool TO_LINEAR>
-void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
-             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
-    switch (bytes_per_pixel) {
-#define BPP_CASE(x)                                                                                \
-    case x:                                                                                        \
-        return SwizzleImpl<TO_LINEAR, x>(output, input, width, height, depth, block_height,        \
-                                         block_depth, stride_alignment);
-        BPP_CASE(1)
-        BPP_CASE(2)
-        BPP_CASE(3)
-        BPP_CASE(4)
-        BPP_CASE(6)
-        BPP_CASE(8)
-        BPP_CASE(12)
-        BPP_CASE(16)
-#undef BPP_CASE
-    default:
-        ASSERT_MSG(false, "Invalid bytes_per_pixel={}", bytes_per_pixel);
-        break;
-    }
-}
-
 } // Anonymous namespace
 
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
                       u32 stride_alignment) {
     const u32 stride = Common::AlignUpLog2(width, stride_alignment) * bytes_per_pixel;
-    const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
-    width = (width * bytes_per_pixel) >> new_bpp;
-    bytes_per_pixel = 1U << new_bpp;
-    Swizzle<false>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                   stride);
+    SwizzleImpl<false>(output, input, width * bytes_per_pixel, height, depth, block_height,
+                       block_depth, stride);
 }
 
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 block_height, u32 block_depth,
                     u32 stride_alignment) {
     const u32 stride = Common::AlignUpLog2(width, stride_alignment) * bytes_per_pixel;
-    const u32 new_bpp = std::min(4U, static_cast<u32>(std::countr_zero(width * bytes_per_pixel)));
-    width = (width * bytes_per_pixel) >> new_bpp;
-    bytes_per_pixel = 1U << new_bpp;
-    Swizzle<true>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                  stride);
+    SwizzleImpl<true>(output, input, width * bytes_per_pixel, height, depth, block_height,
+                      block_depth, stride);
 }
 
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <xbyak/xbyak_util.h>
+#endif
+
+#include "yuzu_video_core/textures/host_simd.h"
+
+namespace Tegra::Texture {
+
+namespace {
+std::atomic<HostSimd> simd_limit{HostSimd::AVX2};
+
+HostSimd DetectHostSimd() {
+#if defined(_M_X64) || defined(__x86_64__)
+    const Xbyak::util::Cpu cpu;
+    if (cpu.has(Xbyak::util::Cpu::tAVX2)) {
+        return HostSimd::AVX2;
+    }
+    if (cpu.has(Xbyak::util::Cpu::tSSE41)) {
+        return HostSimd::SSE41;
+    }
+    // SSE2 is part of x86-64
+    return HostSimd::SSE2;
+#else
+    return HostSimd::None;
+#endif
+}
+} // Anonymous namespace
+
+HostSimd GetHostSimd() {
+    static const HostSimd detected = DetectHostSimd();
+    return std::min(detected, simd_limit.load(std::memory_order_relaxed));
+}
+
+void SetHostSimdLimit(HostSimd limit) {
+    simd_limit.store(limit, std::memory_order_relaxed);
+}
+
+} // namespace Tegra::Texture
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: Copyright 2025 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "yuzu_common/common_types.h"
+
+namespace Tegra::Texture {
+
+/// Instruction set extensions the texture and surface kernels pick from, in increasing order
+enum class HostSimd : u32 {
+    None,
+    SSE2,
+    SSE41,
+    AVX2,
+};
+
+/// Returns the best extension supported by the host, capped by SetHostSimdLimit.
+[[nodiscard]] HostSimd GetHostSimd();
+
+/// Caps what GetHostSimd returns, benchmarks lower it to time the scalar kernels.
+void SetHostSimdLimit(HostSimd limit);
+
+} // namespace Tegra::Texture
@@ -1,10 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
 #include "yuzu_video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 
+namespace {
+// Set while a thread runs a chunk, waiting on the pool from there could deadlock it
+thread_local bool in_chunk = false;
+} // Anonymous namespace
+
 Common::ThreadWorker& GetThreadWorkers() {
     static Common::ThreadWorker workers{std::max(std::thread::hardware_concurrency(), 2U) / 2,
                                         "ImageTranscode"};
@@ -12,4 +21,44 @@ Common::ThreadWorker& GetThreadWorkers() {
     return workers;
 }
 
+void ForEachChunk(u32 count, u32 chunk_size, const std::function<void(u32, u32)>& func) {
+    chunk_size = std::max(chunk_size, 1U);
+    if (count <= chunk_size || in_chunk) {
+        func(0, count);
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    u32 remaining = 0;
+    const auto run_chunk = [&func](u32 begin, u32 end) {
+        in_chunk = true;
+        func(begin, end);
+        in_chunk = false;
+    };
+
+    // The first chunk runs on this thread, the rest are queued
+    Common::ThreadWorker& workers{GetThreadWorkers()};
+    for (u32 begin = chunk_size; begin < count; begin += chunk_size) {
+        const u32 end = std::min(begin + chunk_size, count);
+        {
+            std::scoped_lock lock{mutex};
+            ++remaining;
+        }
+        workers.QueueWork([&, begin, end] {
+            run_chunk(begin, end);
+            // Notified under the lock, the caller may return and destroy it as soon as it sees
+            // the count reach zero
+            std::scoped_lock lock{mutex};
+            if (--remaining == 0) {
+                done.notify_all();
+            }
+        });
+    }
+    run_chunk(0, chunk_size);
+
+    std::unique_lock lock{mutex};
+    done.wait(lock, [&remaining] { return remaining == 0; });
+}
+
 } // namespace Tegra::Texture
@@ -3,10 +3,18 @@
 
 #pragma once
 
+#include <functional>
+
+#include "yuzu_common/common_types.h"
 #include "yuzu_common/thread_worker.h"
 
 namespace Tegra::Texture {
 
 Common::ThreadWorker& GetThreadWorkers();
 
-}
+/// Calls func(begin, end) over [0, count) in chunks of at most chunk_size, spread over the
+/// transcode workers and the calling thread. Returns once these chunks are done without waiting
+/// on work queued by anyone else. Calls made from inside a chunk run inline.
+void ForEachChunk(u32 count, u32 chunk_size, const std::function<void(u32, u32)>& func);
+
+} // namespace Tegra::Texture